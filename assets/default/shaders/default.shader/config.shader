@@ -1,7 +1,9 @@
 <Shader name="default" queue="Geometry" var="varing.def.sc"> 
 	<Property name="s_texColor" type="2D" default="white"/> 
+	<Property name="u_tint" type="Vector" default="1,1,1,1"/> 
 	<VertexShader name="vs" src="vertex.sc"/> 
+	<VertexShader name="vs_instanced" src="vertex_instanced.sc"/> 
 	<FragmentShader name="fs" src="fragment.sc"/> 
 	<RenderState name="rs" Cull="Off" ZWrite="On" ZTest="Less" Blend="SrcAlpha OneMinusSrcAlpha" BlendOp="Add" ColorMask="RGB"/> 
-	<Pass name="pass" feature="" vs="vs" fs="fs" rs="rs"/>
+	<Pass name="pass" feature="" vs="vs" vsInstanced="vs_instanced" instanceProperties="u_tint" fs="fs" rs="rs"/>
 </Shader>
\ No newline at end of file
@@ -4,8 +4,15 @@ $input v_color0, v_texcoord0
 
 SAMPLER2D(s_texColor, 0);
 
+// x: fraction of the pixels drawn while two levels of detail cross-fade, y: 1 for the level fading out
+uniform vec4 u_lodFade;
+
 void main()
 {
+	// both levels draw complementary pixels of the same screen space noise
+	float dither = fract(sin(dot(floor(gl_FragCoord.xy), vec2(12.9898, 78.233))) * 43758.5453);
+	if ((u_lodFade.y > 0.5 ? 1.0 - dither : dither) >= u_lodFade.x) discard;
+
 	vec2 uv = v_texcoord0;
 
 	uv.y = 1.0 - uv.y;
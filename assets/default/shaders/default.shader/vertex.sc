@@ -3,9 +3,14 @@ $output v_color0, v_texcoord0
 
 #include "shaderlib.sh"
 
+uniform vec4 u_tint;
+
+// position scale and offset, then scale xy and offset zw of both texcoord sets, identity for float meshes
+uniform vec4 u_meshDequantization[4];
+
 void main()
 {
-	gl_Position = mul(u_modelViewProj, vec4(a_position.xyz, 1.0));
-	v_texcoord0 = a_texcoord0;
-	v_color0 = a_color0;
+	gl_Position = mul(u_modelViewProj, vec4(a_position.xyz * u_meshDequantization[0].xyz + u_meshDequantization[1].xyz, 1.0));
+	v_texcoord0 = a_texcoord0 * u_meshDequantization[2].xy + u_meshDequantization[2].zw;
+	v_color0 = a_color0 * u_tint;
 }
\ No newline at end of file
@@ -0,0 +1,16 @@
+$input a_position, a_texcoord0, a_color0, i_data0, i_data1, i_data2, i_data3, i_data4
+$output v_color0, v_texcoord0
+
+#include "shaderlib.sh"
+
+// position scale and offset, then scale xy and offset zw of both texcoord sets, identity for float meshes
+uniform vec4 u_meshDequantization[4];
+
+void main()
+{
+	mat4 model = mtxFromCols(i_data0, i_data1, i_data2, i_data3);
+	vec4 worldPos = mul(model, vec4(a_position.xyz * u_meshDequantization[0].xyz + u_meshDequantization[1].xyz, 1.0));
+	gl_Position = mul(u_viewProj, worldPos);
+	v_texcoord0 = a_texcoord0 * u_meshDequantization[2].xy + u_meshDequantization[2].zw;
+	v_color0 = a_color0 * i_data4; // u_tint of the instance
+}
\ No newline at end of file
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <AzCore/std/containers/vector.h>
+#include <AzCore/std/string/string.h>
+#include <AzCore/std/functional.h>
+
+namespace Benchmark
+{
+    struct Result
+    {
+        double m_minMs    = 0.0;
+        double m_medianMs = 0.0;
+        double m_meanMs   = 0.0;
+    };
+
+    // runs the function `iterations` times after a single warm up run and reports wall clock timings
+    Result Measure(AZ::u32 iterations, const AZStd::function<void()>& function);
+
+    void Print(const char* name, AZ::u32 count, const Result& result);
+
+    // each suite registers itself in main.cpp and can be selected by name from the command line
+    void RunSortBenchmark();
+    void RunSubmitBenchmark();
+    void RunDeformBenchmark();
+    void RunStateBenchmark();
+    void RunTintBenchmark();
+    void RunResidentBenchmark();
+    void RunTextureLoadBenchmark();
+    void RunVertex2dBenchmark();
+}
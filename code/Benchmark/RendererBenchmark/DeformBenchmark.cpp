@@ -0,0 +1,123 @@
+#include "Benchmark.h"
+
+#include "Renderer/Base/Mesh.h"
+
+#include <bgfx/bgfx.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+namespace Benchmark
+{
+    namespace
+    {
+        const AZ::u32 k_meshCount   = 16;
+        const AZ::u32 k_vertexCount = 60000;
+        const AZ::u32 k_chunkCount  = 4;
+        const AZ::u32 k_chunkSize   = 750; // 4 chunks of 750 vertices touch 5% of the mesh
+        const AZ::u32 k_frameCount  = 30;
+
+        struct Vertex
+        {
+            float m_position[3];
+            float m_normal[3];
+            float m_texcoord[2];
+        };
+
+        class DeformScene
+        {
+        public:
+            DeformScene()
+            {
+                srand(11);
+
+                bgfx::VertexDecl decl;
+                decl.begin()
+                    .add(bgfx::Attrib::Position, 3, bgfx::AttribType::Float)
+                    .add(bgfx::Attrib::Normal, 3, bgfx::AttribType::Float)
+                    .add(bgfx::Attrib::TexCoord0, 2, bgfx::AttribType::Float)
+                    .end();
+
+                m_vertices.resize(k_vertexCount);
+                for (auto& mesh : m_meshes)
+                {
+                    mesh.Resize(decl, k_vertexCount, k_vertexCount - k_vertexCount % 3);
+                    mesh.SetVertices(0, m_vertices.data(), k_vertexCount);
+                    mesh.UpdateBuffers();
+                }
+            }
+
+            // moves a few scattered chunks of every mesh, only those are written
+            void DeformChunks()
+            {
+                for (auto& mesh : m_meshes)
+                {
+                    for (AZ::u32 chunk = 0; chunk < k_chunkCount; ++chunk)
+                    {
+                        const AZ::u32 first = static_cast<AZ::u32>(rand()) % (k_vertexCount - k_chunkSize);
+                        Offset(first, first + k_chunkSize);
+                        mesh.SetVertices(first, m_vertices.data() + first, k_chunkSize);
+                    }
+                    mesh.UpdateBuffers();
+                }
+            }
+
+            // the same deformation with the whole vertex array written back, as every update used to upload it
+            void DeformWhole()
+            {
+                for (auto& mesh : m_meshes)
+                {
+                    for (AZ::u32 chunk = 0; chunk < k_chunkCount; ++chunk)
+                    {
+                        const AZ::u32 first = static_cast<AZ::u32>(rand()) % (k_vertexCount - k_chunkSize);
+                        Offset(first, first + k_chunkSize);
+                    }
+                    mesh.SetVertices(0, m_vertices.data(), k_vertexCount);
+                    mesh.UpdateBuffers();
+                }
+            }
+
+        private:
+            void Offset(AZ::u32 begin, AZ::u32 end)
+            {
+                for (AZ::u32 i = begin; i < end; ++i)
+                {
+                    m_vertices[i].m_position[1] += 0.01f;
+                }
+            }
+
+            Module::Mesh          m_meshes[k_meshCount];
+            AZStd::vector<Vertex> m_vertices;
+        };
+    }
+
+    void RunDeformBenchmark()
+    {
+        bgfx::Init init;
+        init.type = bgfx::RendererType::Noop;
+        if (!bgfx::init(init))
+        {
+            printf("failed to initialize the noop renderer\n");
+            return;
+        }
+
+        {
+            DeformScene scene;
+
+            Print("whole buffer upload", k_meshCount, Measure(k_frameCount, [&scene]()
+            {
+                scene.DeformWhole();
+                bgfx::frame();
+            }));
+
+            Print("dirty range upload", k_meshCount, Measure(k_frameCount, [&scene]()
+            {
+                scene.DeformChunks();
+                bgfx::frame();
+            }));
+        }
+
+        bgfx::frame();
+        bgfx::shutdown();
+    }
+}
@@ -0,0 +1,116 @@
+#include "Benchmark.h"
+
+#include "Renderer/Base/ResidentCache.h"
+
+#include <bgfx/bgfx.h>
+
+#include <stdio.h>
+
+namespace Benchmark
+{
+    namespace
+    {
+        const AZ::u32  k_panelCount       = 8;
+        const AZ::u32  k_texturesPerPanel = 6;
+        const uint16_t k_textureSize      = 256;
+        const AZ::u32  k_frameCount       = 64;
+
+        // stands in for Texture, loading decodes the image and uploads it
+        class PanelTexture
+        {
+        public:
+            AZ_CLASS_ALLOCATOR(PanelTexture, AZ::SystemAllocator, 0);
+
+            explicit PanelTexture(AZ::u32 seed)
+            {
+                AZStd::vector<AZ::u32> pixels(k_textureSize * k_textureSize);
+                AZ::u32 value = seed * 2654435761u;
+                for (auto& pixel : pixels)
+                {
+                    value ^= value << 13;
+                    value ^= value >> 17;
+                    value ^= value << 5;
+                    pixel = value | 0xFF000000;
+                }
+                bgfx::calcTextureSize(m_info, k_textureSize, k_textureSize, 1, false, false, 1, bgfx::TextureFormat::RGBA8);
+                m_handle = bgfx::createTexture2D(k_textureSize, k_textureSize, false, 1, bgfx::TextureFormat::RGBA8, 0,
+                                                 bgfx::copy(pixels.data(), static_cast<uint32_t>(pixels.size() * sizeof(AZ::u32))));
+            }
+
+            ~PanelTexture()
+            {
+                bgfx::destroy(m_handle);
+            }
+
+            const bgfx::TextureInfo& GetInfo() const { return m_info; }
+
+        private:
+            bgfx::TextureHandle m_handle;
+            bgfx::TextureInfo   m_info = {};
+        };
+
+        // opens one panel per frame, the textures of the previous panel are released, as with UI panels opened and
+        // closed in turn
+        void OpenPanels(Module::ResidentCacheStats& stats, AZ::u64 budget)
+        {
+            Module::ResidentCache<PanelTexture> cache([](const PanelTexture& texture) -> AZ::u64
+            {
+                return texture.GetInfo().storageSize;
+            });
+            cache.SetBudget(budget);
+
+            AZStd::vector<AZStd::shared_ptr<PanelTexture>> panel;
+            AZ::u32 frame = 0;
+
+            char path[32];
+            const auto result = Measure(k_frameCount, [&]()
+            {
+                const AZ::u32 panelIndex = frame++ % k_panelCount;
+
+                panel.clear();
+                for (AZ::u32 i = 0; i < k_texturesPerPanel; ++i)
+                {
+                    snprintf(path, sizeof(path), "ui/panel%u/%u.dds", panelIndex, i);
+                    auto texture = cache.Find(path);
+                    if (!texture)
+                    {
+                        texture = cache.Insert(path, aznew PanelTexture(panelIndex * k_texturesPerPanel + i));
+                    }
+                    panel.push_back(texture);
+                }
+                bgfx::frame();
+            });
+
+            panel.clear();
+            stats = cache.GetStats();
+
+            char name[64];
+            snprintf(name, sizeof(name), "budget %u MB", static_cast<AZ::u32>(budget / (1024 * 1024)));
+            Print(name, k_texturesPerPanel, result);
+        }
+    }
+
+    void RunResidentBenchmark()
+    {
+        bgfx::Init init;
+        init.type = bgfx::RendererType::Noop;
+        if (!bgfx::init(init))
+        {
+            printf("failed to initialize the noop renderer\n");
+            return;
+        }
+
+        const AZ::u64 panelBytes = AZ::u64(k_texturesPerPanel) * k_textureSize * k_textureSize * 4;
+        const AZ::u64 budgets[] = { 0, panelBytes * k_panelCount };
+        for (auto budget : budgets)
+        {
+            Module::ResidentCacheStats stats;
+            OpenPanels(stats, budget);
+            printf("  hits %u misses %u evictions %u held %.1f MB\n", stats.m_hits, stats.m_misses, stats.m_evictions,
+                   stats.m_heldBytes / (1024.0 * 1024.0));
+            bgfx::frame();
+        }
+
+        bgfx::shutdown();
+    }
+}
@@ -0,0 +1,172 @@
+#include "Benchmark.h"
+
+#include "Renderer/Base/RenderNode.h"
+
+#include <AzCore/std/sort.h>
+
+#include <stdlib.h>
+
+namespace Benchmark
+{
+    namespace
+    {
+        // mirrors the fields and comparison chain the render queue was sorted by before switching to sort keys
+        struct LegacyNode
+        {
+            AZ::s16     m_sortingLayer  = 0;
+            AZ::s16     m_orderInLayer  = 0;
+            AZ::s32     m_queue         = 0;
+            float       m_distance      = 0.0f;
+            size_t      m_materialIndex = 0;
+            const void* m_shader        = nullptr;
+            const void* m_material      = nullptr;
+            const void* m_pass          = nullptr;
+            float       m_worldMatrix[16] = {};
+        };
+
+        bool operator<(const LegacyNode& lhv, const LegacyNode& rhv)
+        {
+            if (lhv.m_sortingLayer != rhv.m_sortingLayer)
+            {
+                return lhv.m_sortingLayer < rhv.m_sortingLayer;
+            }
+            if (lhv.m_orderInLayer != rhv.m_orderInLayer)
+            {
+                return lhv.m_orderInLayer < rhv.m_orderInLayer;
+            }
+            if (lhv.m_queue != rhv.m_queue)
+            {
+                return lhv.m_queue < rhv.m_queue;
+            }
+            if (lhv.m_distance != rhv.m_distance)
+            {
+                return lhv.m_distance < rhv.m_distance;
+            }
+            if (lhv.m_materialIndex != rhv.m_materialIndex)
+            {
+                return lhv.m_materialIndex < rhv.m_materialIndex;
+            }
+            if (lhv.m_shader != rhv.m_shader)
+            {
+                return lhv.m_shader < rhv.m_shader;
+            }
+            if (lhv.m_material != rhv.m_material)
+            {
+                return lhv.m_material < rhv.m_material;
+            }
+            if (lhv.m_pass != rhv.m_pass)
+            {
+                return lhv.m_pass < rhv.m_pass;
+            }
+            return &lhv < &rhv;
+        }
+
+        struct SceneNode
+        {
+            AZ::s16 m_sortingLayer;
+            AZ::s16 m_orderInLayer;
+            AZ::u16 m_sortingRank; // cached like the ranks of the render proxies
+            AZ::s32 m_queue;
+            float   m_distance;
+            AZ::u32 m_program;
+            AZ::u32 m_material;
+            AZ::u32 m_pass;
+            AZ::u32 m_geometry;
+        };
+
+        // a scene mix resembling a typical level: mostly opaque geometry, some transparent and overlay nodes
+        AZStd::vector<SceneNode> MakeScene(AZ::u32 count)
+        {
+            static const AZ::s32 s_queues[] = { 2000, 2000, 2000, 2000, 2450, 3000, 3000, 4000 };
+
+            srand(count);
+
+            Module::SortingOrders sortingOrders;
+
+            AZStd::vector<SceneNode> scene;
+            scene.reserve(count);
+            for (AZ::u32 i = 0; i < count; ++i)
+            {
+                SceneNode node;
+                node.m_sortingLayer = AZ::s16(rand() % 4);
+                node.m_orderInLayer = AZ::s16((rand() % 8) * 300 - 1200);
+                node.m_queue = s_queues[rand() % AZ_ARRAY_SIZE(s_queues)];
+                node.m_distance = float(rand() % 100000) * 0.01f;
+                node.m_program = rand() % 64;
+                node.m_material = rand() % 256;
+                node.m_pass = rand() % 2;
+                node.m_geometry = rand() % 128;
+                scene.push_back(node);
+                sortingOrders.Add(node.m_sortingLayer, node.m_orderInLayer);
+            }
+
+            sortingOrders.Finalize();
+            for (auto& node : scene)
+            {
+                node.m_sortingRank = sortingOrders.GetRank(node.m_sortingLayer, node.m_orderInLayer);
+            }
+            return scene;
+        }
+    }
+
+    void RunSortBenchmark()
+    {
+        static const AZ::u32 s_counts[] = { 10000, 50000, 100000 };
+        static const AZ::u32 s_iterations = 50;
+
+        for (auto count : s_counts)
+        {
+            const auto scene = MakeScene(count);
+
+            // legacy: build full nodes and sort them with the comparison chain
+            AZStd::vector<LegacyNode> legacyNodes;
+            const auto legacy = Measure(s_iterations, [&]()
+            {
+                legacyNodes.clear();
+                for (const auto& node : scene)
+                {
+                    LegacyNode legacyNode;
+                    legacyNode.m_sortingLayer = node.m_sortingLayer;
+                    legacyNode.m_orderInLayer = node.m_orderInLayer;
+                    legacyNode.m_queue = node.m_queue;
+                    legacyNode.m_distance = node.m_distance;
+                    legacyNode.m_shader = reinterpret_cast<const void*>(size_t(node.m_program + 1) * 64);
+                    legacyNode.m_material = reinterpret_cast<const void*>(size_t(node.m_material + 1) * 64);
+                    legacyNode.m_pass = reinterpret_cast<const void*>(size_t(node.m_pass + 1) * 64);
+                    legacyNodes.push_back(legacyNode);
+                }
+                AZStd::sort(legacyNodes.begin(), legacyNodes.end());
+            });
+            Print("comparison sort", count, legacy);
+
+            // sort keys: remap the ids of the frame, pack 64 bit keys and radix sort (key, index) pairs
+            AZStd::vector<AZ::u64> keys, tempKeys;
+            AZStd::vector<AZ::u32> indices, tempIndices;
+            Module::SortIdRemap programIds, materialIds, geometryIds;
+            const auto radix = Measure(s_iterations, [&]()
+            {
+                keys.clear();
+                indices.clear();
+                programIds.Clear();
+                materialIds.Clear();
+                geometryIds.Clear();
+                for (AZ::u32 i = 0; i < count; ++i)
+                {
+                    const auto& node = scene[i];
+                    keys.push_back(Module::RenderNode::MakeSortKey(node.m_sortingRank,
+                                                                   node.m_queue,
+                                                                   node.m_distance,
+                                                                   programIds.Get(AZ::u16(node.m_program)),
+                                                                   materialIds.Get(AZ::u16(node.m_material)),
+                                                                   node.m_pass,
+                                                                   geometryIds.Get(AZ::u16(node.m_geometry))));
+                    indices.push_back(i);
+                }
+                Module::RenderNode::Sort(keys, indices, tempKeys, tempIndices);
+            });
+            Print("sort key + radix sort", count, radix);
+
+            printf("%-32s %8u  speedup %.2fx\n", "", count, legacy.m_medianMs / radix.m_medianMs);
+        }
+    }
+}
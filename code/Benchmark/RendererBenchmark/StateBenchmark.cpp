@@ -0,0 +1,170 @@
+#include "Benchmark.h"
+
+#include <AzCore/Math/Transform.h>
+
+#include <bgfx/bgfx.h>
+
+#include <stdio.h>
+
+namespace Benchmark
+{
+    namespace
+    {
+        const AZ::u32 k_drawCount     = 60000;
+        const AZ::u32 k_materialCount = 16;
+        const AZ::u32 k_uniformCount  = 4;
+        const AZ::u32 k_frameCount    = 30;
+
+        struct Draw
+        {
+            float   m_worldMatrix[16];
+            AZ::u32 m_material;
+        };
+
+        struct Material
+        {
+            float               m_values[k_uniformCount][4];
+            bgfx::TextureHandle m_texture;
+        };
+
+        // a sorted queue where neighbours share material and geometry, as after the render queue sort
+        class StateScene
+        {
+        public:
+            StateScene()
+            {
+                bgfx::VertexDecl decl;
+                decl.begin().add(bgfx::Attrib::Position, 3, bgfx::AttribType::Float).end();
+                const float vertices[9] = {};
+                const AZ::u16 indices[3] = { 0, 1, 2 };
+                m_vertexBuffer = bgfx::createVertexBuffer(bgfx::copy(vertices, sizeof(vertices)), decl);
+                m_indexBuffer = bgfx::createIndexBuffer(bgfx::copy(indices, sizeof(indices)));
+
+                char name[16];
+                for (AZ::u32 i = 0; i < k_uniformCount; ++i)
+                {
+                    snprintf(name, sizeof(name), "u_param%u", i);
+                    m_uniforms[i] = bgfx::createUniform(name, bgfx::UniformType::Vec4);
+                }
+                m_sampler = bgfx::createUniform("s_texColor", bgfx::UniformType::Int1);
+
+                const AZ::u32 white = 0xFFFFFFFF;
+                for (auto& material : m_materials)
+                {
+                    memset(material.m_values, 0, sizeof(material.m_values));
+                    material.m_texture = bgfx::createTexture2D(1, 1, false, 1, bgfx::TextureFormat::RGBA8, 0, bgfx::copy(&white, sizeof(white)));
+                }
+
+                m_draws.resize(k_drawCount);
+                for (AZ::u32 i = 0; i < k_drawCount; ++i)
+                {
+                    AZ::Transform::CreateTranslation(AZ::Vector3(float(i), 0.0f, 0.0f)).StoreToColumnMajorFloat16Ex(m_draws[i].m_worldMatrix);
+                    m_draws[i].m_material = i * k_materialCount / k_drawCount;
+                }
+            }
+
+            ~StateScene()
+            {
+                for (auto& material : m_materials)
+                {
+                    bgfx::destroy(material.m_texture);
+                }
+                for (auto uniform : m_uniforms)
+                {
+                    bgfx::destroy(uniform);
+                }
+                bgfx::destroy(m_sampler);
+                bgfx::destroy(m_vertexBuffer);
+                bgfx::destroy(m_indexBuffer);
+            }
+
+            void SubmitRebinding()
+            {
+                bgfx::Encoder* encoder = bgfx::begin();
+                for (const auto& draw : m_draws)
+                {
+                    encoder->setVertexBuffer(0, m_vertexBuffer);
+                    encoder->setIndexBuffer(m_indexBuffer);
+                    encoder->setTransform(draw.m_worldMatrix);
+                    BindMaterial(encoder, m_materials[draw.m_material]);
+                    encoder->setState(BGFX_STATE_DEFAULT);
+                    encoder->submit(0, BGFX_INVALID_HANDLE);
+                }
+                bgfx::end(encoder);
+            }
+
+            // the same decisions RenderNode::Apply makes with a SubmitState
+            void SubmitPreserving()
+            {
+                bgfx::Encoder* encoder = bgfx::begin();
+                bool isBound = false;
+                for (AZ::u32 i = 0; i < k_drawCount; ++i)
+                {
+                    const auto& draw = m_draws[i];
+                    if (!isBound)
+                    {
+                        encoder->setVertexBuffer(0, m_vertexBuffer);
+                        encoder->setIndexBuffer(m_indexBuffer);
+                    }
+                    encoder->setTransform(draw.m_worldMatrix);
+                    if (!isBound)
+                    {
+                        BindMaterial(encoder, m_materials[draw.m_material]);
+                        encoder->setState(BGFX_STATE_DEFAULT);
+                    }
+
+                    isBound = i + 1 < k_drawCount && m_draws[i + 1].m_material == draw.m_material;
+                    encoder->submit(0, BGFX_INVALID_HANDLE, 0, isBound);
+                }
+                bgfx::end(encoder);
+            }
+
+        private:
+            void BindMaterial(bgfx::Encoder* encoder, const Material& material)
+            {
+                for (AZ::u32 i = 0; i < k_uniformCount; ++i)
+                {
+                    encoder->setUniform(m_uniforms[i], material.m_values[i]);
+                }
+                encoder->setTexture(0, m_sampler, material.m_texture);
+            }
+
+            AZStd::vector<Draw>      m_draws;
+            Material                 m_materials[k_materialCount];
+            bgfx::UniformHandle      m_uniforms[k_uniformCount];
+            bgfx::UniformHandle      m_sampler;
+            bgfx::VertexBufferHandle m_vertexBuffer;
+            bgfx::IndexBufferHandle  m_indexBuffer;
+        };
+    }
+
+    void RunStateBenchmark()
+    {
+        bgfx::Init init;
+        init.type = bgfx::RendererType::Noop;
+        if (!bgfx::init(init))
+        {
+            printf("failed to initialize the noop renderer\n");
+            return;
+        }
+
+        {
+            StateScene scene;
+
+            Print("rebind every draw", k_drawCount, Measure(k_frameCount, [&scene]()
+            {
+                scene.SubmitRebinding();
+                bgfx::frame();
+            }));
+
+            Print("preserved state", k_drawCount, Measure(k_frameCount, [&scene]()
+            {
+                scene.SubmitPreserving();
+                bgfx::frame();
+            }));
+        }
+
+        bgfx::frame();
+        bgfx::shutdown();
+    }
+}
@@ -0,0 +1,117 @@
+#include "Benchmark.h"
+
+#include <AzCore/Jobs/JobCompletion.h>
+#include <AzCore/Jobs/JobContext.h>
+#include <AzCore/Jobs/JobFunction.h>
+#include <AzCore/Jobs/JobManager.h>
+#include <AzCore/Math/Transform.h>
+#include <AzCore/std/parallel/thread.h>
+
+#include <bgfx/bgfx.h>
+
+#include <stdio.h>
+
+namespace Benchmark
+{
+    namespace
+    {
+        // stays below BGFX_CONFIG_MAX_DRAW_CALLS
+        const AZ::u32 k_drawCount  = 60000;
+        const AZ::u32 k_frameCount = 30;
+
+        struct Draw
+        {
+            float m_worldMatrix[16];
+        };
+
+        void SubmitRange(const AZStd::vector<Draw>& draws, AZ::u32 begin, AZ::u32 end, bgfx::VertexBufferHandle vertexBuffer, bgfx::IndexBufferHandle indexBuffer)
+        {
+            bgfx::Encoder* encoder = bgfx::begin();
+            for (AZ::u32 i = begin; i < end; ++i)
+            {
+                encoder->setTransform(draws[i].m_worldMatrix);
+                encoder->setVertexBuffer(0, vertexBuffer);
+                encoder->setIndexBuffer(indexBuffer);
+                encoder->setState(BGFX_STATE_DEFAULT);
+                encoder->submit(0, BGFX_INVALID_HANDLE);
+            }
+            bgfx::end(encoder);
+        }
+    }
+
+    void RunSubmitBenchmark()
+    {
+        AZ::AllocatorInstance<AZ::ThreadPoolAllocator>::Create();
+
+        bgfx::Init init;
+        init.type = bgfx::RendererType::Noop;
+        if (!bgfx::init(init))
+        {
+            printf("failed to initialize the noop renderer\n");
+            AZ::AllocatorInstance<AZ::ThreadPoolAllocator>::Destroy();
+            return;
+        }
+
+        // the main thread keeps the first encoder, like RendererSystemComponent
+        const AZ::u32 maxJobs = AZStd::GetMax<AZ::u32>(bgfx::getCaps()->limits.maxEncoders - 1, 1);
+        printf("%u hardware threads\n", AZStd::thread::hardware_concurrency());
+
+        AZ::JobManagerDesc desc;
+        for (AZ::u32 i = 0; i < maxJobs; ++i)
+        {
+            desc.m_workerThreads.push_back(AZ::JobManagerThreadDesc());
+        }
+
+        {
+            AZ::JobManager jobManager(desc);
+            AZ::JobContext jobContext(jobManager);
+
+            bgfx::VertexDecl decl;
+            decl.begin().add(bgfx::Attrib::Position, 3, bgfx::AttribType::Float).end();
+            const float vertices[9] = {};
+            const AZ::u16 indices[3] = { 0, 1, 2 };
+            auto vertexBuffer = bgfx::createVertexBuffer(bgfx::copy(vertices, sizeof(vertices)), decl);
+            auto indexBuffer = bgfx::createIndexBuffer(bgfx::copy(indices, sizeof(indices)));
+
+            AZStd::vector<Draw> draws(k_drawCount);
+            for (AZ::u32 i = 0; i < k_drawCount; ++i)
+            {
+                AZ::Transform::CreateTranslation(AZ::Vector3(float(i), 0.0f, 0.0f)).StoreToColumnMajorFloat16Ex(draws[i].m_worldMatrix);
+            }
+
+            for (AZ::u32 jobCount = 1; jobCount <= maxJobs; jobCount *= 2)
+            {
+                const Result result = Measure(k_frameCount, [&]()
+                {
+                    AZ::JobCompletion completion(&jobContext);
+                    const AZ::u32 rangeSize = (k_drawCount + jobCount - 1) / jobCount;
+                    for (AZ::u32 begin = 0; begin < k_drawCount; begin += rangeSize)
+                    {
+                        const AZ::u32 end = AZStd::GetMin(begin + rangeSize, k_drawCount);
+                        auto job = AZ::CreateJobFunction([&, begin, end]()
+                        {
+                            SubmitRange(draws, begin, end, vertexBuffer, indexBuffer);
+                        }, true, &jobContext);
+                        job->SetDependent(&completion);
+                        job->Start();
+                    }
+                    completion.StartAndWaitForCompletion();
+
+                    bgfx::frame();
+                });
+
+                char name[32];
+                snprintf(name, sizeof(name), "%u encoder jobs", jobCount);
+                Print(name, k_drawCount, result);
+            }
+
+            bgfx::destroy(vertexBuffer);
+            bgfx::destroy(indexBuffer);
+            bgfx::frame();
+        }
+
+        bgfx::shutdown();
+
+        AZ::AllocatorInstance<AZ::ThreadPoolAllocator>::Destroy();
+    }
+}
@@ -0,0 +1,270 @@
+#include "Benchmark.h"
+
+#include "Renderer/Asset/TextureAssetHandler.h"
+#include "Renderer/Util/MappedFile.h"
+
+#include <AzCore/Asset/AssetManager.h>
+#include <AzCore/IO/FileIO.h>
+#include <AzCore/IO/LocalFileIO.h>
+#include <AzCore/IO/SystemFile.h>
+#include <AzCore/Memory/PoolAllocator.h>
+
+#include <bgfx/bgfx.h>
+#include <bimg/bimg.h>
+#include <bx/allocator.h>
+#include <bx/error.h>
+#include <bx/file.h>
+#include <bx/timer.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+namespace bgfx
+{
+    extern bx::AllocatorI* g_allocator;
+}
+
+namespace Benchmark
+{
+    namespace
+    {
+        const AZ::u32  k_textureCount = 48;
+        const uint16_t k_textureSize  = 1024;
+
+        struct TextureFile
+        {
+            AZStd::string m_path;
+            bool          m_isKtx = false;
+        };
+
+        // writes a mipmapped BC3 image with random blocks, every fourth file is a ktx
+        AZStd::vector<TextureFile> WriteTextures(const AZStd::string& directory)
+        {
+            bx::DefaultAllocator allocator;
+            bimg::ImageContainer* image = bimg::imageAlloc(&allocator, bimg::TextureFormat::BC3, k_textureSize, k_textureSize, 1, 1, false, true);
+
+            AZStd::vector<TextureFile> files;
+            AZ::u32 value = 0x12345678;
+            for (AZ::u32 i = 0; i < k_textureCount; ++i)
+            {
+                auto data = static_cast<AZ::u32*>(image->m_data);
+                for (AZ::u32 word = 0; word < image->m_size / sizeof(AZ::u32); ++word)
+                {
+                    value ^= value << 13;
+                    value ^= value >> 17;
+                    value ^= value << 5;
+                    data[word] = value;
+                }
+
+                TextureFile file;
+                file.m_isKtx = i % 4 == 3;
+                file.m_path = AZStd::string::format("%s/%u.%s", directory.c_str(), i, file.m_isKtx ? "ktx" : "dds");
+
+                bx::FileWriter writer;
+                bx::Error error;
+                if (!bx::open(&writer, file.m_path.c_str(), false, &error))
+                {
+                    printf("can not write %s\n", file.m_path.c_str());
+                    continue;
+                }
+                if (file.m_isKtx)
+                {
+                    bimg::imageWriteKtx(&writer, *image, image->m_data, image->m_size, &error);
+                }
+                else
+                {
+                    bimg::imageWriteDds(&writer, *image, image->m_data, image->m_size, &error);
+                }
+
+                // no serialized TextureAsset follows the image
+                const AZ::u32 metadataOffset = 0;
+                bx::write(&writer, metadataOffset, &error);
+                bx::close(&writer);
+
+                files.push_back(file);
+            }
+
+            bimg::imageFree(image);
+            return files;
+        }
+
+        // the high water mark of the resident set, reset before every run
+        void ResetPeakRss()
+        {
+#if defined(AZ_PLATFORM_LINUX)
+            if (FILE* file = fopen("/proc/self/clear_refs", "w"))
+            {
+                fputs("5", file);
+                fclose(file);
+            }
+#endif
+        }
+
+        // reads a kB field of /proc/self/status
+        AZ::u64 ReadStatus(const char* format)
+        {
+            AZ::u64 bytes = 0;
+#if defined(AZ_PLATFORM_LINUX)
+            if (FILE* file = fopen("/proc/self/status", "r"))
+            {
+                char line[256];
+                while (fgets(line, sizeof(line), file))
+                {
+                    unsigned long long kilobytes = 0;
+                    if (sscanf(line, format, &kilobytes) == 1)
+                    {
+                        bytes = kilobytes * 1024;
+                    }
+                }
+                fclose(file);
+            }
+#endif
+            return bytes;
+        }
+
+        // the previous TextureAssetHandler: read into a buffer, parse into a container, copy for bgfx
+        bgfx::TextureHandle LoadCopying(const TextureFile& file)
+        {
+            const size_t length = AZ::IO::SystemFile::Length(file.m_path.c_str());
+            void* buffer = azmalloc(length);
+            AZ::IO::SystemFile::Read(file.m_path.c_str(), buffer, length);
+
+            bimg::ImageContainer* image = file.m_isKtx
+                ? bimg::imageParseKtx(bgfx::g_allocator, buffer, static_cast<uint32_t>(length), nullptr)
+                : bimg::imageParseDds(bgfx::g_allocator, buffer, static_cast<uint32_t>(length), nullptr);
+
+            bgfx::TextureHandle handle = BGFX_INVALID_HANDLE;
+            if (image)
+            {
+                handle = bgfx::createTexture2D(uint16_t(image->m_width), uint16_t(image->m_height), 1 < image->m_numMips, image->m_numLayers,
+                                               bgfx::TextureFormat::Enum(image->m_format), 0, bgfx::copy(image->m_data, image->m_size));
+                bimg::imageFree(image);
+            }
+            azfree(buffer);
+            return handle;
+        }
+
+        // stands in for the gpu upload, which reads the referenced file pages when bgfx processes the frame
+        AZ::u64 TouchFile(const TextureFile& file, AZStd::vector<Module::MappedFilePtr>& mappedFiles)
+        {
+            AZ::IO::FileIOStream stream(file.m_path.c_str(), AZ::IO::OpenMode::ModeRead);
+            auto mapped = Module::MappedFile::Open(stream);
+            AZ::u64 sum = 0;
+            for (size_t offset = 0; mapped && offset < mapped->GetSize(); offset += 4096)
+            {
+                sum += static_cast<AZ::u8>(mapped->GetData()[offset]);
+            }
+            mappedFiles.push_back(mapped);
+            return sum;
+        }
+
+        // peak rss counts the mapped file pages as well, the anonymous memory still held when the frame is submitted
+        // is what the copies cost on top of them
+        void Report(const char* name, const AZStd::function<void()>& load)
+        {
+            bgfx::frame();
+            ResetPeakRss();
+            const AZ::u64 peakBefore = ReadStatus("VmHWM: %llu kB");
+            const AZ::u64 anonymousBefore = ReadStatus("RssAnon: %llu kB");
+
+            // a single cold run, repeating it would measure the page cache and the allocator instead of the load
+            const int64_t start = bx::getHPCounter();
+            load();
+            const AZ::u64 anonymous = ReadStatus("RssAnon: %llu kB");
+            bgfx::frame();
+            const double ms = double(bx::getHPCounter() - start) * 1000.0 / double(bx::getHPFrequency());
+
+            const double megabyte = 1024.0 * 1024.0;
+            printf("%-32s %8u  %8.1f ms  peak rss +%.1f MB  anonymous at submit +%.1f MB\n", name, k_textureCount, ms,
+                   (ReadStatus("VmHWM: %llu kB") - peakBefore) / megabyte, (anonymous - anonymousBefore) / megabyte);
+        }
+    }
+
+    void RunTextureLoadBenchmark()
+    {
+#if !defined(AZ_PLATFORM_LINUX)
+        printf("peak rss is only measured on linux\n");
+#endif
+        char directoryTemplate[] = "/tmp/texture_load_XXXXXX";
+        if (!mkdtemp(directoryTemplate))
+        {
+            printf("can not create a temporary directory\n");
+            return;
+        }
+        const AZStd::string directory = directoryTemplate;
+
+        bgfx::Init init;
+        init.type = bgfx::RendererType::Noop;
+        if (!bgfx::init(init))
+        {
+            printf("failed to initialize the noop renderer\n");
+            return;
+        }
+
+        AZ::AllocatorInstance<AZ::PoolAllocator>::Create();
+        AZ::AllocatorInstance<AZ::ThreadPoolAllocator>::Create();
+        AZ::Data::AssetManager::Create(AZ::Data::AssetManager::Descriptor());
+
+        AZ::IO::LocalFileIO fileIO;
+        AZ::IO::FileIOBase::SetInstance(&fileIO);
+
+        {
+            const auto files = WriteTextures(directory);
+            printf("%u textures of %ux%u BC3 with mips, a level load followed by one frame\n", k_textureCount, k_textureSize, k_textureSize);
+
+            AZStd::vector<bgfx::TextureHandle> handles;
+
+            Report("read, parse and copy", [&]()
+            {
+                for (const auto& file : files)
+                {
+                    handles.push_back(LoadCopying(file));
+                }
+            });
+
+            for (auto handle : handles)
+            {
+                bgfx::destroy(handle);
+            }
+            handles.clear();
+
+            Module::TextureAssetHandler handler;
+            AZStd::vector<AZ::Data::Asset<AZ::Data::AssetData>> assets;
+            AZStd::vector<Module::MappedFilePtr> uploads;
+
+            Report("map and reference", [&]()
+            {
+                for (const auto& file : files)
+                {
+                    auto asset = AZ::Data::AssetManager::Instance().CreateAsset(AZ::Data::AssetId(AZ::Uuid::CreateRandom()),
+                                                                                AZ::AzTypeInfo<Module::TextureAsset>::Uuid());
+                    AZ::IO::FileIOStream stream(file.m_path.c_str(), AZ::IO::OpenMode::ModeRead);
+                    handler.LoadAssetData(asset, &stream, AZ::Data::AssetFilterCB());
+                    assets.push_back(asset);
+
+                    if (!file.m_isKtx)
+                    {
+                        TouchFile(file, uploads);
+                    }
+                }
+            });
+            uploads.clear();
+
+            assets.clear();
+            bgfx::frame();
+
+            for (const auto& file : files)
+            {
+                AZ::IO::SystemFile::Delete(file.m_path.c_str());
+            }
+        }
+
+        AZ::IO::FileIOBase::SetInstance(nullptr);
+        AZ::Data::AssetManager::Destroy();
+        AZ::AllocatorInstance<AZ::ThreadPoolAllocator>::Destroy();
+        AZ::AllocatorInstance<AZ::PoolAllocator>::Destroy();
+
+        bgfx::shutdown();
+        rmdir(directory.c_str());
+    }
+}
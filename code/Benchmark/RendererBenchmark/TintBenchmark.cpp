@@ -0,0 +1,152 @@
+#include "Benchmark.h"
+
+#include "Renderer/Base/MaterialPropertyBlock.h"
+
+#include <AzCore/Math/Transform.h>
+
+#include <bgfx/bgfx.h>
+
+#include <stdio.h>
+
+namespace Benchmark
+{
+    namespace
+    {
+        const AZ::u32 k_unitCount  = 20000;
+        const AZ::u32 k_frameCount = 30;
+
+        // every unit shares mesh and material and only differs in its tint, like a crowd of team colored units
+        class TintScene
+        {
+        public:
+            TintScene()
+                : m_tintName("u_tint")
+            {
+                bgfx::VertexDecl decl;
+                decl.begin().add(bgfx::Attrib::Position, 3, bgfx::AttribType::Float).end();
+                const float vertices[9] = {};
+                const AZ::u16 indices[3] = { 0, 1, 2 };
+                m_vertexBuffer = bgfx::createVertexBuffer(bgfx::copy(vertices, sizeof(vertices)), decl);
+                m_indexBuffer = bgfx::createIndexBuffer(bgfx::copy(indices, sizeof(indices)));
+                m_tint = bgfx::createUniform("u_tint", bgfx::UniformType::Vec4);
+
+                m_worldMatrices.resize(k_unitCount * 16);
+                m_blocks.resize(k_unitCount);
+                for (AZ::u32 i = 0; i < k_unitCount; ++i)
+                {
+                    AZ::Transform::CreateTranslation(AZ::Vector3(float(i), 0.0f, 0.0f)).StoreToColumnMajorFloat16Ex(&m_worldMatrices[i * 16]);
+                    m_blocks[i].SetVector(m_tintName, AZ::Vector4(float(i % 7) / 7.0f, float(i % 5) / 5.0f, float(i % 3) / 3.0f, 1.0f));
+                }
+            }
+
+            ~TintScene()
+            {
+                bgfx::destroy(m_tint);
+                bgfx::destroy(m_vertexBuffer);
+                bgfx::destroy(m_indexBuffer);
+            }
+
+            // a cloned material per unit, every unit is its own draw call
+            void SubmitPerUnit()
+            {
+                bgfx::Encoder* encoder = bgfx::begin();
+                for (AZ::u32 i = 0; i < k_unitCount; ++i)
+                {
+                    encoder->setVertexBuffer(0, m_vertexBuffer);
+                    encoder->setIndexBuffer(m_indexBuffer);
+                    encoder->setTransform(&m_worldMatrices[i * 16]);
+                    encoder->setUniform(m_tint, m_blocks[i].FindVector(m_tintName));
+                    encoder->setState(BGFX_STATE_DEFAULT);
+                    encoder->submit(0, BGFX_INVALID_HANDLE);
+                }
+                bgfx::end(encoder);
+            }
+
+            // the shared material with a property block per unit, the tints go into the instance data as in
+            // RenderNode::ApplyInstanced
+            void SubmitInstanced()
+            {
+                const uint16_t stride = sizeof(float) * 20;
+
+                bgfx::Encoder* encoder = bgfx::begin();
+                AZ::u32 drawn = 0;
+                while (drawn < k_unitCount)
+                {
+                    const AZ::u32 available = bgfx::getAvailInstanceDataBuffer(k_unitCount - drawn, stride);
+                    if (available == 0)
+                    {
+                        break;
+                    }
+
+                    bgfx::InstanceDataBuffer idb;
+                    bgfx::allocInstanceDataBuffer(&idb, available, stride);
+
+                    auto data = reinterpret_cast<float*>(idb.data);
+                    for (AZ::u32 i = 0; i < available; ++i)
+                    {
+                        memcpy(data + i * 20, &m_worldMatrices[(drawn + i) * 16], sizeof(float) * 16);
+                        memcpy(data + i * 20 + 16, m_blocks[drawn + i].FindVector(m_tintName), sizeof(float) * 4);
+                    }
+
+                    encoder->setVertexBuffer(0, m_vertexBuffer);
+                    encoder->setIndexBuffer(m_indexBuffer);
+                    encoder->setInstanceDataBuffer(&idb);
+                    encoder->setState(BGFX_STATE_DEFAULT);
+                    encoder->submit(0, BGFX_INVALID_HANDLE);
+                    ++m_drawCalls;
+
+                    drawn += available;
+                }
+                bgfx::end(encoder);
+            }
+
+            AZ::u32 TakeDrawCalls()
+            {
+                const AZ::u32 drawCalls = m_drawCalls;
+                m_drawCalls = 0;
+                return drawCalls;
+            }
+
+        private:
+            AZ::Crc32                                     m_tintName;
+            AZStd::vector<float>                          m_worldMatrices;
+            AZStd::vector<Module::MaterialPropertyBlock>  m_blocks;
+            bgfx::UniformHandle                           m_tint;
+            bgfx::VertexBufferHandle                      m_vertexBuffer;
+            bgfx::IndexBufferHandle                       m_indexBuffer;
+            AZ::u32                                       m_drawCalls = 0;
+        };
+    }
+
+    void RunTintBenchmark()
+    {
+        bgfx::Init init;
+        init.type = bgfx::RendererType::Noop;
+        if (!bgfx::init(init))
+        {
+            printf("failed to initialize the noop renderer\n");
+            return;
+        }
+
+        {
+            TintScene scene;
+
+            Print("material per unit", k_unitCount, Measure(k_frameCount, [&scene]()
+            {
+                scene.SubmitPerUnit();
+                bgfx::frame();
+            }));
+
+            scene.TakeDrawCalls();
+            Print("property blocks, instanced", k_unitCount, Measure(k_frameCount, [&scene]()
+            {
+                scene.SubmitInstanced();
+                bgfx::frame();
+            }));
+            printf("  %u draw calls per frame instead of %u\n", scene.TakeDrawCalls() / (k_frameCount + 1), k_unitCount);
+        }
+
+        bgfx::frame();
+        bgfx::shutdown();
+    }
+}
@@ -0,0 +1,232 @@
+#include "Benchmark.h"
+
+#include "Renderer/Base/TransientGeometry.h"
+#include "Renderer/Base/Vertex2d.h"
+
+#include <bgfx/bgfx.h>
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+namespace Benchmark
+{
+    namespace
+    {
+        // 100 emitters of 256 particles, the float layout still fits into the default transient memory
+        const AZ::u32 k_emitterCount  = 100;
+        const AZ::u32 k_particleCount = 256;
+        const AZ::u32 k_frameCount    = 60;
+
+        const AZ::u16 s_quadIndices[6] = { 0, 1, 2, 0, 2, 3 };
+        const float   s_quadCorners[4][2] = { { -0.5f, -0.5f }, { 0.5f, -0.5f }, { 0.5f, 0.5f }, { -0.5f, 0.5f } };
+
+        // the layout the 2D producers used before Vertex2d
+        struct FloatVertex
+        {
+            float x, y, u, v;
+            float r, g, b, a;
+        };
+
+        struct Particle
+        {
+            float m_x;
+            float m_y;
+            float m_size;
+            float m_angle;
+            float m_life;
+            AZ::u32 m_frame; // of a 4x4 frame sheet
+        };
+
+        float Random(float min, float max)
+        {
+            return min + (max - min) * float(rand()) / float(RAND_MAX);
+        }
+
+        class EmitterScene
+        {
+        public:
+            EmitterScene()
+            {
+                srand(5);
+
+                m_floatDecl.begin()
+                    .add(bgfx::Attrib::Position, 2, bgfx::AttribType::Float)
+                    .add(bgfx::Attrib::TexCoord0, 2, bgfx::AttribType::Float)
+                    .add(bgfx::Attrib::Color0, 4, bgfx::AttribType::Float)
+                    .end();
+
+                m_particles.resize(k_emitterCount * k_particleCount);
+                m_staging.resize(k_emitterCount * k_particleCount * 4 * sizeof(FloatVertex));
+                for (auto& particle : m_particles)
+                {
+                    particle.m_x = Random(-10.0f, 10.0f);
+                    particle.m_y = Random(-10.0f, 10.0f);
+                    particle.m_size = Random(0.05f, 0.3f);
+                    particle.m_angle = Random(0.0f, 6.28f);
+                    particle.m_life = Random(0.0f, 1.0f);
+                    particle.m_frame = static_cast<AZ::u32>(rand() % 16);
+                }
+            }
+
+            // every emitter writes its quads into a range of its own, as Particle2dComponent does
+            // the color is packed once per particle and written to its 4 corners
+            template <typename Vertex, typename Color, typename Write>
+            void Generate(const bgfx::VertexDecl& decl, const Color& color, const Write& write)
+            {
+                for (AZ::u32 emitter = 0; emitter < k_emitterCount; ++emitter)
+                {
+                    const auto range = m_geometry.Allocate(decl, k_particleCount * 4, k_particleCount * 6);
+                    if (!range.IsValid())
+                    {
+                        ++m_failedCount;
+                        continue;
+                    }
+                    m_ranges.push_back({ range.m_vertices, range.m_vertexCount * decl.getStride() });
+
+                    Vertex* vertices = range.GetVertices<Vertex>();
+                    for (AZ::u32 i = 0; i < k_particleCount; ++i)
+                    {
+                        auto& particle = m_particles[emitter * k_particleCount + i];
+                        particle.m_angle += 0.02f;
+                        particle.m_life = particle.m_life < 1.0f ? particle.m_life + 0.01f : 0.0f;
+
+                        const float c = cosf(particle.m_angle) * particle.m_size;
+                        const float s = sinf(particle.m_angle) * particle.m_size;
+                        const float u0 = float(particle.m_frame % 4) * 0.25f;
+                        const float v0 = float(particle.m_frame / 4) * 0.25f;
+                        const auto corners = color(1.0f - particle.m_life);
+
+                        for (AZ::u32 corner = 0; corner < 4; ++corner)
+                        {
+                            const float x = s_quadCorners[corner][0];
+                            const float y = s_quadCorners[corner][1];
+                            write(vertices[i * 4 + corner], particle.m_x + x * c - y * s, particle.m_y + x * s + y * c,
+                                u0 + (x + 0.5f) * 0.25f, v0 + (y + 0.5f) * 0.25f, corners);
+                        }
+
+                        for (AZ::u32 index = 0; index < 6; ++index)
+                        {
+                            range.m_indices[i * 6 + index] = static_cast<AZ::u16>(range.m_baseVertex + i * 4 + s_quadIndices[index]);
+                        }
+                    }
+                }
+            }
+
+            void GenerateFloat()
+            {
+                Generate<FloatVertex>(m_floatDecl, [](float alpha) { return alpha; },
+                    [](FloatVertex& vertex, float x, float y, float u, float v, float alpha)
+                {
+                    vertex = { x, y, u, v, 1.0f, 0.8f, 0.4f, alpha };
+                });
+            }
+
+            void GeneratePacked()
+            {
+                Generate<Module::Vertex2d>(Module::Vertex2d::GetVertexDecl(), [](float alpha) { return Module::Vertex2d::PackColor(1.0f, 0.8f, 0.4f, alpha); },
+                    [](Module::Vertex2d& vertex, float x, float y, float u, float v, AZ::u32 abgr)
+                {
+                    vertex.Set(x, y, u, v, abgr);
+                });
+            }
+
+            // the noop renderer never reads the transient memory, a backend copies it into a gpu buffer every frame
+            void Upload()
+            {
+                size_t offset = 0;
+                for (const auto& range : m_ranges)
+                {
+                    memcpy(m_staging.data() + offset, range.first, range.second);
+                    offset += range.second;
+                }
+            }
+
+            void Frame()
+            {
+                m_usedBytes = m_geometry.GetStats().m_usedVertexBytes;
+                m_ranges.clear();
+                bgfx::frame();
+                m_geometry.NextFrame();
+            }
+
+            AZ::u32 GetUsedBytes() const { return m_usedBytes; }
+            AZ::u32 GetFailedCount() const { return m_failedCount; }
+
+        private:
+            AZStd::vector<Particle>   m_particles;
+            AZStd::vector<AZ::u8>     m_staging;
+            AZStd::vector<AZStd::pair<const void*, size_t>> m_ranges; // written this frame
+            bgfx::VertexDecl          m_floatDecl;
+            Module::TransientGeometry m_geometry;
+            AZ::u32                   m_usedBytes   = 0;
+            AZ::u32                   m_failedCount = 0;
+        };
+    }
+
+    void RunVertex2dBenchmark()
+    {
+        bgfx::Init init;
+        init.type = bgfx::RendererType::Noop;
+        if (!bgfx::init(init))
+        {
+            printf("failed to initialize the noop renderer\n");
+            return;
+        }
+
+        {
+            EmitterScene scene;
+            const AZ::u32 quadCount = k_emitterCount * k_particleCount;
+
+            Print("float vertices (32 bytes)", quadCount, Measure(k_frameCount, [&scene]()
+            {
+                scene.GenerateFloat();
+                scene.Frame();
+            }));
+            Print("float vertices + upload", quadCount, Measure(k_frameCount, [&scene]()
+            {
+                scene.GenerateFloat();
+                scene.Upload();
+                scene.Frame();
+            }));
+            printf("  %u KB of vertices per frame\n", scene.GetUsedBytes() / 1024);
+
+            // the copy of the vertices written by one frame alone, as a backend uploads them
+            scene.GenerateFloat();
+            Print("float upload", quadCount, Measure(k_frameCount, [&scene]()
+            {
+                scene.Upload();
+            }));
+            scene.Frame();
+
+            Print("packed vertices (16 bytes)", quadCount, Measure(k_frameCount, [&scene]()
+            {
+                scene.GeneratePacked();
+                scene.Frame();
+            }));
+            Print("packed vertices + upload", quadCount, Measure(k_frameCount, [&scene]()
+            {
+                scene.GeneratePacked();
+                scene.Upload();
+                scene.Frame();
+            }));
+            printf("  %u KB of vertices per frame\n", scene.GetUsedBytes() / 1024);
+
+            scene.GeneratePacked();
+            Print("packed upload", quadCount, Measure(k_frameCount, [&scene]()
+            {
+                scene.Upload();
+            }));
+            scene.Frame();
+
+            if (scene.GetFailedCount() > 0)
+            {
+                printf("  %u emitters did not fit into transient memory\n", scene.GetFailedCount());
+            }
+        }
+
+        bgfx::frame();
+        bgfx::shutdown();
+    }
+}
@@ -0,0 +1,91 @@
+#include "Benchmark.h"
+
+#include <AzCore/Memory/OSAllocator.h>
+#include <AzCore/Memory/SystemAllocator.h>
+#include <AzCore/std/sort.h>
+
+#include <bx/timer.h>
+
+#include <stdio.h>
+#include <string.h>
+
+namespace Benchmark
+{
+    Result Measure(AZ::u32 iterations, const AZStd::function<void()>& function)
+    {
+        function(); // warm up caches and allocations
+
+        AZStd::vector<double> samples;
+        samples.reserve(iterations);
+
+        const double toMs = 1000.0 / double(bx::getHPFrequency());
+        for (AZ::u32 i = 0; i < iterations; ++i)
+        {
+            const int64_t start = bx::getHPCounter();
+            function();
+            samples.push_back(double(bx::getHPCounter() - start) * toMs);
+        }
+
+        AZStd::sort(samples.begin(), samples.end());
+
+        Result result;
+        result.m_minMs = samples.front();
+        result.m_medianMs = samples[samples.size() / 2];
+        for (auto sample : samples)
+        {
+            result.m_meanMs += sample;
+        }
+        result.m_meanMs /= double(samples.size());
+        return result;
+    }
+
+    void Print(const char* name, AZ::u32 count, const Result& result)
+    {
+        printf("%-32s %8u  min %8.3f ms  median %8.3f ms  mean %8.3f ms\n", name, count, result.m_minMs, result.m_medianMs, result.m_meanMs);
+    }
+}
+
+struct Suite
+{
+    const char* m_name;
+    void (*m_run)();
+};
+
+static const Suite s_suites[] =
+{
+    { "sort",    &Benchmark::RunSortBenchmark },
+    { "submit",  &Benchmark::RunSubmitBenchmark },
+    { "deform",  &Benchmark::RunDeformBenchmark },
+    { "state",   &Benchmark::RunStateBenchmark },
+    { "tint",    &Benchmark::RunTintBenchmark },
+    { "resident", &Benchmark::RunResidentBenchmark },
+    { "textureload", &Benchmark::RunTextureLoadBenchmark },
+    { "vertex2d", &Benchmark::RunVertex2dBenchmark },
+};
+
+int main(int argc, char* argv[])
+{
+    // the os allocator backs the environment of the buses used by the renderer classes
+    AZ::AllocatorInstance<AZ::OSAllocator>::Create();
+    AZ::AllocatorInstance<AZ::SystemAllocator>::Create();
+
+    for (const auto& suite : s_suites)
+    {
+        bool selected = argc < 2;
+        for (int i = 1; i < argc; ++i)
+        {
+            selected |= strcmp(argv[i], suite.m_name) == 0;
+        }
+
+        if (selected)
+        {
+            printf("== %s ==\n", suite.m_name);
+            suite.m_run();
+        }
+    }
+
+    AZ::AllocatorInstance<AZ::SystemAllocator>::Destroy();
+    AZ::AllocatorInstance<AZ::OSAllocator>::Destroy();
+
+    return 0;
+}
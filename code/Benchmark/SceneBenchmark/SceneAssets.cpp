@@ -0,0 +1,339 @@
+#include "SceneBenchmark.h"
+
+#include "Renderer/Asset/MaterialAsset.h"
+#include "Renderer/Asset/MeshFormat.h"
+#include "Renderer/Asset/ShaderAsset.h"
+#include "Renderer/Asset/TextureAsset.h"
+
+#include <AzCore/IO/ByteContainerStream.h>
+#include <AzCore/IO/SystemFile.h>
+#include <AzCore/Math/MathUtils.h>
+#include <AzCore/Serialization/ObjectStream.h>
+#include <AzCore/Serialization/Util.h>
+#include <AzCore/StringFunc/StringFunc.h>
+
+#include <bgfx/bgfx.h>
+#include <bimg/bimg.h>
+#include <bx/allocator.h>
+#include <bx/error.h>
+#include <bx/readerwriter.h>
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+namespace SceneBenchmark
+{
+    const char* k_meshPath           = "bench/meshes/cube";
+    const char* k_lodMeshPaths[k_lodCount] = { "bench/meshes/sphere0", "bench/meshes/sphere1", "bench/meshes/sphere2" };
+    const char* k_atlasPath          = "bench/textures/atlas.png";
+    const char* k_spriteMaterialPath = "bench/materials/sprite";
+
+    AZStd::string GetMaterialPath(AZ::u32 index)
+    {
+        return AZStd::string::format("bench/materials/lit%u", index);
+    }
+
+    AZStd::string GetSpriteName(AZ::u32 index)
+    {
+        return AZStd::string::format("sprite%u", index);
+    }
+
+    namespace
+    {
+        const AZ::u32 k_atlasSize  = 256;
+        const AZ::u32 k_spriteSize = 64;
+
+        bool WriteFile(const AZStd::string& path, const void* data, size_t size)
+        {
+            AZStd::string directory = path;
+            AZ::StringFunc::Path::StripFullName(directory);
+            AZ::IO::SystemFile::CreateDir(directory.c_str());
+
+            AZ::IO::SystemFile file;
+            if (!file.Open(path.c_str(), AZ::IO::SystemFile::SF_OPEN_CREATE | AZ::IO::SystemFile::SF_OPEN_WRITE_ONLY))
+            {
+                printf("can not write %s\n", path.c_str());
+                return false;
+            }
+            const bool written = file.Write(data, size) == size;
+            file.Close();
+            return written;
+        }
+
+        template <typename ObjectType>
+        bool WriteObject(const AZStd::string& path, const ObjectType& object, AZ::SerializeContext* serializeContext)
+        {
+            AZStd::vector<char> buffer;
+            AZ::IO::ByteContainerStream<AZStd::vector<char>> stream(&buffer);
+            return AZ::Utils::SaveObjectToStream(stream, AZ::ObjectStream::ST_XML, &object, serializeContext)
+                && WriteFile(path, buffer.data(), buffer.size());
+        }
+
+        // the header of a shader binary without uniforms, the noop renderer never reads the bytecode. `variant` makes
+        // otherwise identical binaries distinct, bgfx deduplicates shaders by their content.
+        bool WriteShaderBinary(const AZStd::string& path, uint32_t magic, uint8_t variant)
+        {
+            const uint32_t ioHash = 0x5eed5eed;
+            const uint16_t uniformCount = 0;
+
+            char binary[sizeof(magic) + sizeof(ioHash) + sizeof(uniformCount) + sizeof(variant)];
+            memcpy(binary, &magic, sizeof(magic));
+            memcpy(binary + sizeof(magic), &ioHash, sizeof(ioHash));
+            memcpy(binary + sizeof(magic) + sizeof(ioHash), &uniformCount, sizeof(uniformCount));
+            binary[sizeof(binary) - 1] = char(variant);
+            return WriteFile(path, binary, sizeof(binary));
+        }
+
+        bool WriteShader(const AZStd::string& root, const AZStd::string& name, bool isInstanced, AZ::SerializeContext* serializeContext)
+        {
+            const AZStd::string directory = "bench/shaders/" + name + ".shader/";
+            const uint32_t vsMagic = BX_MAKEFOURCC('V', 'S', 'H', 0x5);
+            const uint32_t fsMagic = BX_MAKEFOURCC('F', 'S', 'H', 0x5);
+
+            Module::ShaderAsset::Pass pass;
+            pass.m_name = name;
+            pass.m_vs = directory + "vs.bin";
+            pass.m_fs = directory + "fs.bin";
+            pass.m_rs = BGFX_STATE_WRITE_RGB | BGFX_STATE_WRITE_A | BGFX_STATE_WRITE_Z | BGFX_STATE_DEPTH_TEST_LESS | BGFX_STATE_CULL_CW;
+
+            bool succeeded = WriteShaderBinary(root + pass.m_vs, vsMagic, 0) && WriteShaderBinary(root + pass.m_fs, fsMagic, 0);
+            if (isInstanced)
+            {
+                pass.m_vsInstanced = directory + "vs_instanced.bin";
+                pass.m_instanceProperties.push_back("u_tint");
+                succeeded = succeeded && WriteShaderBinary(root + pass.m_vsInstanced, vsMagic, 1);
+            }
+
+            Module::MaterialAsset::Property tint;
+            tint.m_name = "u_tint";
+            tint.m_vectorValue = AZ::Vector4::CreateOne();
+
+            Module::ShaderAsset shader;
+            shader.SetName(name);
+            shader.AddPass(pass);
+            shader.AddProperty(tint);
+            return succeeded && WriteObject(root + directory + "config.shader", shader, serializeContext);
+        }
+
+        bool WriteMaterial(const AZStd::string& root, const AZStd::string& path, const AZStd::string& shader, AZ::s32 queue,
+                           const AZ::Vector4& tint, AZ::SerializeContext* serializeContext)
+        {
+            Module::MaterialAsset::Property property;
+            property.m_name = "u_tint";
+            property.m_vectorValue = tint;
+
+            Module::MaterialAsset material;
+            material.SetName(path);
+            material.SetShader(shader);
+            material.SetQueue(queue);
+            material.AddProperty(property);
+            return WriteObject(root + path + ".mat", material, serializeContext);
+        }
+
+        struct Vertex
+        {
+            float m_position[3];
+            float m_normal[3];
+            float m_texcoord[2];
+        };
+
+        // position, normal and texcoord0 in one sub mesh within the unit cube, laid out as MeshConverter writes it
+        bool WriteMesh(const AZStd::string& path, const AZStd::vector<Vertex>& vertices, const AZStd::vector<AZ::u16>& indices)
+        {
+            const auto attribute = [](bgfx::Attrib::Enum attrib, AZ::u8 num)
+            {
+                Module::MeshFormat::Attribute attribute;
+                attribute.m_attrib = static_cast<AZ::u8>(attrib);
+                attribute.m_num = num;
+                attribute.m_type = static_cast<AZ::u8>(bgfx::AttribType::Float);
+                return attribute;
+            };
+            const Module::MeshFormat::Attribute attributes[] =
+            {
+                attribute(bgfx::Attrib::Position, 3),
+                attribute(bgfx::Attrib::Normal, 3),
+                attribute(bgfx::Attrib::TexCoord0, 2),
+            };
+            Module::MeshFormat::SubMesh subMesh;
+            subMesh.m_indexCount = static_cast<AZ::u32>(indices.size());
+
+            Module::MeshFormat::Header header;
+            header.m_attributeCount = AZ_ARRAY_SIZE(attributes);
+            header.m_attributeOffset = Module::MeshFormat::Align(sizeof(header));
+            header.m_subMeshCount = 1;
+            header.m_subMeshOffset = Module::MeshFormat::Align(header.m_attributeOffset + sizeof(attributes));
+            header.m_vertexCount = static_cast<AZ::u32>(vertices.size());
+            header.m_vertexStride = sizeof(Vertex);
+            header.m_vertexOffset = Module::MeshFormat::Align(header.m_subMeshOffset + sizeof(subMesh));
+            header.m_indexCount = static_cast<AZ::u32>(indices.size());
+            header.m_indexOffset = Module::MeshFormat::Align(header.m_vertexOffset + header.m_vertexCount * header.m_vertexStride);
+            header.m_fileSize = header.m_indexOffset + header.m_indexCount * sizeof(AZ::u16);
+            for (int i = 0; i < 3; ++i)
+            {
+                header.m_aabbMin[i] = -0.5f;
+                header.m_aabbMax[i] = 0.5f;
+            }
+
+            AZStd::vector<char> buffer(header.m_fileSize, 0);
+            memcpy(buffer.data(), &header, sizeof(header));
+            memcpy(buffer.data() + header.m_attributeOffset, attributes, sizeof(attributes));
+            memcpy(buffer.data() + header.m_subMeshOffset, &subMesh, sizeof(subMesh));
+            memcpy(buffer.data() + header.m_vertexOffset, vertices.data(), vertices.size() * sizeof(Vertex));
+            memcpy(buffer.data() + header.m_indexOffset, indices.data(), indices.size() * sizeof(AZ::u16));
+            return WriteFile(path + ".mesh", buffer.data(), buffer.size());
+        }
+
+        bool WriteCube(const AZStd::string& root)
+        {
+            AZStd::vector<Vertex> vertices;
+            AZStd::vector<AZ::u16> indices;
+            for (int axis = 0; axis < 3; ++axis)
+            {
+                for (int sign = -1; sign <= 1; sign += 2)
+                {
+                    const AZ::u16 first = static_cast<AZ::u16>(vertices.size());
+                    const int u = (axis + 1) % 3;
+                    const int v = (axis + 2) % 3;
+                    for (int corner = 0; corner < 4; ++corner)
+                    {
+                        Vertex vertex = {};
+                        vertex.m_position[axis] = 0.5f * float(sign);
+                        vertex.m_position[u] = (corner & 1) ? 0.5f : -0.5f;
+                        vertex.m_position[v] = (corner & 2) ? 0.5f : -0.5f;
+                        vertex.m_normal[axis] = float(sign);
+                        vertex.m_texcoord[0] = (corner & 1) ? 1.0f : 0.0f;
+                        vertex.m_texcoord[1] = (corner & 2) ? 1.0f : 0.0f;
+                        vertices.push_back(vertex);
+                    }
+
+                    const AZ::u16 quad[2][6] = { { 0, 1, 3, 0, 3, 2 }, { 0, 3, 1, 0, 2, 3 } };
+                    for (AZ::u16 index : quad[sign > 0 ? 0 : 1])
+                    {
+                        indices.push_back(first + index);
+                    }
+                }
+            }
+            return WriteMesh(root + k_meshPath, vertices, indices);
+        }
+
+        // a uv sphere of diameter 1, the triangle count grows with the square of `segments`
+        bool WriteSphere(const AZStd::string& path, AZ::u32 segments)
+        {
+            const AZ::u32 rings = AZStd::GetMax(segments / 2, 2u);
+
+            AZStd::vector<Vertex> vertices;
+            for (AZ::u32 ring = 0; ring <= rings; ++ring)
+            {
+                const float theta = AZ::Constants::Pi * float(ring) / float(rings);
+                for (AZ::u32 segment = 0; segment <= segments; ++segment)
+                {
+                    const float phi = AZ::Constants::TwoPi * float(segment) / float(segments);
+                    Vertex vertex;
+                    vertex.m_normal[0] = sinf(theta) * cosf(phi);
+                    vertex.m_normal[1] = cosf(theta);
+                    vertex.m_normal[2] = sinf(theta) * sinf(phi);
+                    for (int i = 0; i < 3; ++i)
+                    {
+                        vertex.m_position[i] = 0.5f * vertex.m_normal[i];
+                    }
+                    vertex.m_texcoord[0] = float(segment) / float(segments);
+                    vertex.m_texcoord[1] = float(ring) / float(rings);
+                    vertices.push_back(vertex);
+                }
+            }
+
+            AZStd::vector<AZ::u16> indices;
+            for (AZ::u32 ring = 0; ring < rings; ++ring)
+            {
+                for (AZ::u32 segment = 0; segment < segments; ++segment)
+                {
+                    const AZ::u16 a = static_cast<AZ::u16>(ring * (segments + 1) + segment);
+                    const AZ::u16 b = static_cast<AZ::u16>(a + segments + 1);
+                    const AZ::u16 quad[6] = { a, b, AZ::u16(a + 1), AZ::u16(a + 1), b, AZ::u16(b + 1) };
+                    for (AZ::u16 index : quad)
+                    {
+                        indices.push_back(index);
+                    }
+                }
+            }
+            return WriteMesh(path, vertices, indices);
+        }
+
+        // a grid of quad sprites in a BC3 atlas, followed by the serialized TextureAsset as TextureCooker writes it
+        bool WriteAtlas(const AZStd::string& root, AZ::SerializeContext* serializeContext)
+        {
+            const AZ::u32 columns = k_atlasSize / k_spriteSize;
+
+            AZStd::vector<Module::TextureAsset::SpriteData> sprites;
+            for (AZ::u32 i = 0; i < k_spriteCount; ++i)
+            {
+                const float x = float(i % columns * k_spriteSize);
+                const float y = float(i / columns * k_spriteSize);
+                const float half = float(k_spriteSize) * 0.5f;
+
+                Module::TextureAsset::SpriteData sprite;
+                sprite.m_name = GetSpriteName(i);
+                sprite.m_pivot = AZ::Vector2(0.5f, 0.5f);
+                sprite.m_pivotType = Module::SpritePivot::Center;
+                sprite.m_border = AZ::Vector4::CreateZero();
+                sprite.m_size = AZ::Vector4(x, y, float(k_spriteSize), float(k_spriteSize));
+                sprite.m_positions = { AZ::Vector3(-half, half, 0.0f), AZ::Vector3(-half, -half, 0.0f),
+                                       AZ::Vector3(half, -half, 0.0f), AZ::Vector3(half, half, 0.0f) };
+                sprite.m_texcoords = { AZ::Vector2(x / k_atlasSize, y / k_atlasSize), AZ::Vector2(x / k_atlasSize, (y + k_spriteSize) / k_atlasSize),
+                                       AZ::Vector2((x + k_spriteSize) / k_atlasSize, (y + k_spriteSize) / k_atlasSize),
+                                       AZ::Vector2((x + k_spriteSize) / k_atlasSize, y / k_atlasSize) };
+                sprite.m_indices = { 0, 1, 2, 0, 2, 3 };
+                sprites.push_back(sprite);
+            }
+
+            Module::TextureAsset textureAsset;
+            textureAsset.SetSprites(AZStd::move(sprites));
+
+            AZStd::vector<char> metadata;
+            AZ::IO::ByteContainerStream<AZStd::vector<char>> metadataStream(&metadata);
+            if (!AZ::Utils::SaveObjectToStream(metadataStream, AZ::ObjectStream::ST_BINARY, &textureAsset, serializeContext))
+            {
+                return false;
+            }
+
+            bx::DefaultAllocator allocator;
+            bimg::ImageContainer* image = bimg::imageAlloc(&allocator, bimg::TextureFormat::BC3, uint16_t(k_atlasSize), uint16_t(k_atlasSize), 1, 1, false, false);
+            memset(image->m_data, 0x7f, image->m_size);
+
+            bx::MemoryBlock block(&allocator);
+            bx::MemoryWriter writer(&block);
+            bx::Error error;
+            bimg::imageWriteDds(&writer, *image, image->m_data, image->m_size, &error);
+            bimg::imageFree(image);
+
+            const AZ::u32 metadataOffset = static_cast<AZ::u32>(bx::seek(&writer, 0, bx::Whence::Current));
+            bx::write(&writer, metadata.data(), int32_t(metadata.size()), &error);
+            bx::write(&writer, metadataOffset, &error);
+
+            AZStd::string path = root + k_atlasPath;
+            AZ::StringFunc::Path::ReplaceExtension(path, "dds");
+            const int64_t size = bx::seek(&writer, 0, bx::Whence::Current);
+            return error.isOk() && WriteFile(path, block.more(0), static_cast<size_t>(size));
+        }
+    }
+
+    bool WriteAssets(const AZStd::string& root, AZ::SerializeContext* serializeContext, AZ::u32 materialCount)
+    {
+        bool succeeded = WriteShader(root, "lit", true, serializeContext)
+            && WriteShader(root, "sprite", false, serializeContext)
+            && WriteMaterial(root, k_spriteMaterialPath, "bench/shaders/sprite", 3000, AZ::Vector4::CreateOne(), serializeContext)
+            && WriteCube(root)
+            && WriteSphere(root + k_lodMeshPaths[0], 32)
+            && WriteSphere(root + k_lodMeshPaths[1], 12)
+            && WriteSphere(root + k_lodMeshPaths[2], 4)
+            && WriteAtlas(root, serializeContext);
+
+        for (AZ::u32 i = 0; succeeded && i < materialCount; ++i)
+        {
+            const float shade = float(i + 1) / float(materialCount);
+            succeeded = WriteMaterial(root, GetMaterialPath(i), "bench/shaders/lit", 2000, AZ::Vector4(shade, 1.0f - shade, 0.5f, 1.0f), serializeContext);
+        }
+        return succeeded;
+    }
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <AzCore/Component/Entity.h>
+#include <AzCore/Serialization/SerializeContext.h>
+#include <AzCore/std/containers/vector.h>
+#include <AzCore/std/functional.h>
+#include <AzCore/std/string/string.h>
+
+namespace SceneBenchmark
+{
+    // asset paths relative to the asset root, written by WriteAssets
+    extern const char* k_meshPath;
+    extern const char* k_atlasPath;
+    extern const char* k_spriteMaterialPath;
+
+    // spheres from the finest to the coarsest
+    const AZ::u32 k_lodCount = 3;
+    extern const char* k_lodMeshPaths[k_lodCount];
+
+    AZStd::string GetMaterialPath(AZ::u32 index);
+    AZStd::string GetSpriteName(AZ::u32 index);
+
+    const AZ::u32 k_spriteCount = 16;
+
+    // writes shader binaries the noop renderer accepts, the shader configs, the materials, a cube mesh, the sphere
+    // levels of detail and a sprite atlas below the asset root
+    bool WriteAssets(const AZStd::string& root, AZ::SerializeContext* serializeContext, AZ::u32 materialCount);
+
+    struct SceneOptions
+    {
+        AZ::u32 m_count         = 2000; // renderers in the scene
+        AZ::u32 m_materialCount = 16;
+    };
+
+    // the entities of one scene, all of them activated, and what changes between two frames
+    struct Scene
+    {
+        ~Scene();
+
+        AZStd::vector<AZ::Entity*>      m_entities;
+        AZStd::function<void(AZ::u32)>  m_update;
+    };
+
+    void CreateMeshScene(Scene& scene, const SceneOptions& options);
+    void CreateSpriteScene(Scene& scene, const SceneOptions& options);
+    void CreateMovingSpriteScene(Scene& scene, const SceneOptions& options);
+    void CreateLodScene(Scene& scene, const SceneOptions& options);
+    void CreateMultiCameraScene(Scene& scene, const SceneOptions& options);
+    void CreateOccluderScene(Scene& scene, const SceneOptions& options);
+}
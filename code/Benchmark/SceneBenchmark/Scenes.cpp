@@ -0,0 +1,287 @@
+#include "SceneBenchmark.h"
+
+#include "Renderer/Component/CameraComponent.h"
+#include "Renderer/Component/LodGroupComponent.h"
+#include "Renderer/Component/MeshFilterComponent.h"
+#include "Renderer/Component/MeshRendererComponent.h"
+#include "Renderer/Component/SpriteRendererComponent.h"
+#include "Renderer/EBus/CameraComponentBus.h"
+#include "Renderer/EBus/RendererComponentBus.h"
+#include "Renderer/EBus/RendererSystemComponentBus.h"
+#include "Renderer/EBus/SpriteRendererComponentBus.h"
+
+#include <AzCore/Component/ComponentApplicationBus.h>
+#include <AzCore/Component/TransformBus.h>
+#include <AzCore/Component/TransformComponent.h>
+#include <AzCore/Math/MathUtils.h>
+
+#include <math.h>
+
+namespace SceneBenchmark
+{
+    namespace
+    {
+        // fills a field of a component the way a level load does, for components that only read it on activation
+        template <typename ValueType>
+        void SetSerializedField(AZ::Component* component, const char* fieldName, const ValueType& value)
+        {
+            AZ::SerializeContext* serializeContext = nullptr;
+            EBUS_EVENT_RESULT(serializeContext, AZ::ComponentApplicationBus, GetSerializeContext);
+
+            const auto classData = serializeContext->FindClassData(azrtti_typeid(component));
+            for (const auto& element : classData->m_elements)
+            {
+                if (strcmp(element.m_name, fieldName) == 0 && element.m_typeId == azrtti_typeid<ValueType>())
+                {
+                    *reinterpret_cast<ValueType*>(reinterpret_cast<char*>(component) + element.m_offset) = value;
+                    return;
+                }
+            }
+            AZ_Assert(false, "%s has no field %s\n", classData->m_name, fieldName);
+        }
+
+        AZ::Entity* Activate(Scene& scene, AZ::Entity* entity, const AZ::Transform& transform)
+        {
+            entity->Init();
+            entity->Activate();
+            EBUS_EVENT_ID(entity->GetId(), AZ::TransformBus, SetWorldTM, transform);
+            scene.m_entities.push_back(entity);
+            return entity;
+        }
+
+        AZ::EntityId CreateCamera(Scene& scene, const AZ::Vector3& position, bool isOrthographic)
+        {
+            auto entity = aznew AZ::Entity("Camera");
+            entity->CreateComponent<AZ::TransformComponent>();
+            entity->CreateComponent<Module::CameraComponent>();
+
+            // looks down +z, where the scenes are laid out
+            Activate(scene, entity, AZ::Transform::CreateTranslation(position));
+
+            const AZ::EntityId id = entity->GetId();
+            EBUS_EVENT_ID(id, Module::CameraRequestBus, SetClearFlags, Module::CameraClearFlags::SolidColor);
+            EBUS_EVENT_ID(id, Module::CameraRequestBus, SetOrthographic, isOrthographic);
+            EBUS_EVENT_ID(id, Module::CameraRequestBus, SetOrthographicSize, 10.0f);
+            return id;
+        }
+
+        AZ::u32 GetGridColumns(AZ::u32 count)
+        {
+            return static_cast<AZ::u32>(ceilf(sqrtf(float(count))));
+        }
+
+        // a square grid in the xy plane centered on the origin
+        AZ::Vector3 GetGridPosition(AZ::u32 index, AZ::u32 count, float spacing)
+        {
+            const AZ::u32 columns = GetGridColumns(count);
+            const float extent = float(columns - 1) * spacing * 0.5f;
+            return AZ::Vector3(float(index % columns) * spacing - extent, float(index / columns) * spacing - extent, 0.0f);
+        }
+
+        Module::MaterialPtr GetMaterial(const AZStd::string& path)
+        {
+            Module::MaterialPtr material;
+            EBUS_EVENT_RESULT(material, Module::RendererSystemRequestBus, GetMaterial, path);
+            return material;
+        }
+
+        void SetMaterial(AZ::Entity* entity, const Module::MaterialPtr& material)
+        {
+            EBUS_EVENT_ID(entity->GetId(), Module::RendererRequestBus, SetMaterialCount, 1);
+            EBUS_EVENT_ID(entity->GetId(), Module::RendererRequestBus, SetMaterial, 0, material);
+        }
+
+        // a grid of cubes in the xy plane, cycling through the materials
+        void CreateMeshes(Scene& scene, const SceneOptions& options, float spacing)
+        {
+            AZStd::vector<Module::MaterialPtr> materials;
+            for (AZ::u32 i = 0; i < options.m_materialCount; ++i)
+            {
+                materials.push_back(GetMaterial(GetMaterialPath(i)));
+            }
+
+            for (AZ::u32 i = 0; i < options.m_count; ++i)
+            {
+                auto entity = aznew AZ::Entity("Mesh");
+                entity->CreateComponent<AZ::TransformComponent>();
+                SetSerializedField(entity->CreateComponent<Module::MeshFilterComponent>(), "Name", AZStd::string(k_meshPath));
+                entity->CreateComponent<Module::MeshRendererComponent>();
+
+                auto transform = AZ::Transform::CreateRotationY(float(i) * 0.1f);
+                transform.SetPosition(GetGridPosition(i, options.m_count, spacing));
+                Activate(scene, entity, transform);
+                SetMaterial(entity, materials[i % materials.size()]);
+            }
+        }
+
+        // returns the orthographic camera looking at the sprites
+        AZ::EntityId CreateSprites(Scene& scene, const SceneOptions& options, AZStd::vector<AZ::EntityId>* ids)
+        {
+            const AZ::EntityId cameraId = CreateCamera(scene, AZ::Vector3(0.0f, 0.0f, -10.0f), true);
+
+            const auto material = GetMaterial(k_spriteMaterialPath);
+            for (AZ::u32 i = 0; i < options.m_count; ++i)
+            {
+                auto entity = aznew AZ::Entity("Sprite");
+                entity->CreateComponent<AZ::TransformComponent>();
+                entity->CreateComponent<Module::SpriteRendererComponent>();
+                Activate(scene, entity, AZ::Transform::CreateTranslation(GetGridPosition(i, options.m_count, 0.4f)));
+
+                Module::SpritePtr sprite;
+                EBUS_EVENT_RESULT(sprite, Module::RendererSystemRequestBus, GetSprite, k_atlasPath, GetSpriteName(i % k_spriteCount));
+                EBUS_EVENT_ID(entity->GetId(), Module::SpriteRendererRequestBus, SetSprite, sprite);
+                SetMaterial(entity, material);
+
+                if (ids)
+                {
+                    ids->push_back(entity->GetId());
+                }
+            }
+
+            return cameraId;
+        }
+    }
+
+    Scene::~Scene()
+    {
+        for (auto entity = m_entities.rbegin(); entity != m_entities.rend(); ++entity)
+        {
+            delete *entity;
+        }
+    }
+
+    void CreateMeshScene(Scene& scene, const SceneOptions& options)
+    {
+        // close enough for about a quarter of the grid to fall outside of the frustum
+        const float spacing = 2.0f;
+        CreateCamera(scene, AZ::Vector3(0.0f, 0.0f, -0.6f * spacing * float(GetGridColumns(options.m_count))), false);
+        CreateMeshes(scene, options, spacing);
+    }
+
+    // a game view, a minimap of the same meshes and a UI camera that only draws the sprites of the UI layer
+    void CreateMultiCameraScene(Scene& scene, const SceneOptions& options)
+    {
+        const AZ::u8 uiLayer = 5;
+        const float spacing = 2.0f;
+        const float extent = spacing * float(GetGridColumns(options.m_count));
+
+        const AZ::EntityId gameId = CreateCamera(scene, AZ::Vector3(0.0f, 0.0f, -0.6f * extent), false);
+        EBUS_EVENT_ID(gameId, Module::CameraRequestBus, SetCullingMask, ~(1u << uiLayer));
+
+        const AZ::EntityId minimapId = CreateCamera(scene, AZ::Vector3(0.0f, 0.0f, -10.0f), true);
+        EBUS_EVENT_ID(minimapId, Module::CameraRequestBus, SetOrthographicSize, extent * 0.5f);
+        EBUS_EVENT_ID(minimapId, Module::CameraRequestBus, SetRect, AZ::Vector4(0.75f, 0.0f, 0.25f, 0.25f));
+        EBUS_EVENT_ID(minimapId, Module::CameraRequestBus, SetDepth, 1);
+        EBUS_EVENT_ID(minimapId, Module::CameraRequestBus, SetCullingMask, ~(1u << uiLayer));
+
+        CreateMeshes(scene, options, spacing);
+
+        // a tenth as many widgets as meshes
+        SceneOptions uiOptions = options;
+        uiOptions.m_count = AZStd::GetMax(options.m_count / 10, 1u);
+        AZStd::vector<AZ::EntityId> widgets;
+        const AZ::EntityId uiId = CreateSprites(scene, uiOptions, &widgets);
+        EBUS_EVENT_ID(uiId, Module::CameraRequestBus, SetClearFlags, Module::CameraClearFlags::Depth);
+        EBUS_EVENT_ID(uiId, Module::CameraRequestBus, SetDepth, 2);
+        EBUS_EVENT_ID(uiId, Module::CameraRequestBus, SetCullingMask, 1u << uiLayer);
+        for (const auto& id : widgets)
+        {
+            EBUS_EVENT_ID(id, Module::RendererRequestBus, SetLayer, uiLayer);
+        }
+    }
+
+    // the mesh grid with a wall between the camera and the left half of it, the wall is the only occluder
+    void CreateOccluderScene(Scene& scene, const SceneOptions& options)
+    {
+        const float spacing = 2.0f;
+        const float extent = spacing * float(GetGridColumns(options.m_count));
+
+        const AZ::EntityId cameraId = CreateCamera(scene, AZ::Vector3(0.0f, 0.0f, -0.6f * extent), false);
+        EBUS_EVENT_ID(cameraId, Module::CameraRequestBus, SetOcclusionCulling, true);
+
+        CreateMeshes(scene, options, spacing);
+
+        // halfway to the grid, so it hides twice its width there
+        auto entity = aznew AZ::Entity("Wall");
+        entity->CreateComponent<AZ::TransformComponent>();
+        SetSerializedField(entity->CreateComponent<Module::MeshFilterComponent>(), "Name", AZStd::string(k_meshPath));
+        entity->CreateComponent<Module::MeshRendererComponent>();
+
+        auto transform = AZ::Transform::CreateScale(AZ::Vector3(0.3f * extent, 0.4f * extent, 1.0f));
+        transform.SetPosition(AZ::Vector3(-0.15f * extent, 0.0f, -0.3f * extent));
+        Activate(scene, entity, transform);
+        SetMaterial(entity, GetMaterial(GetMaterialPath(0)));
+        EBUS_EVENT_ID(entity->GetId(), Module::RendererRequestBus, SetOccluder, true);
+    }
+
+    void CreateSpriteScene(Scene& scene, const SceneOptions& options)
+    {
+        CreateSprites(scene, options, nullptr);
+    }
+
+    // vegetation seen from the ground, a grid stretching away from a camera that moves back and forth through it
+    void CreateLodScene(Scene& scene, const SceneOptions& options)
+    {
+        const float spacing = 2.0f;
+        const AZ::u32 columns = GetGridColumns(options.m_count);
+        CreateCamera(scene, AZ::Vector3(0.0f, 1.0f, -spacing), false);
+        const AZ::EntityId cameraId = scene.m_entities.back()->GetId();
+
+        AZStd::vector<Module::MaterialPtr> materials;
+        for (AZ::u32 i = 0; i < options.m_materialCount; ++i)
+        {
+            materials.push_back(GetMaterial(GetMaterialPath(i)));
+        }
+
+        // the finest level is the mesh of the filter, the coarsest one ends where a sphere covers 2% of the screen
+        AZStd::vector<Module::LodLevel> levels(k_lodCount);
+        const float screenHeights[k_lodCount] = { 0.3f, 0.1f, 0.02f };
+        for (AZ::u32 level = 0; level < k_lodCount; ++level)
+        {
+            levels[level].m_mesh = level > 0 ? k_lodMeshPaths[level] : "";
+            levels[level].m_screenHeight = screenHeights[level];
+        }
+
+        for (AZ::u32 i = 0; i < options.m_count; ++i)
+        {
+            auto entity = aznew AZ::Entity("Lod");
+            entity->CreateComponent<AZ::TransformComponent>();
+            SetSerializedField(entity->CreateComponent<Module::MeshFilterComponent>(), "Name", AZStd::string(k_lodMeshPaths[0]));
+            auto lodGroup = entity->CreateComponent<Module::LodGroupComponent>();
+            SetSerializedField(lodGroup, "Levels", levels);
+            SetSerializedField(lodGroup, "CrossFadeTime", 0.25f);
+            entity->CreateComponent<Module::MeshRendererComponent>();
+
+            const float x = (float(i % columns) - float(columns - 1) * 0.5f) * spacing;
+            const float z = float(i / columns) * spacing;
+            Activate(scene, entity, AZ::Transform::CreateTranslation(AZ::Vector3(x, 0.0f, z)));
+            SetMaterial(entity, materials[i % materials.size()]);
+        }
+
+        // renderers close to a threshold keep changing their level
+        const float depth = float(columns) * spacing;
+        scene.m_update = [cameraId, depth](AZ::u32 frame)
+        {
+            const float z = (0.25f - 0.25f * cosf(float(frame) * 0.02f)) * depth - 2.0f;
+            EBUS_EVENT_ID(cameraId, AZ::TransformBus, SetWorldTM, AZ::Transform::CreateTranslation(AZ::Vector3(0.0f, 1.0f, z)));
+        };
+    }
+
+    // stands in for particles, every sprite moves every frame
+    void CreateMovingSpriteScene(Scene& scene, const SceneOptions& options)
+    {
+        auto ids = AZStd::make_shared<AZStd::vector<AZ::EntityId>>();
+        CreateSprites(scene, options, ids.get());
+
+        const AZ::u32 count = options.m_count;
+        scene.m_update = [ids, count](AZ::u32 frame)
+        {
+            for (AZ::u32 i = 0; i < ids->size(); ++i)
+            {
+                const float phase = float(frame) * 0.05f + float(i) * 0.37f;
+                const AZ::Vector3 offset(0.3f * cosf(phase), 0.3f * sinf(phase), 0.0f);
+                EBUS_EVENT_ID((*ids)[i], AZ::TransformBus, SetWorldTM, AZ::Transform::CreateTranslation(GetGridPosition(i, count, 0.4f) + offset));
+            }
+        };
+    }
+}
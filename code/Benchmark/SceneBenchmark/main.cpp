@@ -0,0 +1,412 @@
+#include "SceneBenchmark.h"
+
+#include "Renderer/Base/FrameProfiler.h"
+#include "Renderer/Base/RenderThread.h"
+#include "Renderer/Component/RendererSystemComponent.h"
+#include "Renderer/EBus/RendererSystemComponentBus.h"
+#include "Window/EBus/WindowSystemComponentBus.h"
+
+#include <AzCore/Application/Application.h>
+#include <AzCore/Asset/AssetManager.h>
+#include <AzCore/IO/FileIO.h>
+#include <AzCore/Module/Module.h>
+#include <AzCore/Script/ScriptSystemComponent.h>
+#include <AzCore/std/algorithm.h>
+#include <AzCore/std/sort.h>
+
+#include <bgfx/platform.h>
+#include <bx/timer.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Boots the engine without a window on the noop renderer of bgfx and times whole frames of synthetic scenes. Every
+// frame runs the update, cull, sort and submission of RendererSystemComponent::OnSystemTick, bgfx::frame included.
+//
+//   SceneBenchmark [scene...] [--count N] [--materials M] [--frames F] [--json path]
+//                  [--render-thread bgfx|launcher|none] [--frames-in-flight 0|1]
+//
+// Scenes are "meshes", "sprites", "movingsprites", "lods", "multicamera" and "occluders", all of them run when none is named. bgfx renders on a
+// thread of its own by default, "launcher" renders on a RenderThread and "none" on the thread ticking the frames.
+
+extern "C" AZ::Module* CreateModuleClass_RendererModule();
+
+namespace SceneBenchmark
+{
+    namespace
+    {
+        // provides the window service the renderer requires, without a native window
+        class HeadlessWindowComponent
+            : public AZ::Component
+            , protected Module::WindowSystemRequestBus::Handler
+        {
+        public:
+            AZ_COMPONENT(HeadlessWindowComponent, "{6E2B7C41-0F3A-4D58-9B1E-8A4C2D7F5E93}");
+
+            static void GetProvidedServices(AZ::ComponentDescriptor::DependencyArrayType& provided)
+            {
+                provided.push_back(AZ_CRC("WindowSystemService"));
+            }
+
+            static void Reflect(AZ::ReflectContext* context)
+            {
+                if (auto serializeContext = azrtti_cast<AZ::SerializeContext*>(context))
+                {
+                    serializeContext->Class<HeadlessWindowComponent, AZ::Component>();
+                }
+            }
+
+        protected:
+            void Activate() override   { Module::WindowSystemRequestBus::Handler::BusConnect(); }
+            void Deactivate() override { Module::WindowSystemRequestBus::Handler::BusDisconnect(); }
+
+            void* GetNativeWindowHandle() override { return nullptr; }
+            void  GetWindowSize(int& width, int& height) override { width = 1280; height = 720; }
+            void  SetWindowSize(int width, int height) override {}
+        };
+
+        class BenchmarkApplication : public AZ::Application
+        {
+        protected:
+            void RegisterCoreComponents() override
+            {
+                AZ::Application::RegisterCoreComponents();
+                RegisterComponentDescriptor(HeadlessWindowComponent::CreateDescriptor());
+            }
+
+            // without scripts, the script system would wait for a lua file list the asset root does not have
+            AZ::ComponentTypeList GetRequiredSystemComponents() const override
+            {
+                AZ::ComponentTypeList components = AZ::Application::GetRequiredSystemComponents();
+                components.erase(AZStd::remove(components.begin(), components.end(), azrtti_typeid<AZ::ScriptSystemComponent>()), components.end());
+                components.push_back(azrtti_typeid<HeadlessWindowComponent>());
+                return components;
+            }
+
+            // the renderer joins the system entity here instead of in the module entity, which is activated too late to
+            // pick the backend
+            void StartCommon(AZ::Entity* systemEntity) override
+            {
+                auto renderer = systemEntity->FindComponent<Module::RendererSystemComponent>();
+                if (!renderer)
+                {
+                    renderer = systemEntity->CreateComponent<Module::RendererSystemComponent>();
+                }
+                renderer->SetRendererType(bgfx::RendererType::Noop);
+
+                AZ::Application::StartCommon(systemEntity);
+            }
+        };
+
+        void CreateStaticModules(AZStd::vector<AZ::Module*>& modules)
+        {
+            modules.push_back(CreateModuleClass_RendererModule());
+        }
+
+        struct Options
+        {
+            SceneOptions                 m_scene;
+            AZ::u32                      m_frameCount = 500;
+            AZStd::vector<AZStd::string> m_sceneNames;
+            AZStd::string                m_jsonPath;
+            AZ::u32                      m_framesInFlight = 1;
+        };
+
+        enum class RenderThreadMode
+        {
+            Bgfx,
+            Launcher,
+            None,
+        };
+
+        const char* const k_renderThreadModes[] = { "bgfx", "launcher", "none" };
+
+        // the render thread is picked before the application starts, nothing of AZStd can be used yet
+        bool ParseRenderThreadMode(int argc, char* argv[], RenderThreadMode& mode)
+        {
+            mode = RenderThreadMode::Bgfx;
+            for (int i = 1; i + 1 < argc; ++i)
+            {
+                if (strcmp(argv[i], "--render-thread") == 0)
+                {
+                    for (int m = 0; m < 3; ++m)
+                    {
+                        if (strcmp(argv[i + 1], k_renderThreadModes[m]) == 0)
+                        {
+                            mode = static_cast<RenderThreadMode>(m);
+                            return true;
+                        }
+                    }
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        struct SceneEntry
+        {
+            const char* m_name;
+            void (*m_create)(Scene&, const SceneOptions&);
+        };
+
+        const SceneEntry k_scenes[] =
+        {
+            { "meshes",        &CreateMeshScene },
+            { "sprites",       &CreateSpriteScene },
+            { "movingsprites", &CreateMovingSpriteScene },
+            { "lods",          &CreateLodScene },
+            { "multicamera",   &CreateMultiCameraScene },
+            { "occluders",     &CreateOccluderScene },
+        };
+
+        bool ParseOptions(int argc, char* argv[], Options& options)
+        {
+            for (int i = 1; i < argc; ++i)
+            {
+                const bool hasValue = i + 1 < argc;
+                if (strcmp(argv[i], "--count") == 0 && hasValue)
+                {
+                    options.m_scene.m_count = static_cast<AZ::u32>(atoi(argv[++i]));
+                }
+                else if (strcmp(argv[i], "--materials") == 0 && hasValue)
+                {
+                    options.m_scene.m_materialCount = AZStd::GetMax(1, atoi(argv[++i]));
+                }
+                else if (strcmp(argv[i], "--frames") == 0 && hasValue)
+                {
+                    options.m_frameCount = AZStd::GetMax(1, atoi(argv[++i]));
+                }
+                else if (strcmp(argv[i], "--json") == 0 && hasValue)
+                {
+                    options.m_jsonPath = argv[++i];
+                }
+                else if (strcmp(argv[i], "--render-thread") == 0 && hasValue)
+                {
+                    ++i; // read by ParseRenderThreadMode
+                }
+                else if (strcmp(argv[i], "--frames-in-flight") == 0 && hasValue)
+                {
+                    options.m_framesInFlight = static_cast<AZ::u32>(atoi(argv[++i]));
+                }
+                else if (argv[i][0] != '-')
+                {
+                    options.m_sceneNames.push_back(argv[i]);
+                }
+                else
+                {
+                    printf("usage: SceneBenchmark [scene...] [--count N] [--materials M] [--frames F] [--json path]\n"
+                           "                      [--render-thread bgfx|launcher|none] [--frames-in-flight 0|1]\n");
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        // loads the assets of the scene, until the node count of a frame stops changing. The profiler keeps only the
+        // latest frame meanwhile.
+        void WarmUp(BenchmarkApplication& application)
+        {
+            AZ::u32 nodeCount = 0;
+            AZ::u32 stableFrames = 0;
+            for (AZ::u32 frame = 0; frame < 1000 && stableFrames < 10; ++frame)
+            {
+                AZ::Data::AssetManager::Instance().DispatchEvents();
+                application.TickSystem();
+
+                Module::FrameStats stats;
+                EBUS_EVENT_RESULT(stats, Module::RendererSystemRequestBus, GetProfiledFrame, 0);
+
+                AZ::u32 frameNodeCount = 0;
+                for (const auto& camera : stats.m_cameras)
+                {
+                    frameNodeCount += camera.m_nodeCount;
+                }
+                stableFrames = frameNodeCount > 0 && frameNodeCount == nodeCount ? stableFrames + 1 : 0;
+                nodeCount = frameNodeCount;
+            }
+        }
+
+        double Percentile(const AZStd::vector<double>& sorted, double percentile)
+        {
+            const size_t index = static_cast<size_t>(percentile * double(sorted.size() - 1) + 0.5);
+            return sorted[AZStd::GetMin(index, sorted.size() - 1)];
+        }
+
+        void RunScene(BenchmarkApplication& application, const SceneEntry& entry, const Options& options)
+        {
+            Scene scene;
+            entry.m_create(scene, options.m_scene);
+
+            EBUS_EVENT(Module::RendererSystemRequestBus, SetFrameProfilerCapacity, 1);
+            WarmUp(application);
+            EBUS_EVENT(Module::RendererSystemRequestBus, SetFrameProfilerCapacity, options.m_frameCount);
+
+            AZStd::vector<double> samples;
+            samples.reserve(options.m_frameCount);
+
+            const double toMs = 1000.0 / double(bx::getHPFrequency());
+            for (AZ::u32 frame = 0; frame < options.m_frameCount; ++frame)
+            {
+                if (scene.m_update)
+                {
+                    scene.m_update(frame);
+                }
+
+                const int64_t start = bx::getHPCounter();
+                application.TickSystem();
+                samples.push_back(double(bx::getHPCounter() - start) * toMs);
+            }
+
+            AZStd::sort(samples.begin(), samples.end());
+
+            // averages of the per camera phases over the recorded frames
+            AZ::u32 frameCount = 0;
+            EBUS_EVENT_RESULT(frameCount, Module::RendererSystemRequestBus, GetProfiledFrameCount);
+
+            double updateMs = 0.0, cullMs = 0.0, occlusionMs = 0.0, gatherMs = 0.0, sortMs = 0.0, submitMs = 0.0;
+            double renderMs = 0.0, waitRenderMs = 0.0, overlapMs = 0.0;
+            AZ::u32 nodeCount = 0, stateChanges = 0, triangleCount = 0;
+            AZ::u32 visibleCount = 0, culledCount = 0, occludedCount = 0;
+            AZ::u32 spriteBatchCount = 0, droppedSpriteCount = 0;
+            for (AZ::u32 i = 0; i < frameCount; ++i)
+            {
+                Module::FrameStats stats;
+                EBUS_EVENT_RESULT(stats, Module::RendererSystemRequestBus, GetProfiledFrame, i);
+
+                updateMs += stats.m_updateMs;
+                renderMs += stats.m_renderCpuMs;
+                waitRenderMs += stats.m_waitRenderMs;
+                overlapMs += stats.m_overlapMs;
+                nodeCount = 0;
+                stateChanges = 0;
+                triangleCount = 0;
+                visibleCount = 0;
+                culledCount = 0;
+                occludedCount = 0;
+                spriteBatchCount = 0;
+                for (const auto& camera : stats.m_cameras)
+                {
+                    cullMs += camera.m_cullMs;
+                    occlusionMs += camera.m_occlusionMs;
+                    gatherMs += camera.m_gatherMs;
+                    sortMs += camera.m_sortMs;
+                    submitMs += camera.m_submitMs;
+                    nodeCount += camera.m_nodeCount;
+                    stateChanges += camera.m_stateChanges;
+                    triangleCount += camera.m_triangleCount;
+                    visibleCount += camera.m_visibleCount;
+                    culledCount += camera.m_culledCount;
+                    occludedCount += camera.m_occludedCount;
+                    spriteBatchCount += camera.m_spriteBatchCount;
+                    droppedSpriteCount += camera.m_droppedSpriteCount;
+                }
+            }
+            const double frames = double(AZStd::GetMax(frameCount, 1u));
+
+            // the noop renderer counts no draws, the state changes of the submission stand in for them
+            printf("%-14s %6u renderers  %5u nodes  %5u state changes  %7u triangles\n", entry.m_name, options.m_scene.m_count, nodeCount,
+                   stateChanges, triangleCount);
+            printf("    frame   p50 %7.3f ms  p90 %7.3f ms  p99 %7.3f ms  max %7.3f ms\n",
+                   Percentile(samples, 0.5), Percentile(samples, 0.9), Percentile(samples, 0.99), samples.back());
+            printf("    bounds  %6u visible  %6u culled  %6u occluded\n", visibleCount, culledCount, occludedCount);
+            printf("    phases  update %7.3f  cull %7.3f  occlusion %7.3f  gather %7.3f  sort %7.3f  submit %7.3f ms\n",
+                   updateMs / frames, cullMs / frames, occlusionMs / frames, gatherMs / frames, sortMs / frames, submitMs / frames);
+            printf("    render  %7.3f  waited for %7.3f  overlapped %7.3f ms\n", renderMs / frames, waitRenderMs / frames, overlapMs / frames);
+            if (spriteBatchCount > 0 || droppedSpriteCount > 0)
+            {
+                // the drops are summed over all recorded frames, any of them means the numbers above draw less
+                printf("    sprites %6u batches per frame  %6u dropped in %u frames\n", spriteBatchCount, droppedSpriteCount, frameCount);
+            }
+
+            if (!options.m_jsonPath.empty())
+            {
+                const AZStd::string path = options.m_jsonPath + "." + entry.m_name + ".json";
+                bool written = false;
+                EBUS_EVENT_RESULT(written, Module::RendererSystemRequestBus, DumpFrameProfile, path);
+                printf("    %s %s\n", written ? "profile written to" : "can not write", path.c_str());
+            }
+        }
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    using namespace SceneBenchmark;
+
+    char rootTemplate[] = "/tmp/scene_benchmark_XXXXXX";
+    if (!mkdtemp(rootTemplate))
+    {
+        printf("can not create a temporary asset root\n");
+        return 1;
+    }
+    strcat(rootTemplate, "/");
+
+    // an empty engine config keeps the engine, asset and cdn roots at the app root
+    char configPath[sizeof(rootTemplate) + 16];
+    snprintf(configPath, sizeof(configPath), "%sgame.cfg", rootTemplate);
+    if (FILE* config = fopen(configPath, "w"))
+    {
+        fputs("{}", config);
+        fclose(config);
+    }
+
+    RenderThreadMode renderThreadMode;
+    if (!ParseRenderThreadMode(argc, argv, renderThreadMode))
+    {
+        printf("the render thread is one of bgfx, launcher or none\n");
+        return 1;
+    }
+
+    // bgfx picks its threading on init, from whether a thread called renderFrame before
+    Module::RenderThread renderThread;
+    if (renderThreadMode == RenderThreadMode::Launcher)
+    {
+        renderThread.Start();
+    }
+    else if (renderThreadMode == RenderThreadMode::None)
+    {
+        bgfx::renderFrame();
+    }
+
+    // the application creates the allocators, nothing of AZStd can be used before it started
+    BenchmarkApplication application;
+
+    AZ::ComponentApplication::Descriptor descriptor;
+    descriptor.m_allocationRecords = false;
+
+    AZ::Application::StartupParameters parameters;
+    parameters.m_appRootOverride = rootTemplate;
+    parameters.m_createStaticModulesCallback = &CreateStaticModules;
+    parameters.m_loadDynamicModules = false;
+    application.Start(descriptor, parameters);
+
+    int result = 1;
+    {
+        const AZStd::string root = rootTemplate;
+
+        Options options;
+        if (ParseOptions(argc, argv, options) && WriteAssets(root, application.GetSerializeContext(), options.m_scene.m_materialCount))
+        {
+            EBUS_EVENT(Module::RendererSystemRequestBus, SetMaxFramesInFlight, options.m_framesInFlight);
+            printf("bgfx noop renderer, %u frames per scene, render thread %s, %u frames in flight\n", options.m_frameCount,
+                   k_renderThreadModes[static_cast<int>(renderThreadMode)], AZStd::GetMin(options.m_framesInFlight, 1u));
+            for (const auto& entry : k_scenes)
+            {
+                const bool selected = options.m_sceneNames.empty()
+                    || AZStd::find(options.m_sceneNames.begin(), options.m_sceneNames.end(), entry.m_name) != options.m_sceneNames.end();
+                if (selected)
+                {
+                    RunScene(application, entry, options);
+                }
+            }
+            result = 0;
+        }
+
+        AZ::IO::FileIOBase::GetInstance()->DestroyPath(root.c_str());
+    }
+
+    application.Stop();
+    renderThread.Stop();
+    return result;
+}
@@ -3,6 +3,10 @@
 #include <AzCore/Application/Application.h>
 #include <AzCore/Module/Module.h>
 
+#include "Renderer/Base/RenderThread.h"
+
+#include <string.h>
+
 AZ::Application* gApp = nullptr;
 
 extern void CreateStaticModules(AZStd::vector<AZ::Module*>& modules);
@@ -25,9 +29,21 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine
     params.m_appRootOverride = pathToAssets;
     params.m_loadDynamicModules = false;
 
+    // --render-thread renders on a thread of the launcher, the main thread then only ticks the game
+    Module::RenderThread renderThread;
+    for (int i = 1; i < __argc; ++i)
+    {
+        if (strcmp(__argv[i], "--render-thread") == 0)
+        {
+            renderThread.Start();
+        }
+    }
+
     application.Start(pathToDescriptor, params);
     application.RunMainLoop();
     application.Stop();
 
+    renderThread.Stop();
+
     return 0;
 }
@@ -46,8 +46,3 @@ namespace Module
         }
     }
 }
-
-namespace AZ
-{
-    AZ_TYPE_INFO_SPECIALIZE(Module::MaterialAsset::Property, "{35E1151E-9F7C-4390-AAF8-59ECDAAABD24}");
-}
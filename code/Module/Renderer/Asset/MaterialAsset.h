@@ -33,6 +33,11 @@ namespace Module
 
         static void Reflect(AZ::ReflectContext* context);
 
+        void SetName(const AZStd::string& name)     { m_name = name; }
+        void SetShader(const AZStd::string& shader) { m_shader = shader; }
+        void SetQueue(AZ::s32 queue)                { m_queue = queue; }
+        void AddProperty(const Property& property)  { m_properties.push_back(property); }
+
     private:
         AZStd::string           m_name;
         AZStd::string           m_shader;
@@ -44,3 +49,9 @@ namespace Module
 
     using MaterialAssetHandler = AZ::GenericAssetHandler<MaterialAsset>;
 }
+
+namespace AZ
+{
+    // shader assets store their default properties in the same layout
+    AZ_TYPE_INFO_SPECIALIZE(::Module::MaterialAsset::Property, "{35E1151E-9F7C-4390-AAF8-59ECDAAABD24}");
+}
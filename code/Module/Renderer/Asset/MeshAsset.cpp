@@ -1,20 +1,95 @@
 #include "Renderer/Asset/MeshAsset.h"
+#include "Renderer/Asset/MeshFormat.h"
 
 #include <AzCore/Serialization/SerializeContext.h>
 #include <AzCore/RTTI/BehaviorContext.h>
+#include <AzCore/std/sort.h>
 
 namespace Module
 {
+    namespace
+    {
+        const size_t k_maxIndex16VertexCount = 0x10000;
+
+        template <typename IndexType>
+        AZ::u32 GetMaxIndex(const char* indices, AZ::u32 indexCount)
+        {
+            const IndexType* typed = reinterpret_cast<const IndexType*>(indices);
+            AZ::u32 result = 0;
+            for (AZ::u32 i = 0; i < indexCount; ++i)
+            {
+                result = AZStd::GetMax(result, AZ::u32(typed[i]));
+            }
+            return result;
+        }
+
+        // version 0 stored 16 bit indices
+        bool ConvertSubMesh(AZ::SerializeContext& context, AZ::SerializeContext::DataElementNode& classElement)
+        {
+            if (classElement.GetVersion() < 1)
+            {
+                for (const char* name : { "firstIndex", "indexCount" })
+                {
+                    const int index = classElement.FindElement(AZ_CRC(name));
+                    AZ::u16 value = 0;
+                    if (index < 0 || !classElement.GetSubElement(index).GetData(value))
+                    {
+                        return false;
+                    }
+                    classElement.RemoveElement(index);
+                    classElement.AddElementWithData(context, name, AZ::u32(value));
+                }
+            }
+            return true;
+        }
+
+        bool ConvertMeshAsset(AZ::SerializeContext& context, AZ::SerializeContext::DataElementNode& classElement)
+        {
+            if (classElement.GetVersion() < 1)
+            {
+                const int index = classElement.FindElement(AZ_CRC("indices"));
+                if (index >= 0)
+                {
+                    AZStd::vector<AZ::u16> indices;
+                    if (!classElement.GetSubElement(index).GetDataHierarchy(context, indices))
+                    {
+                        return false;
+                    }
+                    AZStd::vector<AZ::u32> widened;
+                    widened.reserve(indices.size());
+                    for (const AZ::u16 value : indices)
+                    {
+                        widened.push_back(value);
+                    }
+                    classElement.RemoveElement(index);
+                    classElement.AddElementWithData(context, "indices", widened);
+                }
+            }
+            return true;
+        }
+    }
+
     void MeshAsset::Reflect(AZ::ReflectContext* context)
     {
         if (auto serializeContext = azrtti_cast<AZ::SerializeContext*>(context))
         {
             serializeContext->Class<SubMesh>()
+                ->Version(1, &ConvertSubMesh)
                 ->Field("firstIndex", &SubMesh::m_firstIndex)
                 ->Field("indexCount", &SubMesh::m_indexCount)
                 ;
 
+            serializeContext->Class<VertexFormat>()
+                ->Field("position", &VertexFormat::m_position)
+                ->Field("normal", &VertexFormat::m_normal)
+                ->Field("tangent", &VertexFormat::m_tangent)
+                ->Field("color", &VertexFormat::m_color)
+                ->Field("texcoord0", &VertexFormat::m_texcoord0)
+                ->Field("texcoord1", &VertexFormat::m_texcoord1)
+                ;
+
             serializeContext->Class<MeshAsset>()
+                ->Version(1, &ConvertMeshAsset)
                 ->Field("name", &MeshAsset::m_name)
                 ->Field("position", &MeshAsset::m_position)
                 ->Field("normal", &MeshAsset::m_normal)
@@ -25,6 +100,7 @@ namespace Module
                 ->Field("indices", &MeshAsset::m_indices)
                 ->Field("subMeshes", &MeshAsset::m_subMeshes)
                 ->Field("bounds", &MeshAsset::m_aabb)
+                ->Field("vertexFormat", &MeshAsset::m_vertexFormat)
                 ;
         }
 
@@ -36,6 +112,37 @@ namespace Module
                 ->Property("indexCount", BehaviorValueProperty(&SubMesh::m_indexCount))
                 ;
 
+            behaviorContext->Class<PositionFormat>("PositionFormat")
+                ->Enum<static_cast<int>(PositionFormat::Float)>("Float")
+                ->Enum<static_cast<int>(PositionFormat::Int16)>("Int16")
+                ;
+
+            behaviorContext->Class<DirectionFormat>("DirectionFormat")
+                ->Enum<static_cast<int>(DirectionFormat::Float)>("Float")
+                ->Enum<static_cast<int>(DirectionFormat::Octahedral)>("Octahedral")
+                ;
+
+            behaviorContext->Class<TexcoordFormat>("TexcoordFormat")
+                ->Enum<static_cast<int>(TexcoordFormat::Float)>("Float")
+                ->Enum<static_cast<int>(TexcoordFormat::Half)>("Half")
+                ->Enum<static_cast<int>(TexcoordFormat::Int16)>("Int16")
+                ;
+
+            behaviorContext->Class<ColorFormat>("ColorFormat")
+                ->Enum<static_cast<int>(ColorFormat::Float)>("Float")
+                ->Enum<static_cast<int>(ColorFormat::Uint8)>("Uint8")
+                ;
+
+            behaviorContext->Class<VertexFormat>("VertexFormat")
+                ->Constructor()
+                ->Property("position", BehaviorValueProperty(&VertexFormat::m_position))
+                ->Property("normal", BehaviorValueProperty(&VertexFormat::m_normal))
+                ->Property("tangent", BehaviorValueProperty(&VertexFormat::m_tangent))
+                ->Property("color", BehaviorValueProperty(&VertexFormat::m_color))
+                ->Property("texcoord0", BehaviorValueProperty(&VertexFormat::m_texcoord0))
+                ->Property("texcoord1", BehaviorValueProperty(&VertexFormat::m_texcoord1))
+                ;
+
             behaviorContext->Class<MeshAsset>("MeshAsset")
                 ->Constructor()
                 ->Property("name", BehaviorValueProperty(&MeshAsset::m_name))
@@ -48,90 +155,360 @@ namespace Module
                 ->Property("indices", BehaviorValueProperty(&MeshAsset::m_indices))
                 ->Property("subMeshes", BehaviorValueProperty(&MeshAsset::m_subMeshes))
                 ->Property("bounds", BehaviorValueProperty(&MeshAsset::m_aabb))
+                ->Property("vertexFormat", BehaviorValueProperty(&MeshAsset::m_vertexFormat))
                 ;
         }
     }
 
-    bool MeshAssetHandler::LoadAssetData(const AZ::Data::Asset<AZ::Data::AssetData>& asset, AZ::IO::GenericStream* stream, const AZ::Data::AssetFilterCB& assetLoadFilterCB)
+    void MeshAsset::BuildVertexBuffer(bgfx::RendererType::Enum rendererType)
     {
-        if (AZ::GenericAssetHandler<MeshAsset>::LoadAssetData(asset, stream, assetLoadFilterCB))
+        const auto vertexCount = m_position.size();
+        AZ_Assert(vertexCount > 0, "Invalid mesh!\n");
+
+        const auto addTexcoord = [this](bgfx::Attrib::Enum attrib, TexcoordFormat format)
         {
-            auto* meshAsset = asset.GetAs<MeshAsset>();
-            auto& vertexDesc = meshAsset->m_vertexDesc;
-            auto& vertexBuffer = meshAsset->m_vertexBuffer;
-            auto& position = meshAsset->m_position;
-            auto& normal = meshAsset->m_normal;
-            auto& color = meshAsset->m_color;
-            auto& texcoord0 = meshAsset->m_texcoord0;
-            auto& texcoord1 = meshAsset->m_texcoord1;
-            auto& tangent = meshAsset->m_tangent;
+            switch (format)
+            {
+            case TexcoordFormat::Half:  m_vertexDesc.add(attrib, 2, bgfx::AttribType::Half); break;
+            case TexcoordFormat::Int16: m_vertexDesc.add(attrib, 2, bgfx::AttribType::Int16, true, true); break;
+            default:                    m_vertexDesc.add(attrib, 2, bgfx::AttribType::Float); break;
+            }
+        };
+
+        // 16 bit positions take 4 components, 3 of them are padded differently by the renderers
+        m_vertexDesc.begin(rendererType);
+        if (m_vertexFormat.m_position == PositionFormat::Int16)
+        {
+            m_vertexDesc.add(bgfx::Attrib::Position, 4, bgfx::AttribType::Int16, true, true);
+        }
+        else
+        {
+            m_vertexDesc.add(bgfx::Attrib::Position, 3, bgfx::AttribType::Float);
+        }
+        if (!m_normal.empty())
+        {
+            AZ_Assert(vertexCount <= m_normal.size(), "Invalid mesh, not enough normal data!\n");
+            if (m_vertexFormat.m_normal == DirectionFormat::Octahedral)
+            {
+                m_vertexDesc.add(bgfx::Attrib::Normal, 2, bgfx::AttribType::Int16, true, true);
+            }
+            else
+            {
+                m_vertexDesc.add(bgfx::Attrib::Normal, 3, bgfx::AttribType::Float);
+            }
+        }
+        if (!m_color.empty())
+        {
+            AZ_Assert(vertexCount <= m_color.size(), "Invalid mesh, not enough color data!\n");
+            if (m_vertexFormat.m_color == ColorFormat::Uint8)
+            {
+                m_vertexDesc.add(bgfx::Attrib::Color0, 4, bgfx::AttribType::Uint8, true);
+            }
+            else
+            {
+                m_vertexDesc.add(bgfx::Attrib::Color0, 4, bgfx::AttribType::Float);
+            }
+        }
+        if (!m_texcoord0.empty())
+        {
+            AZ_Assert(vertexCount <= m_texcoord0.size(), "Invalid mesh, not enough texcoord0 data!\n");
+            addTexcoord(bgfx::Attrib::TexCoord0, m_vertexFormat.m_texcoord0);
+        }
+        if (!m_texcoord1.empty())
+        {
+            AZ_Assert(vertexCount <= m_texcoord1.size(), "Invalid mesh, not enough texcoord1 data!\n");
+            addTexcoord(bgfx::Attrib::TexCoord1, m_vertexFormat.m_texcoord1);
+        }
+        if (!m_tangent.empty())
+        {
+            AZ_Assert(vertexCount <= m_tangent.size(), "Invalid mesh, not enough tangent data!\n");
+            if (m_vertexFormat.m_tangent == DirectionFormat::Octahedral)
+            {
+                m_vertexDesc.add(bgfx::Attrib::Tangent, 2, bgfx::AttribType::Int16, true, true);
+            }
+            else
+            {
+                m_vertexDesc.add(bgfx::Attrib::Tangent, 4, bgfx::AttribType::Float);
+            }
+        }
+        m_vertexDesc.end();
+
+        // positions are normalized within m_aabb, which grows to contain all of them
+        m_dequantization = QuantizeUtil::Dequantization();
+        if (QuantizeUtil::IsNormalizedInBounds(m_vertexDesc, bgfx::Attrib::Position))
+        {
+            for (size_t vertexIndex = 0; vertexIndex < vertexCount; ++vertexIndex)
+            {
+                m_aabb.AddPoint(m_position[vertexIndex]);
+            }
+            m_dequantization.SetPositionBounds(m_aabb);
+        }
+        const auto setTexcoordBounds = [this, vertexCount](AZ::u32 set, const AZStd::vector<AZ::Vector2>& texcoords)
+        {
+            AZ::Vector2 min = texcoords[0];
+            AZ::Vector2 max = texcoords[0];
+            for (size_t vertexIndex = 1; vertexIndex < vertexCount; ++vertexIndex)
+            {
+                min = min.GetMin(texcoords[vertexIndex]);
+                max = max.GetMax(texcoords[vertexIndex]);
+            }
+            m_dequantization.SetTexcoordBounds(set, min, max);
+        };
+        if (QuantizeUtil::IsNormalizedInBounds(m_vertexDesc, bgfx::Attrib::TexCoord0))
+        {
+            setTexcoordBounds(0, m_texcoord0);
+        }
+        if (QuantizeUtil::IsNormalizedInBounds(m_vertexDesc, bgfx::Attrib::TexCoord1))
+        {
+            setTexcoordBounds(1, m_texcoord1);
+        }
+
+        m_vertexBuffer.resize(m_vertexDesc.getSize(static_cast<uint32_t>(vertexCount)));
 
-            const auto vertexCount = position.size();
-            AZ_Assert(vertexCount > 0, "Invalid mesh!\n");
+        const auto stride = m_vertexDesc.getStride();
+        for (size_t vertexIndex = 0; vertexIndex < vertexCount; ++vertexIndex)
+        {
+            char* vertex = m_vertexBuffer.data() + stride * vertexIndex;
+            float value[4] = {};
 
-            vertexDesc.begin(bgfx::getRendererType());
-            if (!position.empty())
+            m_position[vertexIndex].StoreToFloat3(value);
+            QuantizeUtil::Pack(value, bgfx::Attrib::Position, m_vertexDesc, m_dequantization, vertex);
+            if (!m_normal.empty())
             {
-                AZ_Assert(vertexCount < position.size(), "Invalid mesh, not enough position data!\n");
-                vertexDesc.add(bgfx::Attrib::Position, 3, bgfx::AttribType::Float);
+                m_normal[vertexIndex].StoreToFloat3(value);
+                QuantizeUtil::Pack(value, bgfx::Attrib::Normal, m_vertexDesc, m_dequantization, vertex);
             }
-            if (!normal.empty())
+            if (!m_color.empty())
             {
-                AZ_Assert(vertexCount < normal.size(), "Invalid mesh, not enough normal data!\n");
-                vertexDesc.add(bgfx::Attrib::Normal, 3, bgfx::AttribType::Float);
+                m_color[vertexIndex].StoreToFloat4(value);
+                QuantizeUtil::Pack(value, bgfx::Attrib::Color0, m_vertexDesc, m_dequantization, vertex);
             }
-            if (!color.empty())
+            if (!m_texcoord0.empty())
             {
-                AZ_Assert(vertexCount < color.size(), "Invalid mesh, not enough color data!\n");
-                vertexDesc.add(bgfx::Attrib::Color0, 4, bgfx::AttribType::Float);
+                m_texcoord0[vertexIndex].StoreToFloat2(value);
+                QuantizeUtil::Pack(value, bgfx::Attrib::TexCoord0, m_vertexDesc, m_dequantization, vertex);
             }
-            if (!texcoord0.empty())
+            if (!m_texcoord1.empty())
             {
-                AZ_Assert(vertexCount < texcoord0.size(), "Invalid mesh, not enough texcoord0 data!\n");
-                vertexDesc.add(bgfx::Attrib::TexCoord0, 2, bgfx::AttribType::Float);
+                m_texcoord1[vertexIndex].StoreToFloat2(value);
+                QuantizeUtil::Pack(value, bgfx::Attrib::TexCoord1, m_vertexDesc, m_dequantization, vertex);
             }
-            if (!texcoord1.empty())
+            if (!m_tangent.empty())
             {
-                AZ_Assert(vertexCount < texcoord1.size(), "Invalid mesh, not enough texcoord1 data!\n");
-                vertexDesc.add(bgfx::Attrib::TexCoord1, 2, bgfx::AttribType::Float);
+                m_tangent[vertexIndex].StoreToFloat4(value);
+                QuantizeUtil::Pack(value, bgfx::Attrib::Tangent, m_vertexDesc, m_dequantization, vertex);
             }
-            if (!tangent.empty())
+        }
+
+        m_indexSize = vertexCount > k_maxIndex16VertexCount ? sizeof(AZ::u32) : sizeof(AZ::u16);
+        m_indexBuffer.resize(m_indices.size() * m_indexSize);
+        if (m_indexSize == sizeof(AZ::u32))
+        {
+            memcpy(m_indexBuffer.data(), m_indices.data(), m_indexBuffer.size());
+        }
+        else
+        {
+            auto* indices = reinterpret_cast<AZ::u16*>(m_indexBuffer.data());
+            for (size_t i = 0; i < m_indices.size(); ++i)
             {
-                AZ_Assert(vertexCount < tangent.size(), "Invalid mesh, not enough tangent data!\n");
-                vertexDesc.add(bgfx::Attrib::Tangent, 4, bgfx::AttribType::Float);
+                indices[i] = static_cast<AZ::u16>(m_indices[i]);
             }
-            vertexDesc.end();
+        }
+    }
 
-            vertexBuffer.resize(vertexDesc.getSize(position.size()));
+    bool MeshAsset::LoadBinary(const MappedFilePtr& file)
+    {
+        const char* data = file->GetData();
+        const size_t size = file->GetSize();
 
-            for (size_t vertexIndex = 0; vertexIndex < vertexCount; ++vertexIndex)
+        // version 1 headers end before the index size, the fields after it keep their defaults
+        MeshFormat::Header header;
+        if (size < MeshFormat::HeaderSizeV1)
+        {
+            AZ_Error("MeshAsset", false, "Binary mesh is truncated\n");
+            return false;
+        }
+        memcpy(&header, data, MeshFormat::HeaderSizeV1);
+        if (header.m_version == MeshFormat::Version && size >= sizeof(header))
+        {
+            memcpy(&header, data, sizeof(header));
+        }
+
+        if (header.m_magic != MeshFormat::Magic || (header.m_version != MeshFormat::Version && header.m_version != 1) || header.m_fileSize != size
+            || (header.m_indexSize != sizeof(AZ::u16) && header.m_indexSize != sizeof(AZ::u32)))
+        {
+            AZ_Error("MeshAsset", false, "Binary mesh has an unsupported version or size\n");
+            return false;
+        }
+
+        const auto inBounds = [size](AZ::u32 offset, size_t bytes)
+        {
+            return offset <= size && bytes <= size - offset;
+        };
+        if (!inBounds(header.m_attributeOffset, header.m_attributeCount * sizeof(MeshFormat::Attribute))
+            || !inBounds(header.m_subMeshOffset, header.m_subMeshCount * sizeof(MeshFormat::SubMesh))
+            || !inBounds(header.m_vertexOffset, size_t(header.m_vertexCount) * header.m_vertexStride)
+            || !inBounds(header.m_indexOffset, size_t(header.m_indexCount) * header.m_indexSize)
+            || header.m_vertexOffset % MeshFormat::Alignment != 0
+            || header.m_indexOffset % MeshFormat::Alignment != 0)
+        {
+            AZ_Error("MeshAsset", false, "Binary mesh sections are out of bounds\n");
+            return false;
+        }
+
+        // the attribute fields index tables inside bgfx, sub mesh ranges are drawn as they are
+        const auto* attributes = reinterpret_cast<const MeshFormat::Attribute*>(data + header.m_attributeOffset);
+        for (AZ::u32 i = 0; i < header.m_attributeCount; ++i)
+        {
+            const auto& attribute = attributes[i];
+            if (attribute.m_attrib >= bgfx::Attrib::Count || attribute.m_type >= bgfx::AttribType::Count
+                || attribute.m_num < 1 || attribute.m_num > 4)
             {
-                if (!position.empty())
-                {
-                    position[vertexCount].StoreToFloat3(reinterpret_cast<float*>(vertexBuffer.data() + vertexDesc.getStride() * vertexIndex + vertexDesc.getOffset(bgfx::Attrib::Position)));
-                }
-                if (!normal.empty())
-                {
-                    normal[vertexCount].StoreToFloat3(reinterpret_cast<float*>(vertexBuffer.data() + vertexDesc.getStride() * vertexIndex + vertexDesc.getOffset(bgfx::Attrib::Normal)));
-                }
-                if (!color.empty())
-                {
-                    color[vertexCount].StoreToFloat4(reinterpret_cast<float*>(vertexBuffer.data() + vertexDesc.getStride() * vertexIndex + vertexDesc.getOffset(bgfx::Attrib::Color0)));
-                }
-                if (!texcoord0.empty())
-                {
-                    texcoord0[vertexCount].StoreToFloat2(reinterpret_cast<float*>(vertexBuffer.data() + vertexDesc.getStride() * vertexIndex + vertexDesc.getOffset(bgfx::Attrib::TexCoord0)));
-                }
-                if (!texcoord1.empty())
-                {
-                    texcoord1[vertexCount].StoreToFloat2(reinterpret_cast<float*>(vertexBuffer.data() + vertexDesc.getStride() * vertexIndex + vertexDesc.getOffset(bgfx::Attrib::TexCoord1)));
-                }
-                if (!tangent.empty())
-                {
-                    tangent[vertexCount].StoreToFloat4(reinterpret_cast<float*>(vertexBuffer.data() + vertexDesc.getStride() * vertexIndex + vertexDesc.getOffset(bgfx::Attrib::Tangent)));
-                }
+                AZ_Error("MeshAsset", false, "Binary mesh has an invalid vertex attribute\n");
+                return false;
+            }
+        }
+
+        const auto* subMeshes = reinterpret_cast<const MeshFormat::SubMesh*>(data + header.m_subMeshOffset);
+        for (AZ::u32 i = 0; i < header.m_subMeshCount; ++i)
+        {
+            if (AZ::u64(subMeshes[i].m_firstIndex) + subMeshes[i].m_indexCount > header.m_indexCount)
+            {
+                AZ_Error("MeshAsset", false, "Binary mesh sub mesh is out of bounds\n");
+                return false;
             }
+        }
 
+        // static batches and occluders read the vertices through the indices on the cpu
+        const char* indices = data + header.m_indexOffset;
+        const AZ::u32 lastIndex = header.m_indexSize == sizeof(AZ::u32)
+            ? GetMaxIndex<AZ::u32>(indices, header.m_indexCount)
+            : GetMaxIndex<AZ::u16>(indices, header.m_indexCount);
+        if (header.m_indexCount > 0 && lastIndex >= header.m_vertexCount)
+        {
+            AZ_Error("MeshAsset", false, "Binary mesh index %u is out of its %u vertices\n", lastIndex, header.m_vertexCount);
+            return false;
+        }
+
+        m_vertexDesc.begin(bgfx::getRendererType());
+        for (AZ::u32 i = 0; i < header.m_attributeCount; ++i)
+        {
+            const auto& attribute = attributes[i];
+            m_vertexDesc.add(bgfx::Attrib::Enum(attribute.m_attrib), attribute.m_num, bgfx::AttribType::Enum(attribute.m_type)
+                , (attribute.m_flags & MeshFormat::AttributeNormalized) != 0, (attribute.m_flags & MeshFormat::AttributeAsInt) != 0);
+        }
+        m_vertexDesc.end();
+
+        if (m_vertexDesc.getStride() != header.m_vertexStride)
+        {
+            AZ_Error("MeshAsset", false, "Binary mesh vertex layout does not match its stride\n");
+            return false;
+        }
+
+        m_subMeshes.resize(header.m_subMeshCount);
+        for (AZ::u32 i = 0; i < header.m_subMeshCount; ++i)
+        {
+            m_subMeshes[i].m_firstIndex = subMeshes[i].m_firstIndex;
+            m_subMeshes[i].m_indexCount = subMeshes[i].m_indexCount;
+        }
+
+        m_aabb = AZ::Aabb::CreateFromMinMax(AZ::Vector3::CreateFromFloat3(header.m_aabbMin), AZ::Vector3::CreateFromFloat3(header.m_aabbMax));
+        m_dequantization = header.m_dequantization;
+        m_indexSize = header.m_indexSize;
+
+        m_mapped.m_file = file;
+        m_mapped.m_vertices = data + header.m_vertexOffset;
+        m_mapped.m_vertexSize = size_t(header.m_vertexCount) * header.m_vertexStride;
+        m_mapped.m_indices = data + header.m_indexOffset;
+        m_mapped.m_indexCount = header.m_indexCount;
+
+        return true;
+    }
+
+    bool MeshAsset::SaveBinary(AZStd::vector<char>& buffer) const
+    {
+        const AZ::u32 stride = m_vertexDesc.getStride();
+        if (stride == 0 || m_vertexBuffer.empty())
+        {
+            return false;
+        }
+
+        // the declaration does not remember the order attributes were added in, recover it from the offsets
+        AZStd::vector<MeshFormat::Attribute> attributes;
+        for (AZ::u32 attrib = 0; attrib < bgfx::Attrib::Count; ++attrib)
+        {
+            if (!m_vertexDesc.has(bgfx::Attrib::Enum(attrib)))
+            {
+                continue;
+            }
+
+            AZ::u8 num;
+            bgfx::AttribType::Enum type;
+            bool normalized;
+            bool asInt;
+            m_vertexDesc.decode(bgfx::Attrib::Enum(attrib), num, type, normalized, asInt);
+
+            MeshFormat::Attribute attribute;
+            attribute.m_attrib = static_cast<AZ::u8>(attrib);
+            attribute.m_num = num;
+            attribute.m_type = static_cast<AZ::u8>(type);
+            attribute.m_flags = (normalized ? MeshFormat::AttributeNormalized : 0) | (asInt ? MeshFormat::AttributeAsInt : 0);
+            attributes.push_back(attribute);
+        }
+        AZStd::sort(attributes.begin(), attributes.end(), [this](const MeshFormat::Attribute& lhv, const MeshFormat::Attribute& rhv)
+        {
+            return m_vertexDesc.getOffset(bgfx::Attrib::Enum(lhv.m_attrib)) < m_vertexDesc.getOffset(bgfx::Attrib::Enum(rhv.m_attrib));
+        });
+
+        MeshFormat::Header header;
+        header.m_attributeCount = static_cast<AZ::u32>(attributes.size());
+        header.m_attributeOffset = MeshFormat::Align(sizeof(header));
+        header.m_subMeshCount = static_cast<AZ::u32>(m_subMeshes.size());
+        header.m_subMeshOffset = MeshFormat::Align(header.m_attributeOffset + header.m_attributeCount * sizeof(MeshFormat::Attribute));
+        header.m_vertexCount = static_cast<AZ::u32>(m_vertexBuffer.size() / stride);
+        header.m_vertexStride = stride;
+        header.m_vertexOffset = MeshFormat::Align(header.m_subMeshOffset + header.m_subMeshCount * sizeof(MeshFormat::SubMesh));
+        header.m_indexCount = static_cast<AZ::u32>(m_indexBuffer.size() / m_indexSize);
+        header.m_indexOffset = MeshFormat::Align(header.m_vertexOffset + static_cast<AZ::u32>(m_vertexBuffer.size()));
+        header.m_fileSize = MeshFormat::Align(header.m_indexOffset + static_cast<AZ::u32>(m_indexBuffer.size()));
+        m_aabb.GetMin().StoreToFloat3(header.m_aabbMin);
+        m_aabb.GetMax().StoreToFloat3(header.m_aabbMax);
+        header.m_indexSize = m_indexSize;
+        header.m_dequantization = m_dequantization;
+
+        buffer.assign(header.m_fileSize, 0);
+        memcpy(buffer.data(), &header, sizeof(header));
+        memcpy(buffer.data() + header.m_attributeOffset, attributes.data(), attributes.size() * sizeof(MeshFormat::Attribute));
+        for (AZ::u32 i = 0; i < header.m_subMeshCount; ++i)
+        {
+            MeshFormat::SubMesh subMesh;
+            subMesh.m_firstIndex = m_subMeshes[i].m_firstIndex;
+            subMesh.m_indexCount = m_subMeshes[i].m_indexCount;
+            memcpy(buffer.data() + header.m_subMeshOffset + i * sizeof(subMesh), &subMesh, sizeof(subMesh));
+        }
+        memcpy(buffer.data() + header.m_vertexOffset, m_vertexBuffer.data(), m_vertexBuffer.size());
+        memcpy(buffer.data() + header.m_indexOffset, m_indexBuffer.data(), m_indexBuffer.size());
+
+        return true;
+    }
+
+    bool MeshAssetHandler::LoadAssetData(const AZ::Data::Asset<AZ::Data::AssetData>& asset, AZ::IO::GenericStream* stream, const AZ::Data::AssetFilterCB& assetLoadFilterCB)
+    {
+        // binary meshes are recognized by their magic, everything else goes through the object stream
+        const auto start = stream->GetCurPos();
+        AZ::u32 magic = 0;
+        const bool isBinary = stream->Read(sizeof(magic), &magic) == sizeof(magic) && magic == MeshFormat::Magic;
+        stream->Seek(start, AZ::IO::GenericStream::ST_SEEK_BEGIN);
+
+        if (isBinary)
+        {
+            auto file = MappedFile::Open(*stream);
+            return file && asset.GetAs<MeshAsset>()->LoadBinary(file);
+        }
+
+        if (AZ::GenericAssetHandler<MeshAsset>::LoadAssetData(asset, stream, assetLoadFilterCB))
+        {
+            asset.GetAs<MeshAsset>()->BuildVertexBuffer(bgfx::getRendererType());
             return true;
         }
         return false;
@@ -142,4 +519,9 @@ namespace AZ
 {
     AZ_TYPE_INFO_SPECIALIZE(bgfx::VertexDecl, "{89F9A719-F455-4015-A3B2-533783FDAF7C}");
     AZ_TYPE_INFO_SPECIALIZE(Module::MeshAsset::SubMesh, "{9AF2C57D-2BDA-421B-8EFF-7F3671B7F86A}");
+    AZ_TYPE_INFO_SPECIALIZE(Module::MeshAsset::VertexFormat, "{5E0A3C7B-1D94-4F62-9B8E-2C7F41A6D0E3}");
+    AZ_TYPE_INFO_SPECIALIZE(Module::PositionFormat, "{B2D64E19-7A3C-4E85-A1F0-6C9D2E47B813}");
+    AZ_TYPE_INFO_SPECIALIZE(Module::DirectionFormat, "{3F8C1A62-D5E7-49B0-8E2A-71C4B9D06F25}");
+    AZ_TYPE_INFO_SPECIALIZE(Module::TexcoordFormat, "{D7419E3B-6C25-4A8F-B3D1-0E5F82C7A946}");
+    AZ_TYPE_INFO_SPECIALIZE(Module::ColorFormat, "{8A5B2F04-E9C1-4D73-9F6E-B1A3C57D2E80}");
 }
@@ -8,10 +8,40 @@
 #include <AzCore/Math/Vector3.h>
 #include <AzCore/Math/Aabb.h>
 
+#include "Renderer/Util/MappedFile.h"
+#include "Renderer/Util/QuantizeUtil.h"
+
 #include <bgfx/bgfx.h>
 
 namespace Module
 {
+    // storage of the vertex attributes of a mesh, see QuantizeUtil for the quantized layouts
+    enum class PositionFormat : AZ::u8
+    {
+        Float = 0,
+        Int16 = 1, // normalized within the bounds of the mesh
+    };
+
+    // normals and tangents
+    enum class DirectionFormat : AZ::u8
+    {
+        Float      = 0,
+        Octahedral = 1,
+    };
+
+    enum class TexcoordFormat : AZ::u8
+    {
+        Float = 0,
+        Half  = 1, // needs BGFX_CAPS_VERTEX_ATTRIB_HALF
+        Int16 = 2, // normalized within the texcoord bounds of the mesh
+    };
+
+    enum class ColorFormat : AZ::u8
+    {
+        Float = 0,
+        Uint8 = 1,
+    };
+
     class MeshAsset : public AZ::Data::AssetData
     {
     public:
@@ -22,12 +52,48 @@ namespace Module
         {
             AZ_CLASS_ALLOCATOR(SubMesh, AZ::SystemAllocator, 0);
 
-            AZ::u16 m_firstIndex = 0;
-            AZ::u16 m_indexCount = 0;
+            AZ::u32 m_firstIndex = 0;
+            AZ::u32 m_indexCount = 0;
+        };
+
+        // picked per attribute when the vertex buffer is built, the defaults keep the source data as it is
+        struct VertexFormat
+        {
+            AZ_CLASS_ALLOCATOR(VertexFormat, AZ::SystemAllocator, 0);
+
+            PositionFormat  m_position  = PositionFormat::Float;
+            DirectionFormat m_normal    = DirectionFormat::Float;
+            DirectionFormat m_tangent   = DirectionFormat::Float;
+            ColorFormat     m_color     = ColorFormat::Float;
+            TexcoordFormat  m_texcoord0 = TexcoordFormat::Float;
+            TexcoordFormat  m_texcoord1 = TexcoordFormat::Float;
+        };
+
+        // view of the vertex and index blobs inside a memory mapped binary mesh, the file stays mapped as long as
+        // one view references it
+        struct MappedBuffers
+        {
+            MappedFilePtr  m_file;
+            const char*    m_vertices    = nullptr;
+            size_t         m_vertexSize  = 0;
+            const char*    m_indices     = nullptr;
+            size_t         m_indexCount  = 0;
         };
 
         static void Reflect(AZ::ReflectContext* context);
 
+        // Interleaves the per attribute streams loaded from xml into m_vertexBuffer in the formats of m_vertexFormat
+        // and packs the indices into m_indexBuffer, with 32 bits per index for meshes of more than 65536 vertices.
+        void BuildVertexBuffer(bgfx::RendererType::Enum rendererType);
+
+        // reads a binary mesh, see MeshFormat.h, the vertex and index data is not copied
+        bool LoadBinary(const MappedFilePtr& file);
+
+        // writes the interleaved vertices built by BuildVertexBuffer as a binary mesh
+        bool SaveBinary(AZStd::vector<char>& buffer) const;
+
+        VertexFormat& GetVertexFormat() { return m_vertexFormat; }
+
     private:
         AZStd::string m_name;
 
@@ -38,15 +104,23 @@ namespace Module
         AZStd::vector<AZ::Vector2> m_texcoord1;
         AZStd::vector<AZ::Vector4> m_tangent;
 
-        AZStd::vector<AZ::u16> m_indices;
+        AZStd::vector<AZ::u32> m_indices;
 
         AZStd::vector<SubMesh> m_subMeshes;
 
-        AZ::Aabb m_aabb;
+        AZ::Aabb m_aabb = AZ::Aabb::CreateNull();
+
+        VertexFormat m_vertexFormat;
 
         bgfx::VertexDecl m_vertexDesc;
 
         AZStd::vector<char> m_vertexBuffer;
+        AZStd::vector<char> m_indexBuffer;
+        AZ::u32             m_indexSize = sizeof(AZ::u16);
+
+        QuantizeUtil::Dequantization m_dequantization;
+
+        MappedBuffers m_mapped;
 
         friend class Mesh;
         friend class MeshAssetHandler;
@@ -0,0 +1,85 @@
+#pragma once
+
+#include "Renderer/Util/QuantizeUtil.h"
+
+#include <AzCore/base.h>
+
+#include <stddef.h>
+
+namespace Module
+{
+    // Binary mesh container, written offline by MeshConverter and memory mapped at runtime.
+    //
+    //   Header
+    //   Attribute[m_attributeCount]     at m_attributeOffset
+    //   SubMesh[m_subMeshCount]         at m_subMeshOffset
+    //   interleaved vertices            at m_vertexOffset, m_vertexCount * m_vertexStride bytes
+    //   16 or 32 bit indices            at m_indexOffset, m_indexCount * m_indexSize bytes
+    //
+    // Every section starts at a multiple of Alignment so the blobs can be handed to bgfx without a copy.
+    // All values are little endian. Quantized attributes are described in Renderer/Util/QuantizeUtil.h, version 1
+    // files end the header before m_indexSize and only have 16 bit indices and float attributes.
+    namespace MeshFormat
+    {
+        static const AZ::u32 Magic     = 0x48534D58; // "XMSH"
+        static const AZ::u32 Version   = 2;
+        static const AZ::u32 Alignment = 16;
+
+        struct Header
+        {
+            AZ::u32 m_magic           = Magic;
+            AZ::u32 m_version         = Version;
+            AZ::u32 m_fileSize        = 0;
+
+            AZ::u32 m_attributeCount  = 0;
+            AZ::u32 m_attributeOffset = 0;
+            AZ::u32 m_subMeshCount    = 0;
+            AZ::u32 m_subMeshOffset   = 0;
+
+            AZ::u32 m_vertexCount     = 0;
+            AZ::u32 m_vertexStride    = 0;
+            AZ::u32 m_vertexOffset    = 0;
+            AZ::u32 m_indexCount      = 0;
+            AZ::u32 m_indexOffset     = 0;
+
+            float   m_aabbMin[3]      = {};
+            float   m_aabbMax[3]      = {};
+
+            AZ::u32 m_indexSize       = sizeof(AZ::u16);
+
+            // scale and offset of the normalized positions and texcoords
+            QuantizeUtil::Dequantization m_dequantization;
+        };
+
+        static_assert(sizeof(QuantizeUtil::Dequantization) == 16 * sizeof(float), "Dequantization is stored as it is");
+
+        // size of the header of version 1 files
+        static const AZ::u32 HeaderSizeV1 = offsetof(Header, m_indexSize);
+
+        enum AttributeFlags : AZ::u8
+        {
+            AttributeNormalized = 1 << 0,
+            AttributeAsInt      = 1 << 1,
+        };
+
+        // one vertex attribute in declaration order, the values are the bgfx::Attrib and bgfx::AttribType enums
+        struct Attribute
+        {
+            AZ::u8 m_attrib = 0;
+            AZ::u8 m_num    = 0;
+            AZ::u8 m_type   = 0;
+            AZ::u8 m_flags  = 0;
+        };
+
+        struct SubMesh
+        {
+            AZ::u32 m_firstIndex = 0;
+            AZ::u32 m_indexCount = 0;
+        };
+
+        inline AZ::u32 Align(AZ::u32 offset)
+        {
+            return (offset + Alignment - 1) & ~(Alignment - 1);
+        }
+    }
+}
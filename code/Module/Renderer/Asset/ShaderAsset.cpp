@@ -13,12 +13,15 @@ namespace Module
                 ->Field("name", &Pass::m_name)
                 ->Field("vs", &Pass::m_vs)
                 ->Field("fs", &Pass::m_fs)
+                ->Field("vsInstanced", &Pass::m_vsInstanced)
                 ->Field("rs", &Pass::m_rs)
+                ->Field("instanceProperties", &Pass::m_instanceProperties)
                 ;
 
             serializeContext->Class<ShaderAsset>()
                 ->Field("name", &ShaderAsset::m_name)
                 ->Field("passes", &ShaderAsset::m_passes)
+                ->Field("properties", &ShaderAsset::m_properties)
                 ;
         }
 
@@ -29,13 +32,16 @@ namespace Module
                 ->Property("name", BehaviorValueProperty(&Pass::m_name))
                 ->Property("vs", BehaviorValueProperty(&Pass::m_vs))
                 ->Property("fs", BehaviorValueProperty(&Pass::m_fs))
+                ->Property("vsInstanced", BehaviorValueProperty(&Pass::m_vsInstanced))
                 ->Property("rs", BehaviorValueProperty(&Pass::m_rs))
+                ->Property("instanceProperties", BehaviorValueProperty(&Pass::m_instanceProperties))
                 ;
 
             behaviorContext->Class<ShaderAsset>("ShaderAsset")
                 ->Constructor()
                 ->Property("name", BehaviorValueProperty(&ShaderAsset::m_name))
                 ->Property("passes", BehaviorValueProperty(&ShaderAsset::m_passes))
+                ->Property("properties", BehaviorValueProperty(&ShaderAsset::m_properties))
                 ;
         }
     }
@@ -3,6 +3,8 @@
 #include <AzCore/Asset/AssetCommon.h>
 #include <AzCore/Asset/GenericAssetHandler.h>
 
+#include "Renderer/Asset/MaterialAsset.h"
+
 namespace Module
 {
     class ShaderAsset : public AZ::Data::AssetData
@@ -18,15 +20,29 @@ namespace Module
             AZStd::string m_name;
             AZStd::string m_vs;
             AZStd::string m_fs;
+            AZStd::string m_vsInstanced; // optional, passes with it can be drawn with GPU instancing
             AZ::u64       m_rs = 0;
+
+            // vector properties the instanced vertex shader reads from the instance data after the model matrix,
+            // property block overrides of them do not break instancing
+            AZStd::vector<AZStd::string> m_instanceProperties;
         };
 
         static void Reflect(AZ::ReflectContext* context);
 
+        // used where shaders are generated rather than cooked from a config
+        void SetName(const AZStd::string& name) { m_name = name; }
+        void AddPass(const Pass& pass)          { m_passes.push_back(pass); }
+        void AddProperty(const MaterialAsset::Property& property) { m_properties.push_back(property); }
+
     private:
         AZStd::string       m_name;
         AZStd::vector<Pass> m_passes;
 
+        // the Property entries of the config with their default as value, materials on the shader which do not
+        // declare one of them get the default
+        AZStd::vector<MaterialAsset::Property> m_properties;
+
         friend class Shader;
     };
 
@@ -65,6 +65,28 @@ namespace Module
                 ;
         }
     }
+
+    const TextureAsset::SpriteData* TextureAsset::FindSprite(const AZStd::string& name) const
+    {
+        const auto iterator = m_spriteIndices.find(name);
+        return iterator != m_spriteIndices.end() ? &m_sprites[iterator->second] : nullptr;
+    }
+
+    void TextureAsset::SetSprites(AZStd::vector<SpriteData>&& sprites)
+    {
+        m_sprites = AZStd::move(sprites);
+        BuildSpriteIndices();
+    }
+
+    void TextureAsset::BuildSpriteIndices()
+    {
+        m_spriteIndices.clear();
+        for (AZ::u32 i = 0; i < m_sprites.size(); ++i)
+        {
+            // the first sprite wins, as with the linear search this replaces
+            m_spriteIndices.insert(AZStd::make_pair(m_sprites[i].m_name, i));
+        }
+    }
 }
 
 namespace AZ
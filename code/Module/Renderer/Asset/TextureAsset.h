@@ -4,6 +4,7 @@
 #include <AzCore/Math/Vector2.h>
 #include <AzCore/Math/Vector3.h>
 #include <AzCore/Math/Vector4.h>
+#include <AzCore/std/containers/unordered_map.h>
 
 #include <bgfx/bgfx.h>
 
@@ -61,17 +62,32 @@ namespace Module
             AZ_CLASS_ALLOCATOR(SpriteData, AZ::SystemAllocator, 0);
 
             AZStd::string              m_name;
-            AZStd::vector<AZ::Vector3> m_positions;
+            AZStd::vector<AZ::Vector3> m_positions; // pixels relative to the pivot, y up
             AZStd::vector<AZ::Vector2> m_texcoords;
             AZStd::vector<AZ::u16>     m_indices;
-            AZ::Vector4                m_border;
-            AZ::Vector4                m_size;
-            AZ::Vector2                m_pivot;
+            AZ::Vector4                m_border;    // left, bottom, right, top in pixels
+            AZ::Vector4                m_size;      // x, y, width, height of the sprite rect in the texture in pixels
+            AZ::Vector2                m_pivot;     // normalized within the untrimmed sprite
             SpritePivot                m_pivotType = SpritePivot::Custom;
         };
 
+        // the sprite with the given name, nullptr when the texture has none
+        const SpriteData* FindSprite(const AZStd::string& name) const;
+
+        const AZStd::vector<SpriteData>& GetSprites() const { return m_sprites; }
+
+        // for the tools which build the asset instead of loading it
+        void SetSprites(AZStd::vector<SpriteData>&& sprites);
+        void SetPixelsToUnits(float pixelsToUnits)                     { m_pixelsToUnits = pixelsToUnits; }
+        void SetWrapMode(TextureWrapMode uWrapMode, TextureWrapMode vWrapMode) { m_uWrapMode = uWrapMode; m_vWrapMode = vWrapMode; }
+        void SetMeshType(SpriteMeshType meshType)                      { m_meshType = meshType; }
+
     private:
+        // indexes m_sprites by name, called once the sprites are loaded
+        void BuildSpriteIndices();
+
         AZStd::vector<SpriteData> m_sprites;
+        AZStd::unordered_map<AZStd::string, AZ::u32> m_spriteIndices;
         float                     m_pixelsToUnits = 100.0f;
         TextureWrapMode           m_uWrapMode     = TextureWrapMode::Repeat;
         TextureWrapMode           m_vWrapMode     = TextureWrapMode::Repeat;
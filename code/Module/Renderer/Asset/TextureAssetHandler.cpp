@@ -1,8 +1,12 @@
 #include "Renderer/Asset/TextureAssetHandler.h"
 
+#include "Renderer/Util/MappedFile.h"
+
 #include <AzCore/IO/GenericStreams.h>
+#include <AzCore/Serialization/Util.h>
 
 #include <bimg/bimg.h>
+#include <bx/error.h>
 
 namespace bgfx
 {
@@ -11,6 +15,15 @@ namespace bgfx
 
 namespace Module
 {
+    namespace
+    {
+        // frees the repacked image once bgfx has uploaded it
+        void ReleaseImage(void*, void* userData)
+        {
+            bimg::imageFree(static_cast<bimg::ImageContainer*>(userData));
+        }
+    }
+
     AZ::Data::AssetPtr TextureAssetHandler::CreateAsset(const AZ::Data::AssetId& id, const AZ::Data::AssetType& type)
     {
         return aznew TextureAsset;
@@ -20,137 +33,104 @@ namespace Module
     {
         TextureAsset* assetData = asset.GetAs<TextureAsset>();
 
-        const size_t length = stream->GetLength();
-        void* buffer = azmalloc(length);
-        stream->Read(length, buffer);
+        // the file is mapped, or read once when it is not on disk, and both the image and the metadata are parsed
+        // from it in place
+        const MappedFilePtr file = MappedFile::Open(*stream);
+        if (!file || file->GetSize() < sizeof(AZ::u32))
+        {
+            return false;
+        }
 
-        uint32_t flags = 0;
+        const char* data = file->GetData();
+        const size_t length = file->GetSize();
 
-        bgfx::TextureHandle handle = BGFX_INVALID_HANDLE;
+        // image | serialized TextureAsset | offset of the serialized TextureAsset, 0 without one
+        AZ::u32 metadataOffset = 0;
+        memcpy(&metadataOffset, data + length - sizeof(AZ::u32), sizeof(AZ::u32));
 
-        auto textureAssetBuffer = static_cast<char*>(buffer);
-        textureAssetBuffer = textureAssetBuffer + length - sizeof(int);
-        const int texLength = *reinterpret_cast<int*>(textureAssetBuffer);
-        if (texLength != 0)
+        // the trailing word of an image without metadata is image data, it is only cut off when the metadata parses
+        size_t imageLength = length;
+        uint32_t flags = 0;
+        if (metadataOffset != 0 && metadataOffset < length - sizeof(AZ::u32)
+            && AZ::Utils::LoadObjectFromBufferInPlace(data + metadataOffset, length - sizeof(AZ::u32) - metadataOffset, *assetData))
         {
-            textureAssetBuffer = (char*)buffer + texLength;
-            const auto textureAsset = AZ::Utils::LoadObjectFromBuffer<TextureAsset>(textureAssetBuffer, length - 4 - texLength);
-
-            switch (textureAsset->m_uWrapMode)
-            {
-            case TextureWrapMode::Clamp:
-                flags |= BGFX_TEXTURE_U_CLAMP;
-                break;
-            case TextureWrapMode::Mirror:
-                flags |= BGFX_TEXTURE_U_MIRROR;
-                break;
-            case TextureWrapMode::MirrorOnce:
-                flags |= BGFX_TEXTURE_U_MIRROR;
-                break;
-            case TextureWrapMode::Repeat:
-                break;
-            }
+            assetData->BuildSpriteIndices();
+            flags = GetSamplerFlags(*assetData);
+            imageLength = metadataOffset;
+        }
 
-            switch (textureAsset->m_vWrapMode)
-            {
-            case TextureWrapMode::Clamp:
-                flags |= BGFX_TEXTURE_V_CLAMP;
-                break;
-            case TextureWrapMode::Mirror:
-                flags |= BGFX_TEXTURE_V_MIRROR;
-                break;
-            case TextureWrapMode::MirrorOnce:
-                flags |= BGFX_TEXTURE_V_MIRROR;
-                break;
-            case TextureWrapMode::Repeat:
-                break;
-            }
+        bimg::ImageContainer header;
+        bx::Error error;
+        if (!bimg::imageParse(header, data, static_cast<uint32_t>(imageLength), &error))
+        {
+            AZ_Warning("TextureAssetHandler", false, "%s is not a dds, ktx or pvr image\n", asset.GetHint().c_str());
+            return false;
+        }
 
-            switch (textureAsset->m_filterMode)
-            {
-            case TextureFilterMode::Point:
-                flags |= BGFX_TEXTURE_MIN_POINT | BGFX_TEXTURE_MAG_POINT | BGFX_TEXTURE_MIP_POINT;
-                break;
-            case TextureFilterMode::Bilinear:
-                break;
-            case TextureFilterMode::Trilinear:
-                flags |= BGFX_TEXTURE_MIN_ANISOTROPIC | BGFX_TEXTURE_MAG_ANISOTROPIC;
-                break;
-            }
+        const bgfx::TextureFormat::Enum format = bgfx::TextureFormat::Enum(header.m_format);
+        const bool hasMips = 1 < header.m_numMips;
+
+        bgfx::calcTextureSize(assetData->m_info
+            , uint16_t(header.m_width)
+            , uint16_t(header.m_height)
+            , uint16_t(header.m_depth)
+            , header.m_cubeMap
+            , hasMips
+            , header.m_numLayers
+            , format
+        );
+
+        // dds stores every side with all its mips before the next side, the order bgfx expects, and so does a pvr of
+        // a single 2d surface, both are uploaded straight from the file. ktx prefixes every mip with its size and pvr
+        // stores all sides of a mip together, bimg repacks cube maps and arrays of them
+        AZ::u32 magic = 0;
+        memcpy(&magic, data, sizeof(magic));
+        const bool isDds = magic == BX_MAKEFOURCC('D', 'D', 'S', ' ');
+        const bool isSingleSurface = !header.m_cubeMap && header.m_numLayers == 1;
+
+        const bgfx::Memory* memory = nullptr;
+        bimg::ImageContainer* image = nullptr;
+        if (!header.m_ktx && (isDds || isSingleSurface) && header.m_offset + size_t(assetData->m_info.storageSize) <= imageLength)
+        {
+            memory = MappedFile::MakeRef(file, data + header.m_offset, assetData->m_info.storageSize);
+        }
+        else if (header.m_ktx)
+        {
+            image = bimg::imageParseKtx(bgfx::g_allocator, data, static_cast<uint32_t>(imageLength), &error);
+        }
+        else if (!isDds)
+        {
+            image = bimg::imageParsePvr3(bgfx::g_allocator, data, static_cast<uint32_t>(imageLength), &error);
         }
 
-        const auto caps = bgfx::getCaps();
+        if (image != nullptr)
+        {
+            memory = bgfx::makeRef(image->m_data, image->m_size, &ReleaseImage, image);
+        }
+        if (memory == nullptr)
+        {
+            return false;
+        }
 
-        bimg::ImageContainer* imageContainer = nullptr;
-        if (caps->formats[bgfx::TextureFormat::BC3] != BGFX_CAPS_FORMAT_TEXTURE_NONE)
+        bgfx::TextureHandle handle = BGFX_INVALID_HANDLE;
+        if (header.m_cubeMap)
         {
-            imageContainer = bimg::imageParseDds(bgfx::g_allocator, buffer, length, nullptr);
+            handle = bgfx::createTextureCube(uint16_t(header.m_width), hasMips, header.m_numLayers, format, flags, memory);
         }
-        else if (caps->formats[bgfx::TextureFormat::PTC14] != BGFX_CAPS_FORMAT_TEXTURE_NONE)
+        else if (1 < header.m_depth)
         {
-            imageContainer = bimg::imageParsePvr3(bgfx::g_allocator, buffer, length, nullptr);
+            handle = bgfx::createTexture3D(uint16_t(header.m_width), uint16_t(header.m_height), uint16_t(header.m_depth), hasMips, format, flags, memory);
         }
-        else if (caps->formats[bgfx::TextureFormat::ETC1] != BGFX_CAPS_FORMAT_TEXTURE_NONE)
+        else
         {
-            imageContainer = bimg::imageParseKtx(bgfx::g_allocator, buffer, length, nullptr);
+            handle = bgfx::createTexture2D(uint16_t(header.m_width), uint16_t(header.m_height), hasMips, header.m_numLayers, format, flags, memory);
         }
 
-        if (imageContainer)
+        if (bgfx::isValid(handle))
         {
-            if (imageContainer->m_cubeMap)
-            {
-                handle = bgfx::createTextureCube(
-                    uint16_t(imageContainer->m_width)
-                    , 1 < imageContainer->m_numMips
-                    , imageContainer->m_numLayers
-                    , bgfx::TextureFormat::Enum(imageContainer->m_format)
-                    , flags
-                    , bgfx::copy(imageContainer->m_data, imageContainer->m_size)
-                );
-            }
-            else if (1 < imageContainer->m_depth)
-            {
-                handle = bgfx::createTexture3D(
-                    uint16_t(imageContainer->m_width)
-                    , uint16_t(imageContainer->m_height)
-                    , uint16_t(imageContainer->m_depth)
-                    , 1 < imageContainer->m_numMips
-                    , bgfx::TextureFormat::Enum(imageContainer->m_format)
-                    , flags
-                    , bgfx::copy(imageContainer->m_data, imageContainer->m_size)
-                );
-            }
-            else
-            {
-                handle = bgfx::createTexture2D(
-                    uint16_t(imageContainer->m_width)
-                    , uint16_t(imageContainer->m_height)
-                    , 1 < imageContainer->m_numMips
-                    , imageContainer->m_numLayers
-                    , bgfx::TextureFormat::Enum(imageContainer->m_format)
-                    , flags
-                    , bgfx::copy(imageContainer->m_data, imageContainer->m_size)
-                );
-            }
-
             bgfx::setName(handle, asset.GetHint().c_str());
-
-            bgfx::calcTextureSize(
-                assetData->m_info
-                , uint16_t(imageContainer->m_width)
-                , uint16_t(imageContainer->m_height)
-                , uint16_t(imageContainer->m_depth)
-                , imageContainer->m_cubeMap
-                , 1 < imageContainer->m_numMips
-                , imageContainer->m_numLayers
-                , bgfx::TextureFormat::Enum(imageContainer->m_format)
-            );
-
-            bimg::imageFree(imageContainer);
         }
 
-        azfree(buffer);
-
         assetData->m_handle = handle;
 
         return bgfx::isValid(assetData->m_handle);
@@ -168,4 +148,53 @@ namespace Module
         }
         delete ptr;
     }
+
+    uint32_t TextureAssetHandler::GetSamplerFlags(const TextureAsset& textureAsset)
+    {
+        uint32_t flags = 0;
+
+        switch (textureAsset.m_uWrapMode)
+        {
+        case TextureWrapMode::Clamp:
+            flags |= BGFX_TEXTURE_U_CLAMP;
+            break;
+        case TextureWrapMode::Mirror:
+            flags |= BGFX_TEXTURE_U_MIRROR;
+            break;
+        case TextureWrapMode::MirrorOnce:
+            flags |= BGFX_TEXTURE_U_MIRROR;
+            break;
+        case TextureWrapMode::Repeat:
+            break;
+        }
+
+        switch (textureAsset.m_vWrapMode)
+        {
+        case TextureWrapMode::Clamp:
+            flags |= BGFX_TEXTURE_V_CLAMP;
+            break;
+        case TextureWrapMode::Mirror:
+            flags |= BGFX_TEXTURE_V_MIRROR;
+            break;
+        case TextureWrapMode::MirrorOnce:
+            flags |= BGFX_TEXTURE_V_MIRROR;
+            break;
+        case TextureWrapMode::Repeat:
+            break;
+        }
+
+        switch (textureAsset.m_filterMode)
+        {
+        case TextureFilterMode::Point:
+            flags |= BGFX_TEXTURE_MIN_POINT | BGFX_TEXTURE_MAG_POINT | BGFX_TEXTURE_MIP_POINT;
+            break;
+        case TextureFilterMode::Bilinear:
+            break;
+        case TextureFilterMode::Trilinear:
+            flags |= BGFX_TEXTURE_MIN_ANISOTROPIC | BGFX_TEXTURE_MAG_ANISOTROPIC;
+            break;
+        }
+
+        return flags;
+    }
 }
@@ -16,5 +16,8 @@ namespace Module
         bool LoadAssetData(const AZ::Data::Asset<AZ::Data::AssetData>& asset, AZ::IO::GenericStream* stream, const AZ::Data::AssetFilterCB& assetLoadFilterCB) override;
 
         void DestroyAsset(AZ::Data::AssetPtr ptr) override;
+
+    private:
+        static uint32_t GetSamplerFlags(const TextureAsset& textureAsset);
     };
 }
\ No newline at end of file
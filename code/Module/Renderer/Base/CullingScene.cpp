@@ -0,0 +1,148 @@
+#include "Renderer/Base/CullingScene.h"
+#include "Renderer/Base/Mesh.h"
+
+#include <AzCore/Math/Matrix4x4.h>
+
+namespace Module
+{
+    void CullingScene::Build(const AZStd::vector<RenderProxy>& proxies)
+    {
+        m_isStale = false;
+
+        // counting sort by layer, the proxies of a layer keep their order
+        AZ::u32 counts[LayerCount] = {};
+        for (const auto& proxy : proxies)
+        {
+            if (proxy.m_isVisible)
+            {
+                ++counts[proxy.m_layer];
+            }
+        }
+
+        m_layerBegin[0] = 0;
+        for (AZ::u32 layer = 0; layer < LayerCount; ++layer)
+        {
+            m_layerBegin[layer + 1] = m_layerBegin[layer] + counts[layer];
+            counts[layer] = m_layerBegin[layer];
+        }
+
+        m_entries.resize(m_layerBegin[LayerCount]);
+        for (AZ::u32 proxyIndex = 0; proxyIndex < proxies.size(); ++proxyIndex)
+        {
+            const auto& proxy = proxies[proxyIndex];
+            if (!proxy.m_isVisible)
+            {
+                continue;
+            }
+
+            auto& entry = m_entries[counts[proxy.m_layer]++];
+            entry.m_center = proxy.m_worldBounds.GetCenter();
+            entry.m_halfExtents = proxy.m_worldBounds.GetExtents() * 0.5f;
+            entry.m_proxyIndex = proxyIndex;
+            entry.m_hasBounds = proxy.m_hasBounds;
+        }
+
+        // occluders of static batches are still drawn from the mesh of their renderer, there are few of them so
+        // they are grouped by walking them once per layer
+        AZStd::vector<AZ::u32> occluders;
+        for (AZ::u32 proxyIndex = 0; proxyIndex < proxies.size(); ++proxyIndex)
+        {
+            if (proxies[proxyIndex].m_occluderMesh != nullptr)
+            {
+                occluders.push_back(proxyIndex);
+            }
+        }
+
+        m_occluderPositions.clear();
+        m_occluderIndices.clear();
+        for (AZ::u32 layer = 0; layer < LayerCount; ++layer)
+        {
+            auto& range = m_occluderBegin[layer];
+            range.m_firstVertex = static_cast<AZ::u32>(m_occluderPositions.size());
+            range.m_firstIndex = static_cast<AZ::u32>(m_occluderIndices.size());
+
+            for (auto proxyIndex : occluders)
+            {
+                const auto& proxy = proxies[proxyIndex];
+                if (proxy.m_layer != layer)
+                {
+                    continue;
+                }
+
+                const Mesh* mesh = proxy.m_occluderMesh;
+                const auto& decl = mesh->GetVertexDecl();
+                const AZ::u32 stride = decl.getStride();
+                const char* vertices = mesh->GetVertexData();
+                const AZ::u32 vertexCount = static_cast<AZ::u32>(mesh->GetVertexCount());
+                const AZ::u32 baseVertex = static_cast<AZ::u32>(m_occluderPositions.size()) - range.m_firstVertex;
+                const AZ::Matrix4x4 worldTM = AZ::Matrix4x4::CreateFromColumnMajorFloat16(proxy.m_worldMatrix);
+
+                for (AZ::u32 i = 0; i < vertexCount; ++i)
+                {
+                    float position[4];
+                    QuantizeUtil::Unpack(position, bgfx::Attrib::Position, decl, mesh->GetDequantization(), vertices + i * stride);
+                    m_occluderPositions.push_back(worldTM * AZ::Vector3(position[0], position[1], position[2]));
+                }
+
+                const size_t indexCount = mesh->GetIndexCount();
+                for (size_t i = 0; i < indexCount; ++i)
+                {
+                    m_occluderIndices.push_back(baseVertex + mesh->GetIndex(i));
+                }
+            }
+        }
+        m_occluderBegin[LayerCount].m_firstVertex = static_cast<AZ::u32>(m_occluderPositions.size());
+        m_occluderBegin[LayerCount].m_firstIndex = static_cast<AZ::u32>(m_occluderIndices.size());
+    }
+
+    bool CullingScene::HasOccluders(AZ::u32 layerMask) const
+    {
+        for (AZ::u32 layer = 0; layer < LayerCount; ++layer)
+        {
+            if ((layerMask & (1u << layer)) != 0 && m_occluderBegin[layer].m_firstIndex != m_occluderBegin[layer + 1].m_firstIndex)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void CullingScene::DrawOccluders(OcclusionBuffer& buffer, AZ::u32 layerMask) const
+    {
+        for (AZ::u32 layer = 0; layer < LayerCount; ++layer)
+        {
+            const auto& begin = m_occluderBegin[layer];
+            const auto& end = m_occluderBegin[layer + 1];
+            if ((layerMask & (1u << layer)) == 0 || begin.m_firstIndex == end.m_firstIndex)
+            {
+                continue;
+            }
+
+            buffer.Rasterize(m_occluderPositions.data() + begin.m_firstVertex, end.m_firstVertex - begin.m_firstVertex,
+                             m_occluderIndices.data() + begin.m_firstIndex, end.m_firstIndex - begin.m_firstIndex);
+        }
+    }
+
+    void CullingScene::Cull(const Frustum& frustum, AZ::u32 layerMask, VisibilityBits& visible, AZ::u32& visibleCount, AZ::u32& culledCount) const
+    {
+        for (AZ::u32 layer = 0; layer < LayerCount; ++layer)
+        {
+            if ((layerMask & (1u << layer)) == 0)
+            {
+                continue;
+            }
+
+            for (AZ::u32 i = m_layerBegin[layer]; i < m_layerBegin[layer + 1]; ++i)
+            {
+                const auto& entry = m_entries[i];
+                if (entry.m_hasBounds && !frustum.IntersectBox(entry.m_center, entry.m_halfExtents))
+                {
+                    ++culledCount;
+                    continue;
+                }
+                ++visibleCount;
+                visible.Set(entry.m_proxyIndex);
+            }
+        }
+    }
+}
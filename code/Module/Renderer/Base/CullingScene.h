@@ -0,0 +1,96 @@
+#pragma once
+
+#include "Renderer/Base/Frustum.h"
+#include "Renderer/Base/OcclusionBuffer.h"
+#include "Renderer/Base/RenderProxy.h"
+
+#include <AzCore/Memory/SystemAllocator.h>
+#include <AzCore/Math/Vector3.h>
+#include <AzCore/std/containers/vector.h>
+
+#include <bx/uint32_t.h>
+
+namespace Module
+{
+    // One bit per render proxy, indexed like the proxies.
+    class VisibilityBits
+    {
+    public:
+        // clears all bits and makes room for `count` proxies
+        void Reset(AZ::u32 count) { m_words.assign((count + 63) / 64, 0); }
+
+        void Set(AZ::u32 index)          { m_words[index >> 6] |= AZ::u64(1) << (index & 63); }
+        void Clear(AZ::u32 index)        { m_words[index >> 6] &= ~(AZ::u64(1) << (index & 63)); }
+        bool IsSet(AZ::u32 index) const  { return (m_words[index >> 6] >> (index & 63)) & 1; }
+
+        // calls function(index) for every set bit in ascending order
+        template <typename Function>
+        void ForEach(const Function& function) const
+        {
+            for (AZ::u32 word = 0; word < m_words.size(); ++word)
+            {
+                for (AZ::u64 bits = m_words[word]; bits != 0; bits &= bits - 1)
+                {
+                    function(word * 64 + bx::uint64_cnttz(bits));
+                }
+            }
+        }
+
+    private:
+        AZStd::vector<AZ::u64> m_words;
+    };
+
+    // Culling input shared by all cameras of a frame. The world bounds of the visible proxies are copied once into
+    // a compact array grouped by layer, so a camera only walks the layers of its culling mask and the proxies do
+    // not have to be touched again until one of them changes.
+    class CullingScene
+    {
+    public:
+        AZ_CLASS_ALLOCATOR(CullingScene, AZ::SystemAllocator, 0);
+
+        static const AZ::u32 LayerCount = 32;
+
+        void MarkStale()      { m_isStale = true; }
+        bool IsStale() const  { return m_isStale; }
+
+        void Build(const AZStd::vector<RenderProxy>& proxies);
+
+        // sets the bit of every proxy in the layers of `layerMask` which intersects the frustum, proxies without
+        // bounds are always visible
+        void Cull(const Frustum& frustum, AZ::u32 layerMask, VisibilityBits& visible, AZ::u32& visibleCount, AZ::u32& culledCount) const;
+
+        AZ::u32 GetEntryCount() const { return static_cast<AZ::u32>(m_entries.size()); }
+
+        // some occluder is in one of the layers of `layerMask`
+        bool HasOccluders(AZ::u32 layerMask) const;
+
+        // draws the world space triangles of the occluders in the layers of `layerMask`, the buffer is begun and
+        // ended by the caller
+        void DrawOccluders(OcclusionBuffer& buffer, AZ::u32 layerMask) const;
+
+    private:
+        struct Entry
+        {
+            AZ::Vector3 m_center;
+            AZ::Vector3 m_halfExtents;
+            AZ::u32     m_proxyIndex;
+            bool        m_hasBounds;
+        };
+
+        AZStd::vector<Entry> m_entries;                     // sorted by layer
+        AZ::u32              m_layerBegin[LayerCount + 1] = {}; // first entry of every layer, the last one ends the array
+
+        struct OccluderRange
+        {
+            AZ::u32 m_firstVertex = 0;
+            AZ::u32 m_firstIndex  = 0;
+        };
+
+        // triangles of the occluder meshes in world space, copied on Build so the cameras never read the meshes. they
+        // are grouped by layer, the indices of a layer start at its first vertex
+        AZStd::vector<AZ::Vector3> m_occluderPositions;
+        AZStd::vector<AZ::u32>     m_occluderIndices;
+        OccluderRange              m_occluderBegin[LayerCount + 1];
+        bool                 m_isStale = true;
+    };
+}
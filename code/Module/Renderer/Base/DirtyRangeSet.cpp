@@ -0,0 +1,55 @@
+#include "Renderer/Base/DirtyRangeSet.h"
+
+namespace Module
+{
+    void DirtyRangeSet::Add(AZ::u32 begin, AZ::u32 end)
+    {
+        if (begin >= end)
+        {
+            return;
+        }
+
+        // skip the ranges that end before the new one starts
+        size_t first = 0;
+        while (first < m_ranges.size() && m_ranges[first].m_end < begin)
+        {
+            ++first;
+        }
+
+        // swallow every range that overlaps or touches the new one
+        size_t last = first;
+        while (last < m_ranges.size() && m_ranges[last].m_begin <= end)
+        {
+            begin = AZStd::GetMin(begin, m_ranges[last].m_begin);
+            end = AZStd::GetMax(end, m_ranges[last].m_end);
+            ++last;
+        }
+
+        Range range;
+        range.m_begin = begin;
+        range.m_end = end;
+        if (first == last)
+        {
+            m_ranges.insert(m_ranges.begin() + first, range);
+        }
+        else
+        {
+            m_ranges[first] = range;
+            m_ranges.erase(m_ranges.begin() + first + 1, m_ranges.begin() + last);
+        }
+
+        if (m_ranges.size() > MaxRangeCount)
+        {
+            size_t closest = 0;
+            for (size_t i = 1; i + 1 < m_ranges.size(); ++i)
+            {
+                if (m_ranges[i + 1].m_begin - m_ranges[i].m_end < m_ranges[closest + 1].m_begin - m_ranges[closest].m_end)
+                {
+                    closest = i;
+                }
+            }
+            m_ranges[closest].m_end = m_ranges[closest + 1].m_end;
+            m_ranges.erase(m_ranges.begin() + closest + 1);
+        }
+    }
+}
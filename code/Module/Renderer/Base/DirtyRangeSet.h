@@ -0,0 +1,35 @@
+#pragma once
+
+#include <AzCore/Memory/SystemAllocator.h>
+#include <AzCore/std/containers/vector.h>
+
+namespace Module
+{
+    // Small sorted set of half open [begin, end) element ranges. Overlapping and touching ranges are merged, once
+    // MaxRangeCount is exceeded the two ranges with the smallest gap between them are merged as well, so the set
+    // never costs more than a few buffer updates.
+    class DirtyRangeSet
+    {
+    public:
+        AZ_CLASS_ALLOCATOR(DirtyRangeSet, AZ::SystemAllocator, 0);
+
+        static const size_t MaxRangeCount = 8;
+
+        struct Range
+        {
+            AZ::u32 m_begin = 0;
+            AZ::u32 m_end   = 0;
+        };
+
+        void Add(AZ::u32 begin, AZ::u32 end);
+
+        void Clear() { m_ranges.clear(); }
+
+        bool IsEmpty() const { return m_ranges.empty(); }
+
+        const AZStd::vector<Range>& GetRanges() const { return m_ranges; }
+
+    private:
+        AZStd::vector<Range> m_ranges;
+    };
+}
@@ -0,0 +1,145 @@
+#include "Renderer/Base/FrameProfiler.h"
+
+#include <AzCore/IO/FileIO.h>
+#include <AzCore/JSON/prettywriter.h>
+#include <AzCore/JSON/stringbuffer.h>
+#include <AzCore/RTTI/BehaviorContext.h>
+
+namespace Module
+{
+    void FrameProfiler::Reflect(AZ::ReflectContext* context)
+    {
+        if (auto behaviorContext = azrtti_cast<AZ::BehaviorContext*>(context))
+        {
+            behaviorContext->Class<CameraFrameStats>("CameraFrameStats")
+                ->Property("cameraId", BehaviorValueGetter(&CameraFrameStats::m_cameraId), nullptr)
+                ->Property("viewId", BehaviorValueGetter(&CameraFrameStats::m_viewId), nullptr)
+                ->Property("cullMs", BehaviorValueGetter(&CameraFrameStats::m_cullMs), nullptr)
+                ->Property("gatherMs", BehaviorValueGetter(&CameraFrameStats::m_gatherMs), nullptr)
+                ->Property("sortMs", BehaviorValueGetter(&CameraFrameStats::m_sortMs), nullptr)
+                ->Property("occlusionMs", BehaviorValueGetter(&CameraFrameStats::m_occlusionMs), nullptr)
+                ->Property("submitMs", BehaviorValueGetter(&CameraFrameStats::m_submitMs), nullptr)
+                ->Property("visibleCount", BehaviorValueGetter(&CameraFrameStats::m_visibleCount), nullptr)
+                ->Property("culledCount", BehaviorValueGetter(&CameraFrameStats::m_culledCount), nullptr)
+                ->Property("occludedCount", BehaviorValueGetter(&CameraFrameStats::m_occludedCount), nullptr)
+                ->Property("nodeCount", BehaviorValueGetter(&CameraFrameStats::m_nodeCount), nullptr)
+                ->Property("stateChanges", BehaviorValueGetter(&CameraFrameStats::m_stateChanges), nullptr)
+                ->Property("triangleCount", BehaviorValueGetter(&CameraFrameStats::m_triangleCount), nullptr)
+                ->Property("spriteBatchCount", BehaviorValueGetter(&CameraFrameStats::m_spriteBatchCount), nullptr)
+                ->Property("droppedSpriteCount", BehaviorValueGetter(&CameraFrameStats::m_droppedSpriteCount), nullptr)
+                ->Property("renderCpuMs", BehaviorValueGetter(&CameraFrameStats::m_renderCpuMs), nullptr)
+                ->Property("gpuMs", BehaviorValueGetter(&CameraFrameStats::m_gpuMs), nullptr);
+
+            behaviorContext->Class<FrameStats>("FrameStats")
+                ->Property("frameNumber", BehaviorValueGetter(&FrameStats::m_frameNumber), nullptr)
+                ->Property("frameMs", BehaviorValueGetter(&FrameStats::m_frameMs), nullptr)
+                ->Property("updateMs", BehaviorValueGetter(&FrameStats::m_updateMs), nullptr)
+                ->Property("cullMs", BehaviorValueGetter(&FrameStats::m_cullMs), nullptr)
+                ->Property("submitMs", BehaviorValueGetter(&FrameStats::m_submitMs), nullptr)
+                ->Property("renderCpuMs", BehaviorValueGetter(&FrameStats::m_renderCpuMs), nullptr)
+                ->Property("gpuMs", BehaviorValueGetter(&FrameStats::m_gpuMs), nullptr)
+                ->Property("waitRenderMs", BehaviorValueGetter(&FrameStats::m_waitRenderMs), nullptr)
+                ->Property("waitSubmitMs", BehaviorValueGetter(&FrameStats::m_waitSubmitMs), nullptr)
+                ->Property("overlapMs", BehaviorValueGetter(&FrameStats::m_overlapMs), nullptr)
+                ->Property("drawCount", BehaviorValueGetter(&FrameStats::m_drawCount), nullptr)
+                ->Method("GetCameraCount", &FrameStats::GetCameraCount)
+                ->Method("GetCamera", &FrameStats::GetCamera);
+        }
+    }
+
+    void FrameProfiler::SetCapacity(AZ::u32 frameCount)
+    {
+        m_frames.clear();
+        m_frames.resize(frameCount);
+        m_next = 0;
+        m_count = 0;
+    }
+
+    FrameStats& FrameProfiler::BeginFrame()
+    {
+        AZ_Assert(IsEnabled(), "The frame profiler has no capacity\n");
+
+        auto& frame = m_frames[m_next];
+        m_next = (m_next + 1) % m_frames.size();
+        m_count = AZStd::GetMin(m_count + 1, static_cast<AZ::u32>(m_frames.size()));
+
+        // keeps the camera vector and its capacity
+        auto cameras = AZStd::move(frame.m_cameras);
+        frame = FrameStats();
+        frame.m_cameras = AZStd::move(cameras);
+        frame.m_cameras.clear();
+        frame.m_frameNumber = m_frameNumber++;
+        return frame;
+    }
+
+    const FrameStats& FrameProfiler::GetFrame(AZ::u32 index) const
+    {
+        AZ_Assert(index < m_count, "Frame index out of bounds\n");
+        const AZ::u32 capacity = static_cast<AZ::u32>(m_frames.size());
+        return m_frames[(m_next + capacity - m_count + index) % capacity];
+    }
+
+    bool FrameProfiler::WriteJson(const AZStd::string& path) const
+    {
+        rapidjson::StringBuffer buffer;
+        rapidjson::PrettyWriter<rapidjson::StringBuffer> writer(buffer);
+
+        writer.StartObject();
+        writer.Key("frames");
+        writer.StartArray();
+        for (AZ::u32 i = 0; i < m_count; ++i)
+        {
+            const auto& frame = GetFrame(i);
+
+            writer.StartObject();
+            writer.Key("frameNumber");  writer.Uint64(frame.m_frameNumber);
+            writer.Key("frameMs");      writer.Double(frame.m_frameMs);
+            writer.Key("updateMs");     writer.Double(frame.m_updateMs);
+            writer.Key("cullMs");       writer.Double(frame.m_cullMs);
+            writer.Key("submitMs");     writer.Double(frame.m_submitMs);
+            writer.Key("renderCpuMs");  writer.Double(frame.m_renderCpuMs);
+            writer.Key("gpuMs");        writer.Double(frame.m_gpuMs);
+            writer.Key("waitRenderMs"); writer.Double(frame.m_waitRenderMs);
+            writer.Key("waitSubmitMs"); writer.Double(frame.m_waitSubmitMs);
+            writer.Key("overlapMs");    writer.Double(frame.m_overlapMs);
+            writer.Key("drawCount");    writer.Uint(frame.m_drawCount);
+
+            writer.Key("cameras");
+            writer.StartArray();
+            for (const auto& camera : frame.m_cameras)
+            {
+                writer.StartObject();
+                writer.Key("cameraId");      writer.Uint64(static_cast<AZ::u64>(camera.m_cameraId));
+                writer.Key("viewId");        writer.Uint(camera.m_viewId);
+                writer.Key("cullMs");        writer.Double(camera.m_cullMs);
+                writer.Key("gatherMs");      writer.Double(camera.m_gatherMs);
+                writer.Key("sortMs");        writer.Double(camera.m_sortMs);
+                writer.Key("occlusionMs");   writer.Double(camera.m_occlusionMs);
+                writer.Key("submitMs");      writer.Double(camera.m_submitMs);
+                writer.Key("visibleCount");  writer.Uint(camera.m_visibleCount);
+                writer.Key("culledCount");   writer.Uint(camera.m_culledCount);
+                writer.Key("occludedCount"); writer.Uint(camera.m_occludedCount);
+                writer.Key("nodeCount");     writer.Uint(camera.m_nodeCount);
+                writer.Key("stateChanges");  writer.Uint(camera.m_stateChanges);
+                writer.Key("triangleCount"); writer.Uint(camera.m_triangleCount);
+                writer.Key("spriteBatchCount");   writer.Uint(camera.m_spriteBatchCount);
+                writer.Key("droppedSpriteCount"); writer.Uint(camera.m_droppedSpriteCount);
+                writer.Key("renderCpuMs");   writer.Double(camera.m_renderCpuMs);
+                writer.Key("gpuMs");         writer.Double(camera.m_gpuMs);
+                writer.EndObject();
+            }
+            writer.EndArray();
+            writer.EndObject();
+        }
+        writer.EndArray();
+        writer.EndObject();
+
+        AZ::IO::FileIOStream stream;
+        if (!stream.Open(path.c_str(), AZ::IO::OpenMode::ModeWrite | AZ::IO::OpenMode::ModeText))
+        {
+            AZ_Warning("Renderer", false, "Can not write the frame profile to %s\n", path.c_str());
+            return false;
+        }
+        return stream.Write(buffer.GetSize(), buffer.GetString()) == buffer.GetSize();
+    }
+}
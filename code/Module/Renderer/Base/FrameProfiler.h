@@ -0,0 +1,97 @@
+#pragma once
+
+#include <AzCore/Component/EntityId.h>
+#include <AzCore/Memory/SystemAllocator.h>
+#include <AzCore/RTTI/ReflectContext.h>
+#include <AzCore/RTTI/TypeInfo.h>
+#include <AzCore/std/containers/vector.h>
+#include <AzCore/std/string/string.h>
+
+namespace Module
+{
+    // timings and counters of one camera, the cpu times are measured inside the jobs
+    struct CameraFrameStats
+    {
+        AZ_TYPE_INFO(CameraFrameStats, "{5B0E4C7A-93D1-4E2B-8F6A-1C2D3E4F5A6B}");
+
+        AZ::EntityId m_cameraId;
+        AZ::u32      m_viewId         = 0;
+
+        float        m_cullMs         = 0.0f; // visibility tests of proxies and static batch ranges
+        float        m_gatherMs       = 0.0f; // render nodes and sort keys of the visible ones
+        float        m_sortMs         = 0.0f;
+        float        m_occlusionMs    = 0.0f; // occluders drawn into the occlusion buffer and the bounds tested against it
+        float        m_submitMs       = 0.0f; // summed over the submission jobs which recorded the view
+
+        AZ::u32      m_visibleCount   = 0;
+        AZ::u32      m_culledCount    = 0;
+        AZ::u32      m_occludedCount  = 0;    // inside the frustum but behind occluders, counted neither visible nor culled
+        AZ::u32      m_nodeCount      = 0;
+        AZ::u32      m_stateChanges   = 0;    // draws whose material, property block or pass differs from the previous one
+        AZ::u32      m_triangleCount  = 0;    // only of nodes drawing a mesh or a sprite batch
+        AZ::u32      m_spriteBatchCount   = 0;
+        AZ::u32      m_droppedSpriteCount = 0; // out of transient memory, the sprites were not drawn
+
+        float        m_renderCpuMs    = 0.0f; // bgfx view stats, only filled while the profiler records
+        float        m_gpuMs          = 0.0f;
+    };
+
+    struct FrameStats
+    {
+        AZ_TYPE_INFO(FrameStats, "{8D3F2A61-0B7C-4E95-A2D4-6F1E9C3B5D70}");
+
+        AZ::u64 m_frameNumber  = 0;
+        float   m_frameMs      = 0.0f; // cpu time between two bgfx frames
+        float   m_updateMs     = 0.0f; // dirty meshes, dirty renderers and static batches
+        float   m_cullMs       = 0.0f; // wall time of all camera jobs, gather and sort included
+        float   m_submitMs     = 0.0f; // wall time of all submission jobs
+        float   m_renderCpuMs  = 0.0f; // render thread time of bgfx
+        float   m_gpuMs        = 0.0f;
+        float   m_waitRenderMs = 0.0f; // bgfx::frame waiting for the render thread to finish the frame before
+        float   m_waitSubmitMs = 0.0f; // render thread waiting for the next frame
+        float   m_overlapMs    = 0.0f; // render thread time hidden behind the recording of the next frame
+        AZ::u32 m_drawCount    = 0;
+
+        AZStd::vector<CameraFrameStats> m_cameras; // in camera depth order
+
+        AZ::u32 GetCameraCount() const { return static_cast<AZ::u32>(m_cameras.size()); }
+
+        CameraFrameStats GetCamera(AZ::u32 index) const { return index < m_cameras.size() ? m_cameras[index] : CameraFrameStats(); }
+    };
+
+    // Ring buffer of the stats of the last frames. The slots are reused, filling a frame does not allocate once the
+    // camera count is stable.
+    class FrameProfiler
+    {
+    public:
+        AZ_CLASS_ALLOCATOR(FrameProfiler, AZ::SystemAllocator, 0);
+
+        static void Reflect(AZ::ReflectContext* context);
+
+        // drops the recorded frames, a capacity of 0 stops recording
+        void SetCapacity(AZ::u32 frameCount);
+
+        AZ::u32 GetCapacity() const { return static_cast<AZ::u32>(m_frames.size()); }
+
+        bool IsEnabled() const { return !m_frames.empty(); }
+
+        // slot of the next frame, it replaces the oldest one once the buffer is full
+        FrameStats& BeginFrame();
+
+        AZ::u32 GetFrameCount() const { return m_count; }
+
+        // 0 is the oldest recorded frame
+        const FrameStats& GetFrame(AZ::u32 index) const;
+
+        const FrameStats* GetLatest() const { return m_count > 0 ? &GetFrame(m_count - 1) : nullptr; }
+
+        // writes the recorded frames from the oldest to the latest
+        bool WriteJson(const AZStd::string& path) const;
+
+    private:
+        AZStd::vector<FrameStats> m_frames;
+        AZ::u32                   m_next        = 0;
+        AZ::u32                   m_count       = 0;
+        AZ::u64                   m_frameNumber = 0;
+    };
+}
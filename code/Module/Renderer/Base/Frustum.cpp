@@ -0,0 +1,64 @@
+#include "Renderer/Base/Frustum.h"
+
+namespace Module
+{
+    static AZ::Plane CreateNormalizedPlane(float a, float b, float c, float d)
+    {
+        const float length = AZ::Vector3(a, b, c).GetLength();
+        const float invLength = length > 0.0f ? 1.0f / length : 0.0f;
+        return AZ::Plane::CreateFromCoefficients(a * invLength, b * invLength, c * invLength, d * invLength);
+    }
+
+    Frustum::Frustum()
+    {
+        for (auto& plane : m_planes)
+        {
+            plane.Set(0.0f, 0.0f, 0.0f, 1.0f);
+        }
+    }
+
+    void Frustum::SetFromViewProjection(const float* mtx, bool homogeneousDepth)
+    {
+        // clip = v * M, so every clip component is the dot product of v with a column of M
+        const float x[4] = { mtx[0], mtx[4], mtx[8],  mtx[12] };
+        const float y[4] = { mtx[1], mtx[5], mtx[9],  mtx[13] };
+        const float z[4] = { mtx[2], mtx[6], mtx[10], mtx[14] };
+        const float w[4] = { mtx[3], mtx[7], mtx[11], mtx[15] };
+
+        m_planes[Left]   = CreateNormalizedPlane(w[0] + x[0], w[1] + x[1], w[2] + x[2], w[3] + x[3]);
+        m_planes[Right]  = CreateNormalizedPlane(w[0] - x[0], w[1] - x[1], w[2] - x[2], w[3] - x[3]);
+        m_planes[Bottom] = CreateNormalizedPlane(w[0] + y[0], w[1] + y[1], w[2] + y[2], w[3] + y[3]);
+        m_planes[Top]    = CreateNormalizedPlane(w[0] - y[0], w[1] - y[1], w[2] - y[2], w[3] - y[3]);
+        m_planes[Far]    = CreateNormalizedPlane(w[0] - z[0], w[1] - z[1], w[2] - z[2], w[3] - z[3]);
+
+        if (homogeneousDepth)
+        {
+            // depth range is [-w, w]
+            m_planes[Near] = CreateNormalizedPlane(w[0] + z[0], w[1] + z[1], w[2] + z[2], w[3] + z[3]);
+        }
+        else
+        {
+            // depth range is [0, w]
+            m_planes[Near] = CreateNormalizedPlane(z[0], z[1], z[2], z[3]);
+        }
+    }
+
+    bool Frustum::IntersectAabb(const AZ::Aabb& aabb) const
+    {
+        return IntersectBox(aabb.GetCenter(), aabb.GetExtents() * 0.5f);
+    }
+
+    bool Frustum::IntersectBox(const AZ::Vector3& center, const AZ::Vector3& halfExtents) const
+    {
+        for (const auto& plane : m_planes)
+        {
+            const float distance = plane.GetPointDist(center);
+            const float radius = halfExtents.Dot(plane.GetNormal().GetAbs());
+            if (distance + radius < 0.0f)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <AzCore/Math/Aabb.h>
+#include <AzCore/Math/Plane.h>
+
+namespace Module
+{
+    class Frustum
+    {
+    public:
+        enum PlaneId : AZ::u8
+        {
+            Left = 0,
+            Right,
+            Bottom,
+            Top,
+            Near,
+            Far,
+            PlaneCount,
+        };
+
+        Frustum();
+
+        // planes are extracted from a bx style (row vector) view projection matrix
+        void SetFromViewProjection(const float* viewProjection, bool homogeneousDepth);
+
+        bool IntersectAabb(const AZ::Aabb& aabb) const;
+
+        // box given by its center and half of its extents, saves the conversion when the boxes are kept that way
+        bool IntersectBox(const AZ::Vector3& center, const AZ::Vector3& halfExtents) const;
+
+        const AZ::Plane& GetPlane(PlaneId id) const { return m_planes[id]; }
+
+    private:
+        AZ::Plane m_planes[PlaneCount];
+    };
+}
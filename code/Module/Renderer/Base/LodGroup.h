@@ -0,0 +1,30 @@
+#pragma once
+
+#include "Renderer/Base/Mesh.h"
+
+#include <AzCore/Memory/SystemAllocator.h>
+#include <AzCore/std/containers/vector.h>
+#include <AzCore/std/string/string.h>
+
+namespace Module
+{
+    // Levels of detail of a renderer as the renderer system reads them. The renderer only keeps the meshes of the
+    // levels the cameras picked lately, the others go back to the mesh cache and stay there within its budget.
+    struct LodGroup
+    {
+        AZ_CLASS_ALLOCATOR(LodGroup, AZ::SystemAllocator, 0);
+
+        static const AZ::u32 MaxLevels = 8;
+
+        struct Level
+        {
+            AZStd::string m_path;               // empty for the mesh of the mesh filter, which is always kept
+            float         m_screenHeight = 0.0f;
+            MeshPtr       m_mesh;               // nullptr while released
+        };
+
+        AZStd::vector<Level> m_levels;
+        float                m_hysteresis    = 0.0f;
+        float                m_crossFadeTime = 0.0f;
+    };
+}
@@ -9,6 +9,7 @@ namespace Module
     Material::Property::Property(const MaterialAsset::Property& config)
     {
         m_name = config.m_name;
+        m_nameCrc = AZ::Crc32(config.m_name.c_str());
         if (config.m_type == MaterialAsset::Property::Type::Vector)
         {
             m_uniform = bgfx::createUniform(config.m_name.c_str(), bgfx::UniformType::Vec4);
@@ -51,6 +52,7 @@ namespace Module
     {
         m_uniform = rhv.m_uniform;
         m_name = rhv.m_name;
+        m_nameCrc = rhv.m_nameCrc;
         m_type = rhv.m_type;
         memcpy(m_vectorValue, rhv.m_vectorValue, sizeof(m_vectorValue));
         m_textureValue = rhv.m_textureValue;
@@ -60,25 +62,44 @@ namespace Module
         return *this;
     }
 
-    void Material::Property::Apply(int textureStage)
+    void Material::Property::Apply(bgfx::Encoder* encoder, int textureStage, const MaterialPropertyBlock::Entry* override)
     {
+        // overrides of the wrong type are ignored, the property keeps its own value
+        if (override != nullptr && override->m_isTexture != (m_type == Type::Texture))
+        {
+            override = nullptr;
+        }
+
         if (m_type == Type::Vector)
         {
-            bgfx::setUniform(m_uniform, m_vectorValue);
+            encoder->setUniform(m_uniform, override != nullptr ? override->m_vectorValue : m_vectorValue);
         }
         else if (m_type == Type::Texture)
         {
-            m_textureValue->Apply(textureStage, m_uniform);
+            auto& texture = override != nullptr && override->m_textureValue ? override->m_textureValue : m_textureValue;
+            texture->Apply(encoder, textureStage, m_uniform);
         }
     }
 
     Material::Material(const AZStd::string& relativePath)
     {
+        static AZ::u16 s_nextSortId = 0;
+        m_sortId = s_nextSortId++;
+
         m_config.Create((relativePath + ".mat").c_str(), true);
 
         AZ::Data::AssetBus::Handler::BusConnect(m_config.GetId());
     }
 
+    Material::~Material()
+    {
+        if (m_shader)
+        {
+            auto& waiting = m_shader->m_waitingMaterials;
+            waiting.erase(AZStd::remove(waiting.begin(), waiting.end(), this), waiting.end());
+        }
+    }
+
     void Material::OnAssetReady(AZ::Data::Asset<AZ::Data::AssetData> asset)
     {
         AZ::Data::AssetBus::Handler::BusDisconnect(asset.GetId());
@@ -93,31 +114,65 @@ namespace Module
         }
 
         m_config.Release();
+
+        // shader uniforms the material does not set would keep the value of the previous draw
+        if (m_shader && m_shader->IsLoaded())
+        {
+            AddDefaultProperties(m_shader->GetDefaultProperties());
+        }
+        else if (m_shader)
+        {
+            m_shader->m_waitingMaterials.push_back(this);
+        }
     }
 
-    void Material::SetVector(const AZStd::string& name, const AZ::Vector4& vector)
+    void Material::AddDefaultProperties(const AZStd::vector<MaterialAsset::Property>& defaults)
     {
-        for (auto& property : m_properties)
+        for (const auto& propertyConfig : defaults)
         {
-            if (property.m_type == Property::Type::Vector && property.m_name == name)
+            if (GetPropertySlot(AZ::Crc32(propertyConfig.m_name.c_str())) == InvalidSlot)
             {
-                vector.StoreToFloat4(property.m_vectorValue);
-
-                return;
+                m_properties.emplace_back(propertyConfig);
             }
         }
     }
 
-    void Material::SetTexture(const AZStd::string& name, TexturePtr texture)
+    AZ::s32 Material::GetPropertySlot(AZ::Crc32 name) const
     {
-        for (auto& property : m_properties)
+        for (size_t slot = 0; slot < m_properties.size(); ++slot)
         {
-            if (property.m_type == Property::Type::Texture && property.m_name == name)
+            if (m_properties[slot].m_nameCrc == name)
             {
-                property.m_textureValue = texture;
-                return;
+                return static_cast<AZ::s32>(slot);
             }
         }
+        return InvalidSlot;
+    }
+
+    void Material::SetVectorAt(AZ::s32 slot, const AZ::Vector4& vector)
+    {
+        if (slot >= 0 && static_cast<size_t>(slot) < m_properties.size() && m_properties[slot].m_type == Property::Type::Vector)
+        {
+            vector.StoreToFloat4(m_properties[slot].m_vectorValue);
+        }
+    }
+
+    void Material::SetTextureAt(AZ::s32 slot, TexturePtr texture)
+    {
+        if (slot >= 0 && static_cast<size_t>(slot) < m_properties.size() && m_properties[slot].m_type == Property::Type::Texture)
+        {
+            m_properties[slot].m_textureValue = texture;
+        }
+    }
+
+    const float* Material::GetVectorValue(AZ::Crc32 name) const
+    {
+        const AZ::s32 slot = GetPropertySlot(name);
+        if (slot != InvalidSlot && m_properties[slot].m_type == Property::Type::Vector)
+        {
+            return m_properties[slot].m_vectorValue;
+        }
+        return nullptr;
     }
 
     bool Material::IsValid() const
@@ -134,14 +189,16 @@ namespace Module
         }
     }
 
-    void Material::Apply()
+    void Material::Apply(bgfx::Encoder* encoder, const MaterialPropertyBlock* block)
     {
         if (IsValid())
         {
+            const bool hasOverrides = block != nullptr && !block->IsEmpty();
+
             int textureStage = 0;
             for (auto& property : m_properties)
             {
-                property.Apply(textureStage);
+                property.Apply(encoder, textureStage, hasOverrides ? block->Find(property.m_nameCrc) : nullptr);
                 if (property.m_type == Property::Type::Texture)
                 {
                     ++textureStage;
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Renderer/Asset/MaterialAsset.h"
+#include "Renderer/Base/MaterialPropertyBlock.h"
 #include "Renderer/Base/Texture.h"
 #include "Renderer/Base/Shader.h"
 
@@ -19,6 +20,7 @@ namespace Module
         AZ_RTTI(Material, "{3E966CA9-ABD3-4278-85EB-6DF1082A2B4A}");
 
         explicit Material(const AZStd::string& relativePath);
+        ~Material() override;
 
         // non-copyable
         Material(const Material&) = delete;
@@ -29,19 +31,44 @@ namespace Module
         // AZ::Data::AssetBus::Handler
         void OnAssetReady(AZ::Data::Asset<AZ::Data::AssetData> asset) override;
 
-        void SetVector(const AZStd::string& name, const AZ::Vector4& vector);
-        void SetTexture(const AZStd::string& name, TexturePtr texture);
+        static const AZ::s32 InvalidSlot = -1;
+
+        // Properties are addressed by the crc of their name. The slot of a property stays the same for the lifetime of
+        // the material, callers setting a property every frame resolve it once. Returns InvalidSlot until the
+        // material is loaded or when it has no such property.
+        AZ::s32 GetPropertySlot(AZ::Crc32 name) const;
+
+        void SetVectorAt(AZ::s32 slot, const AZ::Vector4& vector);
+        void SetVector(AZ::Crc32 name, const AZ::Vector4& vector) { SetVectorAt(GetPropertySlot(name), vector); }
+        void SetVector(const AZStd::string& name, const AZ::Vector4& vector) { SetVector(AZ::Crc32(name.c_str()), vector); }
+
+        void SetTextureAt(AZ::s32 slot, TexturePtr texture);
+        void SetTexture(AZ::Crc32 name, TexturePtr texture) { SetTextureAt(GetPropertySlot(name), texture); }
+        void SetTexture(const AZStd::string& name, TexturePtr texture) { SetTexture(AZ::Crc32(name.c_str()), texture); }
+
+        // value of a vector property, nullptr when the material has no such vector
+        const float* GetVectorValue(AZ::Crc32 name) const;
 
         bool IsValid() const;
 
         void SetReverseCull(bool value);
 
-        void Apply();
+        // the entries of `block` replace the values of the matching properties, overrides of unknown names are ignored
+        void Apply(bgfx::Encoder* encoder, const MaterialPropertyBlock* block = nullptr);
 
         AZ::s32 GetQueue() const { return m_queue; }
         void SetQueue(AZ::s32 queue);
 
+        // unique per material instance, used to group draw calls with the same properties
+        AZ::u16 GetSortId() const { return m_sortId; }
+
+        // queues up to AlphaTest are drawn front to back, the rest back to front
+        static bool IsOpaqueQueue(AZ::s32 queue) { return queue <= 2500; }
+
     private:
+        // appends the properties of the shader the material does not declare, with their default values
+        void AddDefaultProperties(const AZStd::vector<MaterialAsset::Property>& defaults);
+
         struct Property
         {
             AZ_CLASS_ALLOCATOR(Property, AZ::SystemAllocator, 0);
@@ -62,10 +89,11 @@ namespace Module
             Property(Property&&) noexcept;
             Property& operator=(Property&&) noexcept;
 
-            void Apply(int textureStage);
+            void Apply(bgfx::Encoder* encoder, int textureStage, const MaterialPropertyBlock::Entry* override);
 
             bgfx::UniformHandle           m_uniform        = BGFX_INVALID_HANDLE;
             AZStd::string                 m_name;
+            AZ::Crc32                     m_nameCrc;
             Type                          m_type           = Type::Vector;
             float                         m_vectorValue[4] = { 0.0f, 0.0f, 0.0f, 0.0f }; // use raw array here to reduce convertion
             TexturePtr                    m_textureValue;
@@ -73,12 +101,14 @@ namespace Module
 
         AZ::Data::Asset<MaterialAsset> m_config;
 
-        AZ::s32                        m_queue = 0;
+        AZ::s32                        m_queue  = 0;
+        AZ::u16                        m_sortId = 0;
         ShaderPtr                      m_shader;
 
         AZStd::vector<Property>        m_properties;
 
         friend class RendererSystemComponent;
+        friend class Shader;
     };
 
     using MaterialPtr = AZStd::shared_ptr<Material>;
@@ -0,0 +1,67 @@
+#include "Renderer/Base/MaterialPropertyBlock.h"
+
+#include <AzCore/RTTI/BehaviorContext.h>
+
+namespace Module
+{
+    void MaterialPropertyBlock::Reflect(AZ::ReflectContext* context)
+    {
+        if (auto behaviorContext = azrtti_cast<AZ::BehaviorContext*>(context))
+        {
+            behaviorContext->Class<MaterialPropertyBlock>("MaterialPropertyBlock")
+                ->Constructor()
+                ->Method("SetVector", static_cast<void (MaterialPropertyBlock::*)(const AZStd::string&, const AZ::Vector4&)>(&MaterialPropertyBlock::SetVector))
+                ->Method("Clear", &MaterialPropertyBlock::Clear)
+                ->Method("IsEmpty", &MaterialPropertyBlock::IsEmpty)
+                ;
+        }
+    }
+
+    void MaterialPropertyBlock::SetVector(AZ::Crc32 name, const AZ::Vector4& vector)
+    {
+        auto& entry = FindOrAdd(name);
+        entry.m_isTexture = false;
+        entry.m_textureValue = nullptr;
+        vector.StoreToFloat4(entry.m_vectorValue);
+    }
+
+    void MaterialPropertyBlock::SetTexture(AZ::Crc32 name, TexturePtr texture)
+    {
+        auto& entry = FindOrAdd(name);
+        entry.m_isTexture = true;
+        entry.m_textureValue = texture;
+    }
+
+    const float* MaterialPropertyBlock::FindVector(AZ::Crc32 name) const
+    {
+        auto entry = Find(name);
+        return entry != nullptr && !entry->m_isTexture ? entry->m_vectorValue : nullptr;
+    }
+
+    const MaterialPropertyBlock::Entry* MaterialPropertyBlock::Find(AZ::Crc32 name) const
+    {
+        for (auto& entry : m_entries)
+        {
+            if (entry.m_name == name)
+            {
+                return &entry;
+            }
+        }
+        return nullptr;
+    }
+
+    MaterialPropertyBlock::Entry& MaterialPropertyBlock::FindOrAdd(AZ::Crc32 name)
+    {
+        for (auto& entry : m_entries)
+        {
+            if (entry.m_name == name)
+            {
+                return entry;
+            }
+        }
+
+        m_entries.emplace_back();
+        m_entries.back().m_name = name;
+        return m_entries.back();
+    }
+}
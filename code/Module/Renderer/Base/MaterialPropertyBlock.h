@@ -0,0 +1,53 @@
+#pragma once
+
+#include "Renderer/Base/Texture.h"
+
+#include <AzCore/Math/Crc.h>
+#include <AzCore/Math/Vector4.h>
+#include <AzCore/Memory/SystemAllocator.h>
+#include <AzCore/RTTI/ReflectContext.h>
+#include <AzCore/std/containers/vector.h>
+
+namespace Module
+{
+    // Per renderer overrides of material properties. The renderer keeps sharing its material, so it still sorts and
+    // batches with the other users of it, the overrides are applied when the node is submitted. Vector overrides of
+    // the instance properties of a pass are written into the instance data and do not break instancing.
+    class MaterialPropertyBlock
+    {
+    public:
+        AZ_CLASS_ALLOCATOR(MaterialPropertyBlock, AZ::SystemAllocator, 0);
+        AZ_TYPE_INFO(MaterialPropertyBlock, "{3C809055-9444-4F95-88A9-EB403DC11E81}");
+
+        static void Reflect(AZ::ReflectContext* context);
+
+        struct Entry
+        {
+            AZ::Crc32  m_name;
+            bool       m_isTexture      = false;
+            float      m_vectorValue[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+            TexturePtr m_textureValue;
+        };
+
+        void SetVector(AZ::Crc32 name, const AZ::Vector4& vector);
+        void SetVector(const AZStd::string& name, const AZ::Vector4& vector) { SetVector(AZ::Crc32(name.c_str()), vector); }
+
+        void SetTexture(AZ::Crc32 name, TexturePtr texture);
+        void SetTexture(const AZStd::string& name, TexturePtr texture) { SetTexture(AZ::Crc32(name.c_str()), texture); }
+
+        // nullptr when the block does not override the vector
+        const float* FindVector(AZ::Crc32 name) const;
+        const Entry* Find(AZ::Crc32 name) const;
+
+        void Clear() { m_entries.clear(); }
+        bool IsEmpty() const { return m_entries.empty(); }
+
+        const AZStd::vector<Entry>& GetEntries() const { return m_entries; }
+
+    private:
+        Entry& FindOrAdd(AZ::Crc32 name);
+
+        // blocks override a handful of properties, a flat array beats any lookup structure
+        AZStd::vector<Entry> m_entries;
+    };
+}
@@ -1,18 +1,49 @@
 #include "Renderer/Base/Mesh.h"
+#include "Renderer/EBus/RendererSystemComponentBus.h"
 
 #include <AzCore/Asset/AssetManager.h>
+#include <AzCore/IO/FileIO.h>
 #include <AzCore/std/smart_ptr/make_shared.h>
 #include <AzCore/RTTI/BehaviorContext.h>
 
 namespace Module
 {
+    namespace
+    {
+        // binary meshes written by MeshConverter are preferred over the xml source
+        AZStd::string FindMeshPath(const AZStd::string& relativePath)
+        {
+            const AZStd::string binaryPath = relativePath + ".mesh";
+            auto* fileIO = AZ::IO::FileIOBase::GetInstance();
+            if (fileIO != nullptr && (fileIO->Exists(("@root@/" + binaryPath).c_str()) || fileIO->Exists(("@assets@/" + binaryPath).c_str())))
+            {
+                return binaryPath;
+            }
+            return relativePath + ".xml";
+        }
+    }
+
+    AZ::u16 Mesh::NextSortId()
+    {
+        static AZ::u16 s_nextSortId = 0;
+        return s_nextSortId++;
+    }
+
+    Mesh::Mesh()
+    {
+        m_static.m_vertexHandle = BGFX_INVALID_HANDLE;
+        m_static.m_indexHandle = BGFX_INVALID_HANDLE;
+    }
+
     Mesh::Mesh(const AZStd::string& relativePath)
+        : Mesh()
     {
-        m_config.Create((relativePath + ".xml").c_str(), true);
+        m_config.Create(FindMeshPath(relativePath).c_str(), true);
         AZ::Data::AssetBus::Handler::BusConnect(m_config.GetId());
     }
 
     Mesh::Mesh(Mesh&& rhv) noexcept
+        : Mesh()
     {
         operator=(AZStd::move(rhv));
     }
@@ -21,15 +52,29 @@ namespace Module
     {
         AZ::Data::AssetBus::Handler::operator=(AZStd::move(rhv));
 
+        // the renderer system holds a pointer to queued meshes, the pending update moves along with the data
+        const bool isQueued = rhv.m_isDirty;
+        if (isQueued)
+        {
+            EBUS_EVENT(RendererSystemRequestBus, ClearMeshDirty, &rhv);
+            rhv.m_isDirty = false;
+        }
+
         m_config = rhv.m_config;
         m_subMeshes = rhv.m_subMeshes;
         m_vertexDesc = rhv.m_vertexDesc;
         m_vertices = rhv.m_vertices;
         m_indices = rhv.m_indices;
+        m_indexSize = rhv.m_indexSize;
+        m_dequantization = rhv.m_dequantization;
+        m_mapped = rhv.m_mapped;
+        m_dirtyVertices = rhv.m_dirtyVertices;
+        m_dirtyIndices = rhv.m_dirtyIndices;
         m_isShared = rhv.m_isShared;
         m_isReady = rhv.m_isReady;
-        m_isDirty = rhv.m_isDirty;
         m_isDynamic = rhv.m_isDynamic;
+        m_aabb = rhv.m_aabb;
+        m_sortId = rhv.m_sortId;
 
         if (m_isDynamic)
         {
@@ -44,11 +89,21 @@ namespace Module
             rhv.m_static.m_indexHandle = BGFX_INVALID_HANDLE;
         }
 
+        if (isQueued)
+        {
+            QueueUpdate();
+        }
+
         return *this;
     }
 
     Mesh::~Mesh()
     {
+        if (m_isDirty)
+        {
+            EBUS_EVENT(RendererSystemRequestBus, ClearMeshDirty, this);
+        }
+
         if (m_isDynamic)
         {
             if (bgfx::isValid(m_dynamic.m_vertexHandle))
@@ -90,11 +145,16 @@ namespace Module
 
         m_subMeshes = meshAsset->m_subMeshes;
         m_vertexDesc = meshAsset->m_vertexDesc;
-        m_vertices = meshAsset->m_vertexBuffer;
-        m_indices = meshAsset->m_indices;
+        m_mapped = meshAsset->m_mapped;
+        m_indexSize = meshAsset->m_indexSize;
+        m_dequantization = meshAsset->m_dequantization;
+        if (!IsMapped())
+        {
+            m_vertices = meshAsset->m_vertexBuffer;
+            m_indices = meshAsset->m_indexBuffer;
+        }
 
         m_isReady = false;
-        m_isDirty = false;
         m_isDynamic = false;
 
         m_aabb = meshAsset->m_aabb;
@@ -107,12 +167,24 @@ namespace Module
         m_isShared = false;
     }
 
+    void Mesh::Unmap()
+    {
+        if (!IsMapped())
+        {
+            return;
+        }
+        m_vertices.assign(m_mapped.m_vertices, m_mapped.m_vertices + m_mapped.m_vertexSize);
+        m_indices.assign(m_mapped.m_indices, m_mapped.m_indices + m_mapped.m_indexCount * m_indexSize);
+        m_mapped = MeshAsset::MappedBuffers();
+    }
+
     void Mesh::MarkDynamic()
     {
         if (m_isDynamic)
         {
             return;
         }
+        Unmap();
         if (bgfx::isValid(m_static.m_vertexHandle))
         {
             bgfx::destroy(m_static.m_vertexHandle);
@@ -121,50 +193,229 @@ namespace Module
         {
             bgfx::destroy(m_static.m_indexHandle);
         }
+        m_static.m_vertexHandle = BGFX_INVALID_HANDLE;
+        m_static.m_indexHandle = BGFX_INVALID_HANDLE;
+
+        // a mesh that is already drawn needs its dynamic buffers before the next submit
+        const bool wasReady = m_isReady;
         m_isReady = false;
-        m_isDirty = false;
         m_isDynamic = true;
+        if (wasReady)
+        {
+            QueueUpdate();
+        }
+
+        // renderers stop sharing the mesh, their static batches, instancing runs and occluders copied the old geometry
+        EBUS_EVENT(RendererSystemRequestBus, MarkMeshRenderersDirty, this);
     }
 
-    void Mesh::ApplySubMesh(size_t index)
+    void Mesh::QueueUpdate()
+    {
+        if (!m_isDirty)
+        {
+            m_isDirty = true;
+            EBUS_EVENT(RendererSystemRequestBus, MarkMeshDirty, this);
+        }
+    }
+
+    void Mesh::Resize(const bgfx::VertexDecl& vertexDecl, AZ::u32 vertexCount, AZ::u32 indexCount)
+    {
+        MarkDynamic();
+
+        // dynamic buffers keep their size, they are created again on the next update
+        if (bgfx::isValid(m_dynamic.m_vertexHandle))
+        {
+            bgfx::destroy(m_dynamic.m_vertexHandle);
+        }
+        if (bgfx::isValid(m_dynamic.m_indexHandle))
+        {
+            bgfx::destroy(m_dynamic.m_indexHandle);
+        }
+        m_dynamic.m_vertexHandle = BGFX_INVALID_HANDLE;
+        m_dynamic.m_indexHandle = BGFX_INVALID_HANDLE;
+        m_isReady = false;
+
+        // the bounds of the previous vertices only belong to their layout, float vertices are stored as they are
+        if (m_vertexDesc.m_hash != vertexDecl.m_hash)
+        {
+            m_dequantization = QuantizeUtil::Dequantization();
+        }
+        m_vertexDesc = vertexDecl;
+        m_vertices.assign(vertexDecl.getSize(vertexCount), 0);
+        m_indexSize = vertexCount > 0x10000 ? sizeof(AZ::u32) : sizeof(AZ::u16);
+        m_indices.assign(size_t(indexCount) * m_indexSize, 0);
+
+        m_subMeshes.resize(1);
+        m_subMeshes[0].m_firstIndex = 0;
+        m_subMeshes[0].m_indexCount = indexCount;
+
+        m_dirtyVertices.Clear();
+        m_dirtyIndices.Clear();
+        QueueUpdate();
+
+        // the draws of the renderers follow the sub meshes
+        EBUS_EVENT(RendererSystemRequestBus, MarkMeshRenderersDirty, this);
+    }
+
+    void Mesh::SetVertices(AZ::u32 firstVertex, const void* vertices, AZ::u32 vertexCount)
+    {
+        MarkDynamic();
+
+        const size_t stride = m_vertexDesc.getStride();
+        AZ_Assert((size_t(firstVertex) + vertexCount) * stride <= m_vertices.size(), "Vertices out of bounds\n");
+
+        memcpy(m_vertices.data() + firstVertex * stride, vertices, vertexCount * stride);
+        m_dirtyVertices.Add(firstVertex, firstVertex + vertexCount);
+        QueueUpdate();
+    }
+
+    void Mesh::SetVertexAttribute(AZ::u32 vertexIndex, bgfx::Attrib::Enum attrib, const float value[4])
+    {
+        MarkDynamic();
+
+        AZ_Assert(m_vertexDesc.has(attrib), "Mesh has no such vertex attribute\n");
+        AZ_Assert(vertexIndex < GetVertexCount(), "Vertex out of bounds\n");
+
+        QuantizeUtil::Pack(value, attrib, m_vertexDesc, m_dequantization, m_vertices.data() + vertexIndex * m_vertexDesc.getStride());
+        m_dirtyVertices.Add(vertexIndex, vertexIndex + 1);
+        QueueUpdate();
+    }
+
+    template <typename IndexType>
+    void Mesh::WriteIndices(AZ::u32 firstIndex, const IndexType* indices, AZ::u32 indexCount)
+    {
+        MarkDynamic();
+
+        AZ_Assert(size_t(firstIndex) + indexCount <= GetIndexCount(), "Indices out of bounds\n");
+
+        if (m_indexSize == sizeof(IndexType))
+        {
+            memcpy(m_indices.data() + size_t(firstIndex) * m_indexSize, indices, indexCount * sizeof(IndexType));
+        }
+        else if (m_indexSize == sizeof(AZ::u32))
+        {
+            auto* destination = reinterpret_cast<AZ::u32*>(m_indices.data()) + firstIndex;
+            for (AZ::u32 i = 0; i < indexCount; ++i)
+            {
+                destination[i] = indices[i];
+            }
+        }
+        else
+        {
+            auto* destination = reinterpret_cast<AZ::u16*>(m_indices.data()) + firstIndex;
+            for (AZ::u32 i = 0; i < indexCount; ++i)
+            {
+                AZ_Assert(indices[i] <= 0xFFFF, "Index out of range of the 16 bit indices of the mesh\n");
+                destination[i] = static_cast<AZ::u16>(indices[i]);
+            }
+        }
+        m_dirtyIndices.Add(firstIndex, firstIndex + indexCount);
+        QueueUpdate();
+    }
+
+    void Mesh::SetIndices(AZ::u32 firstIndex, const AZ::u16* indices, AZ::u32 indexCount)
+    {
+        WriteIndices(firstIndex, indices, indexCount);
+    }
+
+    void Mesh::SetIndices(AZ::u32 firstIndex, const AZ::u32* indices, AZ::u32 indexCount)
+    {
+        WriteIndices(firstIndex, indices, indexCount);
+    }
+
+    void Mesh::UpdateBuffers()
     {
-        AZ_Assert(index < m_subMeshes.size(), "Sub mesh out of bounds\n");
         if (!m_isReady)
         {
             m_isReady = true;
+            const uint16_t indexFlags = m_indexSize == sizeof(AZ::u32) ? BGFX_BUFFER_INDEX32 : BGFX_BUFFER_NONE;
             if (m_isDynamic)
             {
-                m_dynamic.m_vertexHandle = bgfx::createDynamicVertexBuffer(bgfx::copy(m_vertices.data(), m_vertices.size()), m_vertexDesc);
-                m_dynamic.m_indexHandle = bgfx::createDynamicIndexBuffer(bgfx::copy(m_indices.data(), m_indices.size()));
+                m_dynamic.m_vertexHandle = bgfx::createDynamicVertexBuffer(bgfx::copy(m_vertices.data(), static_cast<uint32_t>(m_vertices.size())), m_vertexDesc);
+                m_dynamic.m_indexHandle = bgfx::createDynamicIndexBuffer(bgfx::copy(m_indices.data(), static_cast<uint32_t>(m_indices.size())), indexFlags);
+            }
+            else if (IsMapped())
+            {
+                // the gpu upload reads straight from the mapped file, each reference holds the mapping until it is released
+                m_static.m_vertexHandle = bgfx::createVertexBuffer(MappedFile::MakeRef(m_mapped.m_file, m_mapped.m_vertices, m_mapped.m_vertexSize), m_vertexDesc);
+                m_static.m_indexHandle = bgfx::createIndexBuffer(MappedFile::MakeRef(m_mapped.m_file, m_mapped.m_indices, m_mapped.m_indexCount * m_indexSize), indexFlags);
             }
             else
             {
-                m_static.m_vertexHandle = bgfx::createVertexBuffer(bgfx::copy(m_vertices.data(), m_vertices.size()), m_vertexDesc);
-                m_static.m_indexHandle = bgfx::createIndexBuffer(bgfx::copy(m_indices.data(), m_indices.size()));
+                m_static.m_vertexHandle = bgfx::createVertexBuffer(bgfx::copy(m_vertices.data(), static_cast<uint32_t>(m_vertices.size())), m_vertexDesc);
+                m_static.m_indexHandle = bgfx::createIndexBuffer(bgfx::copy(m_indices.data(), static_cast<uint32_t>(m_indices.size())), indexFlags);
             }
+
+            // the buffers were just created from the whole mesh
+            m_dirtyVertices.Clear();
+            m_dirtyIndices.Clear();
+            return;
+        }
+
+        if (!m_isDynamic)
+        {
+            return;
         }
+
+        AZ_Assert(bgfx::isValid(m_dynamic.m_vertexHandle) && bgfx::isValid(m_dynamic.m_indexHandle), "Dynamic handle is not valid!\n");
+
+        // only the written ranges are copied, the vertices may change again before bgfx consumes the memory
+        const AZ::u32 stride = m_vertexDesc.getStride();
+        for (const auto& range : m_dirtyVertices.GetRanges())
+        {
+            bgfx::updateDynamicVertexBuffer(m_dynamic.m_vertexHandle, range.m_begin, bgfx::copy(m_vertices.data() + range.m_begin * stride, (range.m_end - range.m_begin) * stride));
+        }
+        for (const auto& range : m_dirtyIndices.GetRanges())
+        {
+            bgfx::updateDynamicIndexBuffer(m_dynamic.m_indexHandle, range.m_begin, bgfx::copy(m_indices.data() + range.m_begin * m_indexSize, (range.m_end - range.m_begin) * m_indexSize));
+        }
+        m_dirtyVertices.Clear();
+        m_dirtyIndices.Clear();
+    }
+
+    void Mesh::ApplySubMesh(bgfx::Encoder* encoder, size_t index) const
+    {
+        AZ_Assert(index < m_subMeshes.size(), "Sub mesh out of bounds\n");
+        ApplyRange(encoder, m_subMeshes[index].m_firstIndex, m_subMeshes[index].m_indexCount);
+    }
+
+    void Mesh::ApplyRange(bgfx::Encoder* encoder, AZ::u32 firstIndex, AZ::u32 indexCount) const
+    {
+        AZ_Assert(m_isReady, "Mesh buffers have to be updated before the mesh is applied\n");
+
         if (m_isDynamic)
         {
-            if (m_isDirty)
-            {
-                AZ_Assert(bgfx::isValid(m_dynamic.m_vertexHandle) && bgfx::isValid(m_dynamic.m_indexHandle), "Dynamic handle is not valid!\n");
-                bgfx::updateDynamicVertexBuffer(m_dynamic.m_vertexHandle, 0, bgfx::copy(m_vertices.data(), m_vertices.size())); // TODO only update dirty part
-                bgfx::updateDynamicIndexBuffer(m_dynamic.m_indexHandle, 0, bgfx::copy(m_indices.data(), m_indices.size())); // TODO only update dirty part
-            }
-            bgfx::setVertexBuffer(0, m_dynamic.m_vertexHandle);
-            bgfx::setIndexBuffer(m_dynamic.m_indexHandle, m_subMeshes[index].m_firstIndex, m_subMeshes[index].m_indexCount);
+            encoder->setVertexBuffer(0, m_dynamic.m_vertexHandle);
+            encoder->setIndexBuffer(m_dynamic.m_indexHandle, firstIndex, indexCount);
         }
         else
         {
-            bgfx::setVertexBuffer(0, m_static.m_vertexHandle);
-            bgfx::setIndexBuffer(m_static.m_indexHandle, m_subMeshes[index].m_firstIndex, m_subMeshes[index].m_indexCount);
+            encoder->setVertexBuffer(0, m_static.m_vertexHandle);
+            encoder->setIndexBuffer(m_static.m_indexHandle, firstIndex, indexCount);
         }
     }
 
     MeshPtr Mesh::Clone()
     {
         auto mesh = AZStd::make_shared<Mesh>();
-        // TODO
+
+        // a mesh which is still loading hands the clone its asset, the clone copies it once it is ready
+        if (m_config.Get() != nullptr)
+        {
+            mesh->m_config = m_config;
+            mesh->AZ::Data::AssetBus::Handler::BusConnect(m_config.GetId());
+        }
+
+        mesh->m_subMeshes = m_subMeshes;
+        mesh->m_vertexDesc = m_vertexDesc;
+        mesh->m_vertices.assign(GetVertexData(), GetVertexData() + GetVertexDataSize());
+        mesh->m_indices.assign(GetIndexData(), GetIndexData() + GetIndexCount() * m_indexSize);
+        mesh->m_indexSize = m_indexSize;
+        mesh->m_dequantization = m_dequantization;
+        mesh->m_aabb = m_aabb;
+
+        // the clone is owned by the caller, the renderer drawing it creates its buffers like those of a loaded mesh
+        mesh->m_isShared = false;
         return mesh;
     }
 }
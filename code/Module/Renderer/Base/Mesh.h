@@ -5,6 +5,8 @@
 #include <AzCore/Math/Aabb.h>
 
 #include "Renderer/Asset/MeshAsset.h"
+#include "Renderer/Base/DirtyRangeSet.h"
+#include "Renderer/Util/QuantizeUtil.h"
 
 #include <bgfx/bgfx.h>
 
@@ -20,7 +22,7 @@ namespace Module
         AZ_CLASS_ALLOCATOR(Mesh, AZ::SystemAllocator, 0);
         AZ_RTTI(Mesh, "{12B6EF31-2282-4C05-83F3-69365D40058B}");
 
-        Mesh() {}
+        Mesh();
         explicit Mesh(const AZStd::string& relativePath);
 
         // non-copyable
@@ -43,11 +45,78 @@ namespace Module
         void MarkUnique();
         void MarkDynamic();
 
-        void ApplySubMesh(size_t index);
+        bool IsDynamic() const { return m_isDynamic; }
 
+        size_t GetSubMeshCount() const { return m_subMeshes.size(); }
+
+        AZ::u32 GetSubMeshIndexCount(size_t index) const { return index < m_subMeshes.size() ? m_subMeshes[index].m_indexCount : 0; }
+
+        const bgfx::VertexDecl& GetVertexDecl() const { return m_vertexDesc; }
+
+        // binary meshes reference their vertices and indices inside the mapped file until the mesh is modified
+        bool IsMapped() const { return m_mapped.m_file != nullptr; }
+
+        const char* GetVertexData() const { return IsMapped() ? m_mapped.m_vertices : m_vertices.data(); }
+        size_t GetVertexDataSize() const { return IsMapped() ? m_mapped.m_vertexSize : m_vertices.size(); }
+
+        // indices are 16 bit unless the mesh has more than 65536 vertices
+        AZ::u32 GetIndexSize() const { return m_indexSize; }
+
+        const char* GetIndexData() const { return IsMapped() ? m_mapped.m_indices : m_indices.data(); }
+        size_t GetIndexCount() const { return IsMapped() ? m_mapped.m_indexCount : m_indices.size() / m_indexSize; }
+
+        AZ::u32 GetIndex(size_t index) const
+        {
+            const char* indices = GetIndexData();
+            return m_indexSize == sizeof(AZ::u32) ? reinterpret_cast<const AZ::u32*>(indices)[index] : reinterpret_cast<const AZ::u16*>(indices)[index];
+        }
+
+        size_t GetVertexCount() const { return m_vertexDesc.getStride() > 0 ? GetVertexDataSize() / m_vertexDesc.getStride() : 0; }
+
+        // scale and offset of the quantized positions and texcoords, identity for float attributes
+        const QuantizeUtil::Dequantization& GetDequantization() const { return m_dequantization; }
+
+        // The mutation functions make the mesh dynamic and only upload the written ranges on the next tick, meshes
+        // returned by the renderer system are shared and have to be cloned or marked unique before they are modified.
+        // Resize picks 32 bit indices for more than 65536 vertices, both index types can be written to either size.
+        void Resize(const bgfx::VertexDecl& vertexDecl, AZ::u32 vertexCount, AZ::u32 indexCount);
+        void SetVertices(AZ::u32 firstVertex, const void* vertices, AZ::u32 vertexCount);
+        void SetVertexAttribute(AZ::u32 vertexIndex, bgfx::Attrib::Enum attrib, const float value[4]);
+        void SetIndices(AZ::u32 firstIndex, const AZ::u16* indices, AZ::u32 indexCount);
+        void SetIndices(AZ::u32 firstIndex, const AZ::u32* indices, AZ::u32 indexCount);
+
+        // creates or updates the gpu buffers, must be called on the main thread before the mesh is applied
+        void UpdateBuffers();
+
+        // the apply functions only read the mesh and can be called from several encoder threads at once
+        void ApplySubMesh(bgfx::Encoder* encoder, size_t index) const;
+
+        // binds an arbitrary index range, used to draw runs of merged sub meshes in static batches
+        void ApplyRange(bgfx::Encoder* encoder, AZ::u32 firstIndex, AZ::u32 indexCount) const;
+
+        const AZ::Aabb& GetAabb() const { return m_aabb; }
+
+        // renderers read the bounds when they become dirty, set them before the mesh is assigned to a renderer
+        void SetAabb(const AZ::Aabb& aabb) { m_aabb = aabb; }
+
+        // unique per mesh instance, used to keep draw calls of the same geometry adjacent
+        AZ::u16 GetSortId() const { return m_sortId; }
+
+        // copy of the geometry which is not shared, a mesh still loading passes its asset on to the clone
         MeshPtr Clone();
 
     private:
+        static AZ::u16 NextSortId();
+
+        // copies the mapped vertices and indices into memory owned by the mesh
+        void Unmap();
+
+        // asks the renderer system to call UpdateBuffers on its next tick
+        void QueueUpdate();
+
+        template <typename IndexType>
+        void WriteIndices(AZ::u32 firstIndex, const IndexType* indices, AZ::u32 indexCount);
+
         AZ::Data::Asset<MeshAsset>            m_config;
         
         AZStd::vector<MeshAsset::SubMesh>     m_subMeshes;
@@ -55,27 +124,40 @@ namespace Module
         bgfx::VertexDecl                      m_vertexDesc;
 
         AZStd::vector<char>                   m_vertices;
-        AZStd::vector<AZ::u16>                m_indices;
+        AZStd::vector<char>                   m_indices;       // m_indexSize bytes per index
+        AZ::u32                               m_indexSize = sizeof(AZ::u16);
+
+        QuantizeUtil::Dequantization          m_dequantization;
+
+        MeshAsset::MappedBuffers              m_mapped;
+
+        DirtyRangeSet                         m_dirtyVertices;
+        DirtyRangeSet                         m_dirtyIndices;
 
         bool                                  m_isShared  = true;
         bool                                  m_isReady   = false;
-        bool                                  m_isDirty   = false;
+        bool                                  m_isDirty   = false; // queued for UpdateBuffers in the renderer system
         bool                                  m_isDynamic = false;
 
-        AZ::Aabb                              m_aabb;
+        AZ::Aabb                              m_aabb      = AZ::Aabb::CreateNull();
+        AZ::u16                               m_sortId    = NextSortId();
 
+        // both handle pairs share their storage, the constructors invalidate them
         union
         {
             struct
             {
-                bgfx::VertexBufferHandle m_vertexHandle = BGFX_INVALID_HANDLE;
-                bgfx::IndexBufferHandle  m_indexHandle  = BGFX_INVALID_HANDLE;
+                bgfx::VertexBufferHandle m_vertexHandle;
+                bgfx::IndexBufferHandle  m_indexHandle;
             } m_static;
             struct
             {
-                bgfx::DynamicVertexBufferHandle m_vertexHandle = BGFX_INVALID_HANDLE;
-                bgfx::DynamicIndexBufferHandle  m_indexHandle  = BGFX_INVALID_HANDLE;
+                bgfx::DynamicVertexBufferHandle m_vertexHandle;
+                bgfx::DynamicIndexBufferHandle  m_indexHandle;
             } m_dynamic;
         };
+
+        friend class BatchUtil;
+        friend class RendererSystemComponent;
     };
 }
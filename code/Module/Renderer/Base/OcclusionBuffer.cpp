@@ -0,0 +1,326 @@
+#include "Renderer/Base/OcclusionBuffer.h"
+
+#include <AzCore/Math/Matrix4x4.h>
+#include <AzCore/Math/Vector4.h>
+#include <AzCore/std/algorithm.h>
+
+#include <float.h>
+#include <math.h>
+#include <string.h>
+
+namespace Module
+{
+    namespace
+    {
+        // closer to the camera than this the projection is not worth trusting
+        const float k_minW = 1e-4f;
+
+        // triangles covering less than this in pixels are too thin to hide anything
+        const float k_minArea = 1e-3f;
+
+#if defined(AZ_SIMD)
+        struct Float4
+        {
+            AZ::SimdVectorType m_value;
+
+            static Float4 Splat(float value)                        { return { _mm_set1_ps(value) }; }
+            static Float4 Set(float x, float y, float z, float w)   { return { _mm_setr_ps(x, y, z, w) }; }
+            static Float4 Load(const float* values)                 { return { _mm_loadu_ps(values) }; }
+            void Store(float* values) const                         { _mm_storeu_ps(values, m_value); }
+        };
+
+        Float4 operator+(const Float4& lhv, const Float4& rhv)   { return { _mm_add_ps(lhv.m_value, rhv.m_value) }; }
+        Float4 operator*(const Float4& lhv, const Float4& rhv)   { return { _mm_mul_ps(lhv.m_value, rhv.m_value) }; }
+        Float4 operator&(const Float4& lhv, const Float4& rhv)   { return { _mm_and_ps(lhv.m_value, rhv.m_value) }; }
+        Float4 Min(const Float4& lhv, const Float4& rhv)         { return { _mm_min_ps(lhv.m_value, rhv.m_value) }; }
+        Float4 GreaterEqual(const Float4& lhv, const Float4& rhv) { return { _mm_cmpge_ps(lhv.m_value, rhv.m_value) }; }
+        Float4 LessEqual(const Float4& lhv, const Float4& rhv)   { return { _mm_cmple_ps(lhv.m_value, rhv.m_value) }; }
+
+        // lanes of `mask` take `lhv`, the others `rhv`
+        Float4 Select(const Float4& mask, const Float4& lhv, const Float4& rhv)
+        {
+            return { _mm_or_ps(_mm_and_ps(mask.m_value, lhv.m_value), _mm_andnot_ps(mask.m_value, rhv.m_value)) };
+        }
+
+        bool Any(const Float4& mask) { return _mm_movemask_ps(mask.m_value) != 0; }
+#else
+        // the same operations one lane at a time, masks are 1 or 0
+        struct Float4
+        {
+            float m_values[4];
+
+            static Float4 Splat(float value)                        { return { { value, value, value, value } }; }
+            static Float4 Set(float x, float y, float z, float w)   { return { { x, y, z, w } }; }
+            static Float4 Load(const float* values)                 { return { { values[0], values[1], values[2], values[3] } }; }
+            void Store(float* values) const                         { memcpy(values, m_values, sizeof(m_values)); }
+        };
+
+        template <typename Operation>
+        Float4 PerLane(const Float4& lhv, const Float4& rhv, const Operation& operation)
+        {
+            Float4 result;
+            for (int i = 0; i < 4; ++i)
+            {
+                result.m_values[i] = operation(lhv.m_values[i], rhv.m_values[i]);
+            }
+            return result;
+        }
+
+        Float4 operator+(const Float4& lhv, const Float4& rhv)   { return PerLane(lhv, rhv, [](float l, float r) { return l + r; }); }
+        Float4 operator*(const Float4& lhv, const Float4& rhv)   { return PerLane(lhv, rhv, [](float l, float r) { return l * r; }); }
+        Float4 operator&(const Float4& lhv, const Float4& rhv)   { return PerLane(lhv, rhv, [](float l, float r) { return l != 0.0f && r != 0.0f ? 1.0f : 0.0f; }); }
+        Float4 Min(const Float4& lhv, const Float4& rhv)         { return PerLane(lhv, rhv, [](float l, float r) { return l < r ? l : r; }); }
+        Float4 GreaterEqual(const Float4& lhv, const Float4& rhv) { return PerLane(lhv, rhv, [](float l, float r) { return l >= r ? 1.0f : 0.0f; }); }
+        Float4 LessEqual(const Float4& lhv, const Float4& rhv)   { return PerLane(lhv, rhv, [](float l, float r) { return l <= r ? 1.0f : 0.0f; }); }
+
+        Float4 Select(const Float4& mask, const Float4& lhv, const Float4& rhv)
+        {
+            Float4 result;
+            for (int i = 0; i < 4; ++i)
+            {
+                result.m_values[i] = mask.m_values[i] != 0.0f ? lhv.m_values[i] : rhv.m_values[i];
+            }
+            return result;
+        }
+
+        bool Any(const Float4& mask)
+        {
+            return mask.m_values[0] != 0.0f || mask.m_values[1] != 0.0f || mask.m_values[2] != 0.0f || mask.m_values[3] != 0.0f;
+        }
+#endif
+
+        // position on the buffer, x and y in pixels, z the depth, w 1 in front of the near plane and 0 behind it
+        void Project(const AZ::Matrix4x4& viewProjection, const AZ::Vector3& position, float* vertex)
+        {
+            const AZ::Vector4 clip = AZ::Vector4::CreateFromVector3(position) * viewProjection;
+            const float w = clip.GetW();
+            if (w < k_minW)
+            {
+                vertex[3] = 0.0f;
+                return;
+            }
+
+            const float invW = 1.0f / w;
+            vertex[0] = (float(clip.GetX()) * invW * 0.5f + 0.5f) * float(OcclusionBuffer::Width);
+            vertex[1] = (0.5f - float(clip.GetY()) * invW * 0.5f) * float(OcclusionBuffer::Height);
+            vertex[2] = float(clip.GetZ()) * invW;
+            vertex[3] = 1.0f;
+        }
+    }
+
+    void OcclusionBuffer::Begin(const float* viewProjection)
+    {
+        memcpy(m_viewProjection, viewProjection, sizeof(m_viewProjection));
+        m_depth.assign(Width * Height, FLT_MAX);
+        m_triangleCount = 0;
+    }
+
+    void OcclusionBuffer::Rasterize(const AZ::Vector3* positions, AZ::u32 vertexCount, const AZ::u32* indices, AZ::u32 indexCount)
+    {
+        const AZ::Matrix4x4 viewProjection = AZ::Matrix4x4::CreateFromRowMajorFloat16(m_viewProjection);
+
+        m_vertices.resize(vertexCount * 4);
+        for (AZ::u32 i = 0; i < vertexCount; ++i)
+        {
+            Project(viewProjection, positions[i], &m_vertices[i * 4]);
+        }
+
+        for (AZ::u32 i = 0; i + 2 < indexCount; i += 3)
+        {
+            const float* a = &m_vertices[indices[i] * 4];
+            const float* b = &m_vertices[indices[i + 1] * 4];
+            const float* c = &m_vertices[indices[i + 2] * 4];
+            if (a[3] != 0.0f && b[3] != 0.0f && c[3] != 0.0f)
+            {
+                RasterizeTriangle(a, b, c);
+            }
+        }
+    }
+
+    void OcclusionBuffer::RasterizeTriangle(const float* a, const float* b, const float* c)
+    {
+        // both windings are drawn, the edge functions below are positive inside a counter clockwise triangle
+        float area = (b[0] - a[0]) * (c[1] - a[1]) - (c[0] - a[0]) * (b[1] - a[1]);
+        if (area < 0.0f)
+        {
+            AZStd::swap(b, c);
+            area = -area;
+        }
+        if (area < k_minArea)
+        {
+            return;
+        }
+
+        // pixels whose center is inside the bounds of the triangle, the first column is aligned to 4 pixels
+        const int minX = AZStd::GetMax(0, static_cast<int>(ceilf(AZStd::GetMin(a[0], AZStd::GetMin(b[0], c[0])) - 0.5f))) & ~3;
+        const int maxX = AZStd::GetMin(static_cast<int>(Width) - 1, static_cast<int>(floorf(AZStd::GetMax(a[0], AZStd::GetMax(b[0], c[0])) - 0.5f)));
+        const int minY = AZStd::GetMax(0, static_cast<int>(ceilf(AZStd::GetMin(a[1], AZStd::GetMin(b[1], c[1])) - 0.5f)));
+        const int maxY = AZStd::GetMin(static_cast<int>(Height) - 1, static_cast<int>(floorf(AZStd::GetMax(a[1], AZStd::GetMax(b[1], c[1])) - 0.5f)));
+        if (minX > maxX || minY > maxY)
+        {
+            return;
+        }
+        ++m_triangleCount;
+
+        // edge function of the edge from p to q at (x, y) is stepX * x + stepY * y + offset
+        struct Edge
+        {
+            float m_stepX;
+            float m_stepY;
+            float m_offset;
+        };
+        const auto makeEdge = [](const float* p, const float* q)
+        {
+            Edge edge;
+            edge.m_stepX = p[1] - q[1];
+            edge.m_stepY = q[0] - p[0];
+            edge.m_offset = -(edge.m_stepX * p[0] + edge.m_stepY * p[1]);
+            return edge;
+        };
+        const Edge edges[3] = { makeEdge(b, c), makeEdge(c, a), makeEdge(a, b) };
+
+        // the depth is linear in screen space, the edges opposite to b and c weight their depth
+        const Float4 depthA = Float4::Splat(a[2]);
+        const Float4 depthB = Float4::Splat((b[2] - a[2]) / area);
+        const Float4 depthC = Float4::Splat((c[2] - a[2]) / area);
+        const Float4 zero = Float4::Splat(0.0f);
+        const Float4 lanes = Float4::Set(0.0f, 1.0f, 2.0f, 3.0f);
+
+        Float4 steps[3];
+        Float4 laneOffsets[3];
+        for (int i = 0; i < 3; ++i)
+        {
+            steps[i] = Float4::Splat(edges[i].m_stepX * 4.0f);
+            laneOffsets[i] = lanes * Float4::Splat(edges[i].m_stepX);
+        }
+
+        for (int y = minY; y <= maxY; ++y)
+        {
+            const float centerX = float(minX) + 0.5f;
+            const float centerY = float(y) + 0.5f;
+
+            Float4 values[3];
+            for (int i = 0; i < 3; ++i)
+            {
+                values[i] = Float4::Splat(edges[i].m_stepX * centerX + edges[i].m_stepY * centerY + edges[i].m_offset) + laneOffsets[i];
+            }
+
+            float* row = &m_depth[y * Width];
+            for (int x = minX; x <= maxX; x += 4)
+            {
+                const Float4 inside = GreaterEqual(values[0], zero) & GreaterEqual(values[1], zero) & GreaterEqual(values[2], zero);
+                if (Any(inside))
+                {
+                    const Float4 depth = depthA + values[1] * depthB + values[2] * depthC;
+                    const Float4 stored = Float4::Load(row + x);
+                    Select(inside, Min(stored, depth), stored).Store(row + x);
+                }
+
+                for (int i = 0; i < 3; ++i)
+                {
+                    values[i] = values[i] + steps[i];
+                }
+            }
+        }
+    }
+
+    void OcclusionBuffer::End()
+    {
+        for (AZ::u32 tileY = 0; tileY < TileRows; ++tileY)
+        {
+            for (AZ::u32 tileX = 0; tileX < TileColumns; ++tileX)
+            {
+                float farthest = 0.0f;
+                for (AZ::u32 y = tileY * TileSize; y < (tileY + 1) * TileSize; ++y)
+                {
+                    const float* row = &m_depth[y * Width + tileX * TileSize];
+                    for (AZ::u32 x = 0; x < TileSize; ++x)
+                    {
+                        farthest = AZStd::GetMax(farthest, row[x]);
+                    }
+                }
+                m_tileDepth[tileY * TileColumns + tileX] = farthest;
+            }
+        }
+    }
+
+    bool OcclusionBuffer::IsOccluded(const AZ::Aabb& bounds) const
+    {
+        if (m_triangleCount == 0)
+        {
+            return false;
+        }
+
+        const AZ::Matrix4x4 viewProjection = AZ::Matrix4x4::CreateFromRowMajorFloat16(m_viewProjection);
+        const AZ::Vector3& boundsMin = bounds.GetMin();
+        const AZ::Vector3& boundsMax = bounds.GetMax();
+
+        // screen rectangle and closest depth of the corners
+        float minX = FLT_MAX, minY = FLT_MAX, maxX = -FLT_MAX, maxY = -FLT_MAX, closest = FLT_MAX;
+        for (int corner = 0; corner < 8; ++corner)
+        {
+            const AZ::Vector3 position(corner & 1 ? boundsMax.GetX() : boundsMin.GetX(),
+                                       corner & 2 ? boundsMax.GetY() : boundsMin.GetY(),
+                                       corner & 4 ? boundsMax.GetZ() : boundsMin.GetZ());
+            float vertex[4];
+            Project(viewProjection, position, vertex);
+            if (vertex[3] == 0.0f)
+            {
+                return false;
+            }
+
+            minX = AZStd::GetMin(minX, vertex[0]);
+            maxX = AZStd::GetMax(maxX, vertex[0]);
+            minY = AZStd::GetMin(minY, vertex[1]);
+            maxY = AZStd::GetMax(maxY, vertex[1]);
+            closest = AZStd::GetMin(closest, vertex[2]);
+        }
+
+        // every pixel the rectangle touches, not only those whose center it covers
+        const int x0 = AZStd::GetMax(0, static_cast<int>(floorf(minX)));
+        const int x1 = AZStd::GetMin(static_cast<int>(Width) - 1, static_cast<int>(floorf(maxX)));
+        const int y0 = AZStd::GetMax(0, static_cast<int>(floorf(minY)));
+        const int y1 = AZStd::GetMin(static_cast<int>(Height) - 1, static_cast<int>(floorf(maxY)));
+        if (x0 > x1 || y0 > y1)
+        {
+            return false;
+        }
+
+        const Float4 closest4 = Float4::Splat(closest);
+        const Float4 lanes = Float4::Set(0.0f, 1.0f, 2.0f, 3.0f);
+
+        for (int tileY = y0 / int(TileSize); tileY <= y1 / int(TileSize); ++tileY)
+        {
+            for (int tileX = x0 / int(TileSize); tileX <= x1 / int(TileSize); ++tileX)
+            {
+                // all of the tile is closer than the box
+                if (m_tileDepth[tileY * TileColumns + tileX] < closest)
+                {
+                    continue;
+                }
+
+                const int tileX0 = AZStd::GetMax(x0, tileX * int(TileSize));
+                const int tileX1 = AZStd::GetMin(x1, tileX * int(TileSize) + int(TileSize) - 1);
+                const int tileY0 = AZStd::GetMax(y0, tileY * int(TileSize));
+                const int tileY1 = AZStd::GetMin(y1, tileY * int(TileSize) + int(TileSize) - 1);
+                const Float4 first = Float4::Splat(float(tileX0));
+                const Float4 last = Float4::Splat(float(tileX1));
+
+                for (int y = tileY0; y <= tileY1; ++y)
+                {
+                    const float* row = &m_depth[y * Width];
+                    for (int x = tileX0 & ~3; x <= tileX1; x += 4)
+                    {
+                        const Float4 column = Float4::Splat(float(x)) + lanes;
+                        const Float4 inside = GreaterEqual(column, first) & LessEqual(column, last);
+                        if (Any(inside & GreaterEqual(Float4::Load(row + x), closest4)))
+                        {
+                            return false;
+                        }
+                    }
+                }
+            }
+        }
+        return true;
+    }
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <AzCore/Math/Aabb.h>
+#include <AzCore/Math/Vector3.h>
+#include <AzCore/Memory/SystemAllocator.h>
+#include <AzCore/std/containers/vector.h>
+
+namespace Module
+{
+    // Low resolution depth buffer of one camera, rasterized on the CPU from the occluders of the culling scene.
+    // Every tile keeps the farthest depth written into it, so bounds behind a whole tile are rejected without looking
+    // at its pixels. The rasterizer and the tests work on 4 pixels at once with the SIMD types of AzCore when
+    // AZ_SIMD is defined. Depth is the projected z / w, smaller values are closer.
+    class OcclusionBuffer
+    {
+    public:
+        AZ_CLASS_ALLOCATOR(OcclusionBuffer, AZ::SystemAllocator, 0);
+
+        static const AZ::u32 Width    = 256;
+        static const AZ::u32 Height   = 128;
+        static const AZ::u32 TileSize = 8;
+
+        // clears the buffer for a bx style (row vector) view projection matrix
+        void Begin(const float* viewProjection);
+
+        // Draws triangles of world space positions, three indices each. Both sides are drawn and triangles crossing
+        // the near plane are skipped, which only lets less through as occluded.
+        void Rasterize(const AZ::Vector3* positions, AZ::u32 vertexCount, const AZ::u32* indices, AZ::u32 indexCount);
+
+        // updates the tile depths, the buffer can be tested afterwards
+        void End();
+
+        // whether the box is behind the occluders at every pixel it touches, boxes crossing the near plane never are
+        bool IsOccluded(const AZ::Aabb& bounds) const;
+
+        AZ::u32 GetTriangleCount() const { return m_triangleCount; }
+
+    private:
+        static const AZ::u32 TileColumns = Width / TileSize;
+        static const AZ::u32 TileRows    = Height / TileSize;
+
+        // vertices are the screen x and y, the depth and whether the vertex is in front of the near plane
+        void RasterizeTriangle(const float* a, const float* b, const float* c);
+
+        float                m_viewProjection[16] = {};
+        AZStd::vector<float> m_depth;                          // Width x Height, rows from the top
+        float                m_tileDepth[TileColumns * TileRows] = {}; // farthest depth of every tile
+        AZStd::vector<float> m_vertices;                       // transformed positions of a Rasterize call
+        AZ::u32              m_triangleCount = 0;
+    };
+}
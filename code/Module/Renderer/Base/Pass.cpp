@@ -1,64 +1,35 @@
 #include "Renderer/Base/Pass.h"
+#include "Renderer/Base/MaterialPropertyBlock.h"
 
-namespace Module
-{
-    Pass::Pass(const ShaderAsset::Pass& config)
-    {
-        m_vs.Create(config.m_vs.c_str(), true);
-        m_fs.Create(config.m_fs.c_str(), true);
+#include "Renderer/EBus/RendererSystemComponentBus.h"
 
-        AZ::Data::AssetBus::MultiHandler::BusConnect(m_vs.GetId());
-        AZ::Data::AssetBus::MultiHandler::BusConnect(m_fs.GetId());
+#include <AzCore/std/algorithm.h>
 
-        m_defaultRs = m_rs = config.m_rs;
-    }
-
-    Pass::Pass(Pass&& rhv) noexcept
+namespace Module
+{
+    namespace
     {
-        operator=(AZStd::move(rhv));
+        // bgfx passes at most five vec4 of instance data per instance, four of them hold the model matrix
+        const size_t k_maxInstanceProperties = 1;
     }
 
-    Pass& Pass::operator=(Pass&& rhv) noexcept
+    Pass::Pass(const ShaderAsset::Pass& config)
     {
-        AZ::Data::AssetBus::MultiHandler::operator=(AZStd::move(rhv));
+        EBUS_EVENT_RESULT(m_program, RendererSystemRequestBus, GetProgram, config.m_vs, config.m_fs);
 
-        if (bgfx::isValid(m_program))
+        // both programs share the fragment shader
+        if (!config.m_vsInstanced.empty())
         {
-            bgfx::destroy(m_program);
+            EBUS_EVENT_RESULT(m_instancedProgram, RendererSystemRequestBus, GetProgram, config.m_vsInstanced, config.m_fs);
         }
 
-        m_vs = rhv.m_vs;
-        m_fs = rhv.m_fs;
-        m_program = rhv.m_program;
-        m_defaultRs = rhv.m_defaultRs;
-        m_rs = rhv.m_rs;
-
-        rhv.m_program = BGFX_INVALID_HANDLE;
-
-        return *this;
-    }
+        m_defaultRs = m_rs = config.m_rs;
 
-    Pass::~Pass()
-    {
-        if (bgfx::isValid(m_program))
+        AZ_Warning("Renderer", config.m_instanceProperties.size() <= k_maxInstanceProperties,
+            "Pass %s has more instance properties than fit into the instance data\n", config.m_name.c_str());
+        for (size_t i = 0; i < config.m_instanceProperties.size() && i < k_maxInstanceProperties; ++i)
         {
-            bgfx::destroy(m_program);
-        }
-    }
-
-    void Pass::OnAssetReady(AZ::Data::Asset<AZ::Data::AssetData> asset)
-    {
-        AZ::Data::AssetBus::MultiHandler::BusDisconnect(asset.GetId());
-
-        if (m_vs.IsReady() && m_fs.IsReady())
-        {
-            auto vs = bgfx::createShader(bgfx::makeRef(m_vs.Get()->GetBuffer(), m_vs.Get()->GetLength()));
-            auto fs = bgfx::createShader(bgfx::makeRef(m_fs.Get()->GetBuffer(), m_fs.Get()->GetLength()));
-
-            m_program = bgfx::createProgram(vs, fs, true);
-
-            m_vs.Release();
-            m_fs.Release();
+            m_instanceProperties.push_back(AZ::Crc32(config.m_instanceProperties[i].c_str()));
         }
     }
 
@@ -83,12 +54,46 @@ namespace Module
         }
     }
 
-    void Pass::Apply(bgfx::ViewId viewId) const
+    void Pass::Apply(bgfx::Encoder* encoder, bgfx::ViewId viewId, bool preserveState) const
+    {
+        if (IsValid())
+        {
+            encoder->setState(m_rs);
+            encoder->submit(viewId, m_program->GetHandle(), 0, preserveState);
+        }
+    }
+
+    void Pass::Submit(bgfx::Encoder* encoder, bgfx::ViewId viewId, bool preserveState) const
+    {
+        if (IsValid())
+        {
+            encoder->submit(viewId, m_program->GetHandle(), 0, preserveState);
+        }
+    }
+
+    void Pass::ApplyInstanced(bgfx::Encoder* encoder, bgfx::ViewId viewId) const
     {
-        if (bgfx::isValid(m_program))
+        if (SupportsInstancing())
         {
-            bgfx::setState(m_rs);
-            bgfx::submit(viewId, m_program);
+            encoder->setState(m_rs);
+            encoder->submit(viewId, m_instancedProgram->GetHandle());
+        }
+    }
+
+    bool Pass::CanInstanceBlock(const MaterialPropertyBlock* block) const
+    {
+        if (block == nullptr)
+        {
+            return true;
+        }
+
+        for (auto& entry : block->GetEntries())
+        {
+            if (entry.m_isTexture || AZStd::find(m_instanceProperties.begin(), m_instanceProperties.end(), entry.m_name) == m_instanceProperties.end())
+            {
+                return false;
+            }
         }
+        return true;
     }
 }
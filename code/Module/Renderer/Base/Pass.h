@@ -1,15 +1,17 @@
 #pragma once
 
 #include "Renderer/Asset/ShaderAsset.h"
+#include "Renderer/Base/Program.h"
 
-#include <AzCore/Asset/AssetCommon.h>
-#include <AzCore/Asset/BinaryAssetHandler.h>
+#include <AzCore/Math/Crc.h>
 
 #include <bgfx/bgfx.h>
 
 namespace Module
 {
-    class Pass : public AZ::Data::AssetBus::MultiHandler
+    class MaterialPropertyBlock;
+
+    class Pass
     {
     public:
         AZ_CLASS_ALLOCATOR(Pass, AZ::SystemAllocator, 0);
@@ -20,26 +22,49 @@ namespace Module
         Pass(const Pass&) = delete;
         Pass& operator=(const Pass&) = delete;
 
-        Pass(Pass&&) noexcept;
-        Pass& operator=(Pass&&) noexcept;
+        Pass(Pass&&) = default;
+        Pass& operator=(Pass&&) = default;
 
-        ~Pass();
+        void SetReverseCull(bool value);
 
-        // AZ::Data::AssetBus::MultiHandler
-        void OnAssetReady(AZ::Data::Asset<AZ::Data::AssetData> asset) override;
+        bool IsValid() const { return m_program && m_program->IsValid(); }
 
-        void SetReverseCull(bool value);
+        // passes sharing a program sort next to each other, whichever shader they belong to
+        AZ::u16 GetProgramSortId() const { return m_program->GetSortId(); }
 
-        bool IsValid() const { return bgfx::isValid(m_program); }
+        // the instanced program reads the model matrix from the instance data buffer instead of u_model
+        bool SupportsInstancing() const { return m_instancedProgram && m_instancedProgram->IsValid(); }
 
-        void Apply(bgfx::ViewId viewId) const;
+        // the fragment shader dithers cross-faded levels of detail with RenderNode::LodFadeUniformName
+        bool ReadsLodFade() const { return m_program && m_program->ReadsLodFade(); }
 
-    private:
-        AZ::Data::Asset<AZ::BinaryAsset> m_vs;
-        AZ::Data::Asset<AZ::BinaryAsset> m_fs;
+        // either vertex shader scales quantized meshes back with RenderNode::MeshDequantizationUniformName
+        bool ReadsMeshDequantization() const
+        {
+            return (m_program && m_program->ReadsMeshDequantization()) || (m_instancedProgram && m_instancedProgram->ReadsMeshDequantization());
+        }
+
+        void Apply(bgfx::Encoder* encoder, bgfx::ViewId viewId, bool preserveState = false) const;
+
+        // submits without setting the render state, the encoder still holds it from a preserved submit of this pass
+        void Submit(bgfx::Encoder* encoder, bgfx::ViewId viewId, bool preserveState = false) const;
 
-        bgfx::ProgramHandle              m_program   = BGFX_INVALID_HANDLE;
-        AZ::u64                          m_defaultRs = 0;
-        AZ::u64                          m_rs        = 0;
+        void ApplyInstanced(bgfx::Encoder* encoder, bgfx::ViewId viewId) const;
+
+        // vector properties written into the instance data after the model matrix, in shader order
+        const AZStd::vector<AZ::Crc32>& GetInstanceProperties() const { return m_instanceProperties; }
+
+        // size of the instance data of one instance
+        uint16_t GetInstanceStride() const { return static_cast<uint16_t>(sizeof(float) * (16 + 4 * m_instanceProperties.size())); }
+
+        // a block only overriding instance properties keeps its node instanceable
+        bool CanInstanceBlock(const MaterialPropertyBlock* block) const;
+
+    private:
+        ProgramPtr                       m_program;
+        ProgramPtr                       m_instancedProgram;
+        AZ::u64                          m_defaultRs        = 0;
+        AZ::u64                          m_rs               = 0;
+        AZStd::vector<AZ::Crc32>         m_instanceProperties;
     };
 }
\ No newline at end of file
@@ -0,0 +1,81 @@
+#include "Renderer/Base/Program.h"
+#include "Renderer/Base/RenderNode.h"
+
+#include "Renderer/EBus/RendererSystemComponentBus.h"
+
+#include <AzCore/std/containers/vector.h>
+
+#include <bx/hash.h>
+
+#include <string.h>
+
+namespace Module
+{
+    Program::Program(const AZStd::string& vsPath, const AZStd::string& fsPath)
+    {
+        m_vs.Create(vsPath.c_str(), true);
+        m_fs.Create(fsPath.c_str(), true);
+
+        AZ::Data::AssetBus::MultiHandler::BusConnect(m_vs.GetId());
+        AZ::Data::AssetBus::MultiHandler::BusConnect(m_fs.GetId());
+    }
+
+    Program::~Program()
+    {
+        if (bgfx::isValid(m_handle))
+        {
+            bgfx::destroy(m_handle);
+        }
+    }
+
+    void Program::OnAssetReady(AZ::Data::Asset<AZ::Data::AssetData> asset)
+    {
+        AZ::Data::AssetBus::MultiHandler::BusDisconnect(asset.GetId());
+
+        if (!m_vs.IsReady() || !m_fs.IsReady())
+        {
+            return;
+        }
+
+        auto vsAsset = m_vs.Get();
+        auto fsAsset = m_fs.Get();
+
+        // bgfx hashes the shader binaries and hands out the existing handle for identical ones, and the existing
+        // program for a pair of them, so shader assets with the same content share their gpu objects. the binaries
+        // are copied, the render thread creates the shaders from them after the assets are released below
+        auto vs = bgfx::createShader(bgfx::copy(vsAsset->GetBuffer(), vsAsset->GetLength()));
+        auto fs = bgfx::createShader(bgfx::copy(fsAsset->GetBuffer(), fsAsset->GetLength()));
+        m_handle = bgfx::createProgram(vs, fs);
+
+        // render nodes only set the cross-fade uniform of levels of detail and the mesh dequantization for programs
+        // that read them
+        const auto declares = [](bgfx::ShaderHandle shader, const char* name)
+        {
+            AZStd::vector<bgfx::UniformHandle> uniforms(bgfx::getShaderUniforms(shader));
+            bgfx::getShaderUniforms(shader, uniforms.data(), static_cast<uint16_t>(uniforms.size()));
+            for (const auto& uniform : uniforms)
+            {
+                bgfx::UniformInfo info;
+                bgfx::getUniformInfo(uniform, info);
+                if (strcmp(info.name, name) == 0)
+                {
+                    return true;
+                }
+            }
+            return false;
+        };
+        m_readsLodFade = declares(fs, RenderNode::LodFadeUniformName);
+        m_readsMeshDequantization = declares(vs, RenderNode::MeshDequantizationUniformName);
+
+        bgfx::destroy(vs);
+        bgfx::destroy(fs);
+
+        const AZ::u64 vsHash = bx::hash<bx::HashMurmur2A>(vsAsset->GetBuffer(), vsAsset->GetLength());
+        const AZ::u64 fsHash = bx::hash<bx::HashMurmur2A>(fsAsset->GetBuffer(), fsAsset->GetLength());
+        EBUS_EVENT_RESULT(m_sortId, RendererSystemRequestBus, GetProgramSortId, (vsHash << 32) | fsHash);
+        m_size = static_cast<AZ::u32>(vsAsset->GetLength() + fsAsset->GetLength());
+
+        m_vs.Release();
+        m_fs.Release();
+    }
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <AzCore/Asset/AssetCommon.h>
+#include <AzCore/Asset/BinaryAssetHandler.h>
+#include <AzCore/std/smart_ptr/shared_ptr.h>
+
+#include <bgfx/bgfx.h>
+
+namespace Module
+{
+    // bgfx program of a vertex and a fragment shader asset, shared by every pass using the same pair through
+    // RendererSystemRequests::GetProgram
+    class Program : public AZ::Data::AssetBus::MultiHandler
+    {
+    public:
+        AZ_CLASS_ALLOCATOR(Program, AZ::SystemAllocator, 0);
+
+        Program(const AZStd::string& vsPath, const AZStd::string& fsPath);
+
+        // non-copyable
+        Program(const Program&) = delete;
+        Program& operator=(const Program&) = delete;
+
+        ~Program() override;
+
+        // AZ::Data::AssetBus::MultiHandler
+        void OnAssetReady(AZ::Data::Asset<AZ::Data::AssetData> asset) override;
+
+        bool IsValid() const { return bgfx::isValid(m_handle); }
+
+        bgfx::ProgramHandle GetHandle() const { return m_handle; }
+
+        // equal for programs of identical shader binaries and unchanged when a program is loaded again, unlike the
+        // bgfx handle index which is recycled
+        AZ::u16 GetSortId() const { return m_sortId; }
+
+        // bytes of the shader binaries, what the program cache accounts for a released program
+        AZ::u32 GetSize() const { return m_size; }
+
+        // the fragment shader declares the cross-fade uniform of levels of detail
+        bool ReadsLodFade() const { return m_readsLodFade; }
+
+        // the vertex shader declares the dequantization uniform of meshes
+        bool ReadsMeshDequantization() const { return m_readsMeshDequantization; }
+
+    private:
+        AZ::Data::Asset<AZ::BinaryAsset> m_vs;
+        AZ::Data::Asset<AZ::BinaryAsset> m_fs;
+        bgfx::ProgramHandle              m_handle = BGFX_INVALID_HANDLE;
+        AZ::u16                          m_sortId = 0;
+        AZ::u32                          m_size   = 0;
+        bool                             m_readsLodFade = false;
+        bool                             m_readsMeshDequantization = false;
+    };
+
+    using ProgramPtr = AZStd::shared_ptr<Program>;
+}
@@ -1,55 +1,491 @@
 #include "Renderer/Base/RenderNode.h"
 #include "Renderer/Base/Material.h"
+#include "Renderer/Base/MaterialPropertyBlock.h"
+#include "Renderer/Base/Pass.h"
+#include "Renderer/Base/Mesh.h"
+#include "Renderer/Base/SubmitState.h"
 #include "Renderer/Component/RendererComponent.h"
+#include "Renderer/Util/TransientUtil.h"
+
+#include <AzCore/std/algorithm.h>
+#include <AzCore/std/sort.h>
+
+#include <bx/sort.h>
 
 namespace Module
 {
-    void RenderNode::Apply(bgfx::ViewId viewId)
+    namespace
+    {
+        const AZ::u32 k_rankBits     = 16;
+        const AZ::u32 k_queueBits    = 13;
+        const AZ::u32 k_materialBits = 9;
+        const AZ::u32 k_passBits     = 2;
+
+        // transparent: depth (24) | material | pass
+        const AZ::u32 k_transparentDepthBits     = 24;
+        const AZ::u32 k_transparentPassShift     = 0;
+        const AZ::u32 k_transparentMaterialShift = k_transparentPassShift + k_passBits;
+        const AZ::u32 k_transparentDepthShift    = k_transparentMaterialShift + k_materialBits;
+
+        // opaque: program (8) | material | pass | geometry (8) | depth (8)
+        const AZ::u32 k_opaqueDepthBits     = 8;
+        const AZ::u32 k_opaqueGeometryBits  = 8;
+        const AZ::u32 k_opaqueProgramBits   = 8;
+        const AZ::u32 k_opaqueDepthShift    = 0;
+        const AZ::u32 k_opaqueGeometryShift = k_opaqueDepthShift + k_opaqueDepthBits;
+        const AZ::u32 k_opaquePassShift     = k_opaqueGeometryShift + k_opaqueGeometryBits;
+        const AZ::u32 k_opaqueMaterialShift = k_opaquePassShift + k_passBits;
+        const AZ::u32 k_opaqueProgramShift  = k_opaqueMaterialShift + k_materialBits;
+
+        const AZ::u32 k_queueShift    = k_transparentDepthShift + k_transparentDepthBits;
+        const AZ::u32 k_rankShift     = k_queueShift + k_queueBits;
+
+        static_assert(k_opaqueProgramShift + k_opaqueProgramBits == k_queueShift, "Opaque and transparent layouts must have the same size");
+        static_assert(k_rankShift + k_rankBits == 64, "Render sort key must use exactly 64 bits");
+
+        const float s_identityMatrix[16] =
+        {
+            1.0f, 0.0f, 0.0f, 0.0f,
+            0.0f, 1.0f, 0.0f, 0.0f,
+            0.0f, 0.0f, 1.0f, 0.0f,
+            0.0f, 0.0f, 0.0f, 1.0f,
+        };
+
+        bgfx::UniformHandle s_lodFadeUniform = BGFX_INVALID_HANDLE;
+        bgfx::UniformHandle s_meshDequantizationUniform = BGFX_INVALID_HANDLE;
+
+        const QuantizeUtil::Dequantization s_identityDequantization;
+
+        AZ::u64 Mask(AZ::u32 bits)
+        {
+            return (AZ::u64(1) << bits) - 1;
+        }
+
+        // values past the field share its last value, which keeps the order of the ones that fit
+        AZ::u64 Clamp(AZ::u32 value, AZ::u32 bits)
+        {
+            return AZStd::GetMin(AZ::u64(value), Mask(bits));
+        }
+
+        // the bit pattern of a positive float is monotonic, keeping the exponent and the top mantissa bits
+        // gives buckets with constant relative precision
+        AZ::u64 PackDepth(float distance, AZ::u32 depthBits)
+        {
+            distance = distance > 0.0f ? distance : 0.0f;
+            AZ::u32 bits;
+            memcpy(&bits, &distance, sizeof(bits));
+            return AZ::u64(bits >> (31 - depthBits)) & Mask(depthBits);
+        }
+    }
+
+    const char* const RenderNode::LodFadeUniformName = "u_lodFade";
+    const char* const RenderNode::MeshDequantizationUniformName = "u_meshDequantization";
+
+    void RenderNode::InitUniforms()
+    {
+        s_lodFadeUniform = bgfx::createUniform(LodFadeUniformName, bgfx::UniformType::Vec4);
+        s_meshDequantizationUniform = bgfx::createUniform(MeshDequantizationUniformName, bgfx::UniformType::Vec4, 4);
+    }
+
+    void RenderNode::ShutdownUniforms()
+    {
+        if (bgfx::isValid(s_lodFadeUniform))
+        {
+            bgfx::destroy(s_lodFadeUniform);
+            s_lodFadeUniform = BGFX_INVALID_HANDLE;
+        }
+        if (bgfx::isValid(s_meshDequantizationUniform))
+        {
+            bgfx::destroy(s_meshDequantizationUniform);
+            s_meshDequantizationUniform = BGFX_INVALID_HANDLE;
+        }
+    }
+
+    void SortingOrders::Add(AZ::s16 sortingLayer, AZ::s16 orderInLayer)
+    {
+        // neighbouring proxies mostly share their pair
+        const AZ::s32 order = Combine(sortingLayer, orderInLayer);
+        if (!m_orders.empty() && m_lastOrder == order)
+        {
+            return;
+        }
+        m_lastOrder = order;
+
+        if (m_isSorted)
+        {
+            const auto it = AZStd::lower_bound(m_orders.begin(), m_orders.end(), order);
+            if (it != m_orders.end() && *it == order)
+            {
+                return;
+            }
+            if (m_orders.size() < MaxSortedInsertCount)
+            {
+                m_orders.insert(it, order);
+                return;
+            }
+            m_isSorted = false;
+        }
+        m_orders.push_back(order);
+    }
+
+    void SortingOrders::Finalize()
+    {
+        if (m_isSorted)
+        {
+            return;
+        }
+
+        AZStd::sort(m_orders.begin(), m_orders.end());
+
+        size_t count = 0;
+        for (size_t i = 0; i < m_orders.size(); ++i)
+        {
+            if (count == 0 || m_orders[count - 1] != m_orders[i])
+            {
+                m_orders[count++] = m_orders[i];
+            }
+        }
+        m_orders.resize(count);
+        m_isSorted = true;
+    }
+
+    AZ::u16 SortingOrders::GetRank(AZ::s16 sortingLayer, AZ::s16 orderInLayer) const
+    {
+        if (m_orders.size() == 1)
+        {
+            return 0;
+        }
+
+        const auto it = AZStd::lower_bound(m_orders.begin(), m_orders.end(), Combine(sortingLayer, orderInLayer));
+        AZ_Assert(it != m_orders.end() && *it == Combine(sortingLayer, orderInLayer), "Sorting order was not added before Finalize\n");
+        return static_cast<AZ::u16>(AZStd::GetMin(static_cast<size_t>(it - m_orders.begin()), size_t(0xFFFF)));
+    }
+
+    void SortIdRemap::Clear()
+    {
+        m_count = 0;
+        if (++m_generation == 0)
+        {
+            // the generation wrapped around, slots of the first generations could be mistaken for current ones
+            for (auto& slot : m_slots)
+            {
+                slot.m_generation = 0;
+            }
+            m_generation = 1;
+        }
+    }
+
+    AZ::u64 RenderNode::MakeSortKey(AZ::u16 sortingRank,
+                                    AZ::s32 queue,
+                                    float distance,
+                                    AZ::u32 programId,
+                                    AZ::u32 materialId,
+                                    AZ::u32 passIndex,
+                                    AZ::u32 geometryId)
+    {
+        const AZ::u64 clampedQueue = AZ::u64(AZStd::GetMin(AZStd::GetMax(queue, 0), AZ::s32(Mask(k_queueBits))));
+
+        AZ::u64 key = (AZ::u64(sortingRank) << k_rankShift)
+            | (clampedQueue << k_queueShift);
+
+        if (Material::IsOpaqueQueue(queue))
+        {
+            key |= (Clamp(programId, k_opaqueProgramBits) << k_opaqueProgramShift)
+                | (Clamp(materialId, k_materialBits) << k_opaqueMaterialShift)
+                | (Clamp(passIndex, k_passBits) << k_opaquePassShift)
+                | (Clamp(geometryId, k_opaqueGeometryBits) << k_opaqueGeometryShift)
+                | (PackDepth(distance, k_opaqueDepthBits) << k_opaqueDepthShift);
+        }
+        else
+        {
+            const AZ::u64 depth = Mask(k_transparentDepthBits) - PackDepth(distance, k_transparentDepthBits);
+            key |= (depth << k_transparentDepthShift)
+                | (Clamp(materialId, k_materialBits) << k_transparentMaterialShift)
+                | (Clamp(passIndex, k_passBits) << k_transparentPassShift);
+        }
+
+        return key;
+    }
+
+    void RenderNode::Sort(AZStd::vector<AZ::u64>& keys,
+                          AZStd::vector<AZ::u32>& indices,
+                          AZStd::vector<AZ::u64>& tempKeys,
+                          AZStd::vector<AZ::u32>& tempIndices)
+    {
+        AZ_Assert(keys.size() == indices.size(), "Sort keys and indices must have the same size\n");
+
+        tempKeys.resize_no_construct(keys.size());
+        tempIndices.resize_no_construct(indices.size());
+
+        if (!keys.empty())
+        {
+            // AZ::u64 and uint64_t are distinct types on some platforms even though they share the layout
+            static_assert(sizeof(AZ::u64) == sizeof(uint64_t), "Sort key size mismatch");
+            bx::radixSort(reinterpret_cast<uint64_t*>(keys.data()),
+                          reinterpret_cast<uint64_t*>(tempKeys.data()),
+                          indices.data(),
+                          tempIndices.data(),
+                          static_cast<uint32_t>(keys.size()));
+        }
+    }
+
+    RenderNode::RenderNode(Mesh* batchMesh,
+                           AZ::u32 firstIndex,
+                           AZ::u32 indexCount,
+                           Material* material,
+                           Shader* shader,
+                           Pass* pass,
+                           AZ::u64 sortKey)
+        : m_material(material)
+        , m_shader(shader)
+        , m_pass(pass)
+        , m_mesh(batchMesh)
+        , m_firstIndex(firstIndex)
+        , m_indexCount(indexCount)
+        , m_sortKey(sortKey)
+        , m_worldMatrix(s_identityMatrix)
     {
-        m_renderer->Render(m_materialIndex); // set vertex buffer
-        bgfx::setTransform(m_worldMatrix);   // set uniform
-        m_material->Apply();                 // set uniform
-        m_pass->Apply(viewId);               // set state, set shader, submit drawcall
     }
 
-    bool operator<(const RenderNode& lhv, const RenderNode& rhv)
+    void RenderNode::ApplyGeometry(bgfx::Encoder* encoder) const
     {
-        if (lhv.m_sortingLayer != rhv.m_sortingLayer)
+        if (m_renderer == nullptr)
+        {
+            m_mesh->ApplyRange(encoder, m_firstIndex, m_indexCount);
+        }
+        else if (m_mesh != nullptr)
         {
-            return lhv.m_sortingLayer < rhv.m_sortingLayer;
+            // the mesh of the picked level of detail, which is not necessarily the one of the renderer
+            m_mesh->ApplySubMesh(encoder, m_materialIndex);
         }
-        if (lhv.m_orderInLayer != rhv.m_orderInLayer)
+        else
         {
-            return lhv.m_orderInLayer < rhv.m_orderInLayer;
+            m_renderer->Render(encoder, m_materialIndex);
         }
-        if (lhv.m_material->GetQueue() != rhv.m_material->GetQueue())
+    }
+
+    void RenderNode::ApplyLodFade(bgfx::Encoder* encoder, const RenderNode* bound) const
+    {
+        // the uniform keeps its value between draws, programs reading it get it with every node. preserved submits
+        // replay every uniform set since the last discard, so it is not set again while the value did not change,
+        // which leaves runs of nodes that are not fading with a single set
+        if (bound != nullptr && bound->m_lodFade == m_lodFade && bound->m_isLodFadingOut == m_isLodFadingOut)
         {
-            return lhv.m_material->GetQueue() < rhv.m_material->GetQueue();
+            return;
         }
-        if (lhv.m_distance != rhv.m_distance)
+        if (m_pass->ReadsLodFade())
         {
-            return lhv.m_distance < rhv.m_distance;
+            const float value[4] = { m_lodFade, m_isLodFadingOut ? 1.0f : 0.0f, 0.0f, 0.0f };
+            encoder->setUniform(s_lodFadeUniform, value);
         }
-        // is first pass
-        // lightmap index
-        // static batch index
-        if (lhv.m_materialIndex != rhv.m_materialIndex)
+    }
+
+    const float* RenderNode::GetDequantization() const
+    {
+        if (m_mesh != nullptr)
         {
-            return lhv.m_materialIndex < rhv.m_materialIndex;
+            return m_mesh->GetDequantization().m_values;
         }
-        if (lhv.m_shader != rhv.m_shader)
+        if (m_renderer != nullptr)
         {
-            return lhv.m_shader < rhv.m_shader;
+            if (const auto dequantization = m_renderer->GetDequantization())
+            {
+                return dequantization->m_values;
+            }
         }
-        if (lhv.m_material != rhv.m_material)
+        return s_identityDequantization.m_values;
+    }
+
+    void RenderNode::ApplyMeshDequantization(bgfx::Encoder* encoder) const
+    {
+        if (m_pass->ReadsMeshDequantization())
         {
-            return lhv.m_material < rhv.m_material;
+            encoder->setUniform(s_meshDequantizationUniform, GetDequantization(), 4);
         }
-        if (lhv.m_pass != rhv.m_pass)
+    }
+
+    void RenderNode::Apply(bgfx::Encoder* encoder, bgfx::ViewId viewId) const
+    {
+        ApplyGeometry(encoder);                            // set vertex buffer
+        ApplyMeshDequantization(encoder);                  // set uniform
+        encoder->setTransform(m_worldMatrix);              // set uniform
+        m_material->Apply(encoder, m_propertyBlock);       // set uniform
+        ApplyLodFade(encoder);                             // set uniform
+        m_pass->Apply(encoder, viewId);        // set state, set shader, submit drawcall
+    }
+
+    void RenderNode::Apply(bgfx::Encoder* encoder, bgfx::ViewId viewId, SubmitState& state, bool preserveState) const
+    {
+        const RenderNode* bound = state.m_boundNode;
+
+        const bool sameGeometry = bound != nullptr && HasSameGeometry(*bound);
+        if (sameGeometry)
         {
-            return lhv.m_pass < rhv.m_pass;
+            ++state.m_stats.m_savedGeometryBinds;
+        }
+        else
+        {
+            ApplyGeometry(encoder);
+        }
+
+        // preserved submits replay every uniform set since the last discard, the uniform is only set again when the
+        // node before held other values
+        if (bound == nullptr || memcmp(bound->GetDequantization(), GetDequantization(), sizeof(s_identityDequantization.m_values)) != 0)
+        {
+            ApplyMeshDequantization(encoder);
+        }
+
+        encoder->setTransform(m_worldMatrix);
+
+        if (bound != nullptr && bound->m_material == m_material && bound->m_propertyBlock == m_propertyBlock)
+        {
+            ++state.m_stats.m_savedMaterialBinds;
+        }
+        else
+        {
+            m_material->Apply(encoder, m_propertyBlock);
+        }
+
+        ApplyLodFade(encoder, bound);
+
+        if (bound != nullptr && bound->m_pass == m_pass)
+        {
+            ++state.m_stats.m_savedStateBinds;
+            m_pass->Submit(encoder, viewId, preserveState);
+        }
+        else
+        {
+            m_pass->Apply(encoder, viewId, preserveState);
+        }
+
+        state.m_boundNode = preserveState ? this : nullptr;
+    }
+
+    AZ::u32 RenderNode::GetTriangleCount() const
+    {
+        if (m_renderer == nullptr)
+        {
+            return m_indexCount / 3;
+        }
+        if (m_mesh != nullptr)
+        {
+            return m_mesh->GetSubMeshIndexCount(m_materialIndex) / 3;
+        }
+        if (m_batchTexture != nullptr)
+        {
+            AZ::u32 vertexCount, indexCount;
+            m_renderer->GetBatchGeometrySize(vertexCount, indexCount);
+            return indexCount / 3;
+        }
+        return 0;
+    }
+
+    bool RenderNode::CanPreserveStateWith(const RenderNode& other) const
+    {
+        return m_material == other.m_material
+            && m_propertyBlock == other.m_propertyBlock
+            && m_pass == other.m_pass;
+    }
+
+    bool RenderNode::HasSameGeometry(const RenderNode& other) const
+    {
+        if (m_mesh == nullptr || m_mesh != other.m_mesh)
+        {
+            return false;
+        }
+        // renderers draw the sub mesh of their material index, batch nodes an explicit index range
+        if (m_renderer != nullptr)
+        {
+            return other.m_renderer != nullptr && m_materialIndex == other.m_materialIndex;
+        }
+        return other.m_renderer == nullptr && m_firstIndex == other.m_firstIndex && m_indexCount == other.m_indexCount;
+    }
+
+    bool RenderNode::CanInstanceWith(const RenderNode& other) const
+    {
+        return m_renderer != nullptr
+            && m_mesh != nullptr
+            && m_mesh == other.m_mesh
+            && m_materialIndex == other.m_materialIndex
+            && m_material == other.m_material
+            && m_pass == other.m_pass
+            && m_pass->SupportsInstancing()
+            && !IsLodFading()
+            && !other.IsLodFading()
+            && (m_propertyBlock == other.m_propertyBlock || (m_pass->CanInstanceBlock(m_propertyBlock) && m_pass->CanInstanceBlock(other.m_propertyBlock)));
+    }
+
+    bool RenderNode::CanBatchWith(const RenderNode& other) const
+    {
+        return m_batchTexture != nullptr
+            && m_batchTexture == other.m_batchTexture
+            && m_material == other.m_material
+            && m_propertyBlock == other.m_propertyBlock
+            && m_pass == other.m_pass;
+    }
+
+    void RenderNode::ApplyInstanced(bgfx::Encoder* encoder, bgfx::ViewId viewId, const RenderNode* nodes, const AZ::u32* indices, AZ::u32 count)
+    {
+        auto& first = nodes[indices[0]];
+
+        const auto& instanceProperties = first.m_pass->GetInstanceProperties();
+        const uint16_t stride = first.m_pass->GetInstanceStride();
+        const AZ::u32 floatStride = stride / sizeof(float);
+
+        // values of the material for instances without an override, the shader reads all instance properties
+        const float* defaults[4] = {};
+        AZ_Assert(instanceProperties.size() <= AZ_ARRAY_SIZE(defaults), "Too many instance properties\n");
+        for (size_t p = 0; p < instanceProperties.size(); ++p)
+        {
+            defaults[p] = first.m_material->GetVectorValue(instanceProperties[p]);
+        }
+
+        AZ::u32 drawn = 0;
+        while (drawn < count)
+        {
+            bgfx::InstanceDataBuffer idb;
+            const AZ::u32 available = TransientUtil::AllocInstanceData(&idb, count - drawn, stride);
+            if (available == 0)
+            {
+                // transient memory is exhausted, fall back to one draw call per node
+                for (; drawn < count; ++drawn)
+                {
+                    nodes[indices[drawn]].Apply(encoder, viewId);
+                }
+                return;
+            }
+
+            auto data = reinterpret_cast<float*>(idb.data);
+            for (AZ::u32 i = 0; i < available; ++i)
+            {
+                const auto& node = nodes[indices[drawn + i]];
+                float* instance = data + i * floatStride;
+
+                memcpy(instance, node.m_worldMatrix, sizeof(float) * 16);
+
+                for (size_t p = 0; p < instanceProperties.size(); ++p)
+                {
+                    const float* value = node.m_propertyBlock != nullptr ? node.m_propertyBlock->FindVector(instanceProperties[p]) : nullptr;
+                    value = value != nullptr ? value : defaults[p];
+                    if (value != nullptr)
+                    {
+                        memcpy(instance + 16 + p * 4, value, sizeof(float) * 4);
+                    }
+                    else
+                    {
+                        memset(instance + 16 + p * 4, 0, sizeof(float) * 4);
+                    }
+                }
+            }
+
+            first.ApplyGeometry(encoder);                             // set vertex buffer
+            first.ApplyMeshDequantization(encoder);                   // set uniform
+            first.m_material->Apply(encoder, first.m_propertyBlock);  // set uniform, the nodes differ in instance properties at most
+            first.ApplyLodFade(encoder);                              // set uniform, none of the nodes is fading
+            encoder->setInstanceDataBuffer(&idb);                     // set per instance transforms and properties
+            first.m_pass->ApplyInstanced(encoder, viewId);            // set state, set shader, submit drawcall
+
+            drawn += available;
         }
-        // fall back
-        return &lhv < &rhv;
     }
 }
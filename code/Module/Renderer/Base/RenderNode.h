@@ -1,7 +1,7 @@
 #pragma once
 
 #include <AzCore/Memory/SystemAllocator.h>
-#include <AzCore/Math/Transform.h>
+#include <AzCore/std/containers/vector.h>
 
 #include <bgfx/bgfx.h>
 
@@ -11,6 +11,76 @@ namespace Module
     class Material;
     class Shader;
     class Pass;
+    class Mesh;
+    class Texture;
+    class MaterialPropertyBlock;
+    struct SubmitState;
+
+    // Distinct (sorting layer, order in layer) pairs of the registered renderers. Both values keep their full 16 bit
+    // range, sort keys only store the rank of the pair among all pairs, which is cached by the proxies and batches.
+    class SortingOrders
+    {
+    public:
+        void Clear() { m_orders.clear(); m_isSorted = true; }
+
+        void Add(AZ::s16 sortingLayer, AZ::s16 orderInLayer);
+
+        // sorts the added pairs and drops the duplicates, ranks can be queried afterwards
+        void Finalize();
+
+        // pairs beyond the first 65536 share the last rank
+        AZ::u16 GetRank(AZ::s16 sortingLayer, AZ::s16 orderInLayer) const;
+
+    private:
+        // the sorting layer in the high half, the biased order in the low half keeps the ordering of both
+        static AZ::s32 Combine(AZ::s16 sortingLayer, AZ::s16 orderInLayer)
+        {
+            return AZ::s32(sortingLayer) * 0x10000 + (AZ::s32(orderInLayer) + 0x8000);
+        }
+
+        // queues mostly use a handful of pairs, they are kept sorted while there are few of them
+        static const size_t MaxSortedInsertCount = 64;
+
+        AZStd::vector<AZ::s32> m_orders;
+        AZ::s32                m_lastOrder = 0;
+        bool                   m_isSorted = true;
+    };
+
+    // Maps the global sort ids of programs, materials or geometry to dense indices in the order they are first seen
+    // since the last Clear. The sort key fields only have to hold the ids drawn by one view instead of every id ever
+    // handed out.
+    class SortIdRemap
+    {
+    public:
+        void Clear();
+
+        AZ::u32 Get(AZ::u16 id)
+        {
+            if (id >= m_slots.size())
+            {
+                m_slots.resize(id + 1);
+            }
+            auto& slot = m_slots[id];
+            if (slot.m_generation != m_generation)
+            {
+                slot.m_generation = m_generation;
+                slot.m_index = m_count++;
+            }
+            return slot.m_index;
+        }
+
+    private:
+        // slots of an older generation are unused, clearing does not touch them
+        struct Slot
+        {
+            AZ::u32 m_generation = 0;
+            AZ::u32 m_index      = 0;
+        };
+
+        AZStd::vector<Slot> m_slots;
+        AZ::u32             m_generation = 1;
+        AZ::u32             m_count      = 0;
+    };
 
     class RenderNode
     {
@@ -22,38 +92,139 @@ namespace Module
                    Material* material,
                    Shader* shader,
                    Pass* pass,
-                   float distance,
-                   AZ::Transform& transform,
-                   AZ::s16 sortingLayer,
-                   AZ::s16 orderInLayer)
+                   Mesh* mesh,
+                   AZ::u64 sortKey,
+                   const float* worldMatrix,
+                   Texture* batchTexture = nullptr,
+                   const MaterialPropertyBlock* propertyBlock = nullptr)
             : m_renderer(renderer)
             , m_materialIndex(materialIndex)
             , m_material(material)
             , m_shader(shader)
             , m_pass(pass)
-            , m_distance(distance)
-            , m_sortingLayer(sortingLayer)
-            , m_orderInLayer(orderInLayer)
+            , m_mesh(mesh)
+            , m_batchTexture(batchTexture)
+            , m_propertyBlock(propertyBlock)
+            , m_sortKey(sortKey)
+            , m_worldMatrix(worldMatrix)
         {
-            transform.StoreToColumnMajorFloat16Ex(m_worldMatrix);
         }
 
-        void Apply(bgfx::ViewId viewId);
+        // index range of a static batch, its vertices are already in world space
+        RenderNode(Mesh* batchMesh,
+                   AZ::u32 firstIndex,
+                   AZ::u32 indexCount,
+                   Material* material,
+                   Shader* shader,
+                   Pass* pass,
+                   AZ::u64 sortKey);
+
+        // Packs everything the render queue is ordered by into a single radix sortable key, from the most
+        // significant bits down:
+        //   sorting rank (16) | queue (13) | 35 bits depending on the queue
+        // The sorting rank orders the sorting layer and then the order in layer, see SortingOrders::GetRank.
+        // Opaque queues are sorted by state first so draws of the same geometry end up adjacent and can be
+        // instanced, depth only orders draws within a state:
+        //   program (8) | material (9) | pass (2) | geometry (8) | depth bucket (8)
+        // Transparent queues must be sorted back to front, the state only orders draws at the same depth:
+        //   depth bucket (24) | material (9) | pass (2)
+        // Program, material and geometry are the dense indices of a SortIdRemap, indices past the range of their field
+        // share its last value.
+        static AZ::u64 MakeSortKey(AZ::u16 sortingRank,
+                                   AZ::s32 queue,
+                                   float distance,
+                                   AZ::u32 programId,
+                                   AZ::u32 materialId,
+                                   AZ::u32 passIndex,
+                                   AZ::u32 geometryId = 0);
+
+        // sorts the (key, index) pairs by key, the temporary buffers are resized as needed
+        static void Sort(AZStd::vector<AZ::u64>& keys,
+                         AZStd::vector<AZ::u32>& indices,
+                         AZStd::vector<AZ::u64>& tempKeys,
+                         AZStd::vector<AZ::u32>& tempIndices);
+
+        // Name of the vec4 uniform that fragment shaders read to dither two levels of detail into each other. x is
+        // the fraction of the pixels the node draws, y is 1 for the level fading out, which keeps the complementary
+        // pattern. It is set for every node whose program reads it.
+        static const char* const LodFadeUniformName;
+
+        // Name of the array of 4 vec4 uniforms that vertex shaders read to scale the quantized positions and texcoords
+        // of a mesh back, laid out as QuantizeUtil::Dequantization. Nodes of float vertices set the identity.
+        static const char* const MeshDequantizationUniformName;
+
+        // the uniforms set per node live as long as the renderer system
+        static void InitUniforms();
+        static void ShutdownUniforms();
+
+        AZ::u64 GetSortKey() const { return m_sortKey; }
+
+        // the node is one of two levels of detail being cross-faded, nodes being faded are never instanced
+        void SetLodFade(float visibleFraction, bool isFadingOut) { m_lodFade = visibleFraction; m_isLodFadingOut = isFadingOut; }
+
+        bool IsLodFading() const { return m_lodFade < 1.0f; }
+
+        void Apply(bgfx::Encoder* encoder, bgfx::ViewId viewId) const;
+
+        // skips the bindings the encoder still holds from `state.m_boundNode`, with `preserveState` the bindings of
+        // this node are kept for the next one, which must share its material and pass
+        void Apply(bgfx::Encoder* encoder, bgfx::ViewId viewId, SubmitState& state, bool preserveState) const;
+
+        // nodes sharing material, property block and pass can be submitted one after another without discarding the
+        // encoder state
+        bool CanPreserveStateWith(const RenderNode& other) const;
+
+        // nodes sharing mesh, sub mesh, material and an instancing capable pass can be drawn with one draw call, their
+        // property blocks must be equal or only override the instance properties of the pass
+        bool CanInstanceWith(const RenderNode& other) const;
+
+        // draws the nodes at `indices` with the state of the first one, their transforms and instance properties go into
+        // instance data buffers
+        static void ApplyInstanced(bgfx::Encoder* encoder, bgfx::ViewId viewId, const RenderNode* nodes, const AZ::u32* indices, AZ::u32 count);
+
+        // nodes of the sprite batch are never drawn on their own, they go through SpriteBatcher
+        bool IsBatched() const { return m_batchTexture != nullptr; }
+
+        // nodes sharing texture, material, property block and pass are written into the same sprite batch
+        bool CanBatchWith(const RenderNode& other) const;
+
+        // 0 for renderers which draw their own geometry, their index count is not known to the renderer system
+        AZ::u32 GetTriangleCount() const;
 
     private:
+        // the same vertex buffer and index range, only known for nodes that reference a mesh
+        bool HasSameGeometry(const RenderNode& other) const;
+
+        // binds the sub mesh of the material index, or lets the renderer bind the geometry it draws itself
+        void ApplyGeometry(bgfx::Encoder* encoder) const;
+
+        // `bound` is the node submitted before with preserved state, whose value the encoder still holds
+        void ApplyLodFade(bgfx::Encoder* encoder, const RenderNode* bound = nullptr) const;
+
+        // the 16 values of the dequantization uniform: the ones of the mesh the node binds, or of the geometry its
+        // renderer binds, the identity for float vertices
+        const float* GetDequantization() const;
+
+        void ApplyMeshDequantization(bgfx::Encoder* encoder) const;
+
         RendererComponent* m_renderer        = nullptr;
         size_t             m_materialIndex   = 0;
 
         Material*          m_material        = nullptr;
         Shader*            m_shader          = nullptr;
         Pass*              m_pass            = nullptr;
+        Mesh*              m_mesh            = nullptr; // only set for renderers which can be instanced and batches
+        Texture*           m_batchTexture    = nullptr; // only set for renderers drawn through the sprite batch
+        const MaterialPropertyBlock* m_propertyBlock = nullptr; // owned by the renderer, nullptr without overrides
+        AZ::u32            m_firstIndex      = 0;
+        AZ::u32            m_indexCount      = 0;
 
-        float              m_distance        = 0.0f;
-        float              m_worldMatrix[16] = {};
+        AZ::u64            m_sortKey         = 0;
+        const float*       m_worldMatrix     = nullptr; // owned by the render proxy, valid for the frame
 
-        AZ::s16            m_sortingLayer    = 0;
-        AZ::s16            m_orderInLayer    = 0;
+        float              m_lodFade         = 1.0f;
+        bool               m_isLodFadingOut  = false;
 
-        friend bool operator<(const RenderNode& lhv, const RenderNode& rhv);
+        friend class SpriteBatcher;
     };
 }
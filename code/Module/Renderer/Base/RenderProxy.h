@@ -0,0 +1,68 @@
+#pragma once
+
+#include "Renderer/Base/LodGroup.h"
+
+#include <AzCore/Memory/SystemAllocator.h>
+#include <AzCore/Math/Aabb.h>
+#include <AzCore/std/containers/vector.h>
+
+namespace Module
+{
+    class RendererComponent;
+    class Material;
+    class Shader;
+    class Pass;
+    class Mesh;
+    class Texture;
+    class MaterialPropertyBlock;
+
+    // Retained state of a registered renderer, owned by RendererSystemComponent in a flat array.
+    // It is only rebuilt when the renderer marks itself dirty, cameras read it without any bus traffic.
+    struct RenderProxy
+    {
+        AZ_CLASS_ALLOCATOR(RenderProxy, AZ::SystemAllocator, 0);
+
+        static const AZ::u32 InvalidIndex = static_cast<AZ::u32>(-1);
+
+        struct Draw
+        {
+            size_t      m_materialIndex = 0;
+            Material*   m_material      = nullptr;
+            Shader*     m_shader        = nullptr;
+            Pass*       m_pass          = nullptr;
+            Mesh*       m_mesh          = nullptr;
+            Texture*    m_batchTexture  = nullptr;
+            AZ::u32     m_passIndex     = 0;
+            AZ::u32     m_lodLevel      = 0;
+
+            const MaterialPropertyBlock* m_propertyBlock = nullptr; // owned by the renderer, nullptr without overrides
+        };
+
+        RenderProxy() = default;
+        explicit RenderProxy(RendererComponent* renderer) : m_renderer(renderer) {}
+
+        AZ::Aabb            m_worldBounds     = AZ::Aabb::CreateNull();
+        AZ::Vector3         m_position        = AZ::Vector3::CreateZero();
+        bool                m_hasBounds       = false;
+        bool                m_isVisible       = false;
+        AZ::s16             m_sortingLayer    = 0;
+        AZ::s16             m_orderInLayer    = 0;
+        AZ::u16             m_sortingRank     = 0; // of the pair among all pairs, see SortingOrders
+        AZ::u8              m_layer           = 0; // cameras skip the proxies of layers outside their culling mask
+        Mesh*               m_occluderMesh    = nullptr; // drawn into the occlusion buffers of the cameras, batched or not
+
+        RendererComponent*  m_renderer        = nullptr;
+        float               m_worldMatrix[16] = {};
+        AZStd::vector<Draw> m_draws;
+
+        // levels of detail, the draws of a renderer with levels only cover the ones whose mesh is loaded
+        AZ::u32             m_lodCount        = 0;
+        float               m_lodScreenHeights[LodGroup::MaxLevels] = {};
+        float               m_lodHysteresis   = 0.0f;
+        float               m_lodFadeTime     = 0.0f; // seconds of a cross-fade between two levels
+        float               m_boundsRadius    = 0.0f;
+        AZ::u32             m_loadedLods      = 0; // bit per level with draws
+        AZ::u32             m_residentLods    = 0; // bit per level the renderer keeps a mesh for, loaded or not
+        AZ::u32             m_lodLastUsed[LodGroup::MaxLevels] = {}; // frame a camera last picked the level
+    };
+}
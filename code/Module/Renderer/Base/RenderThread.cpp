@@ -0,0 +1,105 @@
+#include "Renderer/Base/RenderThread.h"
+
+#include <bgfx/platform.h>
+#include <bx/os.h>
+
+namespace Module
+{
+    namespace
+    {
+        // renderFrame gives up after this long without a frame, so a stop request is noticed
+        const int32_t k_renderTimeoutMs = 100;
+    }
+
+    RenderThread* RenderThread::s_running = nullptr;
+
+    RenderThread::~RenderThread()
+    {
+        Stop();
+    }
+
+    void RenderThread::Start()
+    {
+        if (IsRunning())
+        {
+            return;
+        }
+
+        m_isStopping = false;
+        m_renderedFrames = 0;
+        m_waitedFrame = 0;
+        m_thread.init(&RenderThread::Run, this, 0, "Render");
+        m_started.wait();
+        s_running = this;
+    }
+
+    void RenderThread::Stop()
+    {
+        if (!IsRunning())
+        {
+            return;
+        }
+
+        // bgfx is shut down by now, nothing waits for a frame anymore
+        s_running = nullptr;
+        m_isStopping = true;
+        m_thread.shutdown();
+    }
+
+    void RenderThread::WaitForFrame(AZ::u32 frame)
+    {
+        if (m_renderedFrames >= frame)
+        {
+            return;
+        }
+
+        // the render thread clears the waited frame and posts once it has been rendered, unless the frame was
+        // rendered before it saw the request and this thread clears it first
+        m_waitedFrame = frame;
+        AZ::u32 waited = frame;
+        if (m_renderedFrames >= frame && m_waitedFrame.compare_exchange_strong(waited, 0))
+        {
+            return;
+        }
+        m_rendered.wait();
+    }
+
+    void RenderThread::OnFrameRendered()
+    {
+        const AZ::u32 rendered = ++m_renderedFrames;
+        AZ::u32 waited = m_waitedFrame;
+        if (waited != 0 && rendered >= waited && m_waitedFrame.compare_exchange_strong(waited, 0))
+        {
+            m_rendered.post();
+        }
+    }
+
+    int32_t RenderThread::Run(bx::Thread* thread, void* userData)
+    {
+        auto self = static_cast<RenderThread*>(userData);
+
+        // before bgfx::init, marks this thread as the render thread so bgfx does not start its own
+        bgfx::renderFrame();
+        self->m_started.post();
+
+        while (!self->m_isStopping)
+        {
+            switch (bgfx::renderFrame(k_renderTimeoutMs))
+            {
+            case bgfx::RenderFrame::Render:
+                self->OnFrameRendered();
+                break;
+            case bgfx::RenderFrame::Exiting:
+                // frame numbers start over with the next bgfx::init
+                self->m_renderedFrames = 0;
+                break;
+            case bgfx::RenderFrame::NoContext:
+                bx::sleep(1);
+                break;
+            default:
+                break;
+            }
+        }
+        return 0;
+    }
+}
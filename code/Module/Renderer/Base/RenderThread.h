@@ -0,0 +1,57 @@
+#pragma once
+
+#include <AzCore/base.h>
+#include <AzCore/std/parallel/atomic.h>
+
+#include <bx/semaphore.h>
+#include <bx/thread.h>
+
+namespace Module
+{
+    // A thread of the launcher which runs bgfx::renderFrame, so the thread ticking the application only records draws
+    // and bgfx::frame hands each frame over to it. Without one bgfx starts a render thread of its own where the
+    // platform allows it.
+    //
+    // bgfx picks its threading when it is initialized and needs the render thread to shut down, the thread has to be
+    // started before the application starts and stopped after it stopped. It does not use the allocators of the
+    // application.
+    class RenderThread
+    {
+    public:
+        RenderThread() = default;
+        ~RenderThread();
+
+        // non-copyable
+        RenderThread(const RenderThread&) = delete;
+        RenderThread& operator=(const RenderThread&) = delete;
+
+        // returns once bgfx knows about the thread
+        void Start();
+        void Stop();
+
+        bool IsRunning() const { return m_thread.isRunning(); }
+
+        // the started render thread, nullptr while bgfx renders on a thread of its own or on the application thread
+        static RenderThread* GetRunning() { return s_running; }
+
+        // blocks until the frame numbered `frame`, as bgfx::frame returns it, has been rendered
+        void WaitForFrame(AZ::u32 frame);
+
+        // frames rendered since bgfx was initialized
+        AZ::u32 GetRenderedFrameCount() const { return m_renderedFrames; }
+
+    private:
+        static int32_t Run(bx::Thread* thread, void* userData);
+
+        void OnFrameRendered();
+
+        static RenderThread*   s_running;
+
+        bx::Thread             m_thread;
+        bx::Semaphore          m_started;
+        bx::Semaphore          m_rendered;
+        AZStd::atomic_bool     m_isStopping{ false };
+        AZStd::atomic<AZ::u32> m_renderedFrames{ 0 };
+        AZStd::atomic<AZ::u32> m_waitedFrame{ 0 };   // frame the application thread waits for, 0 while none
+    };
+}
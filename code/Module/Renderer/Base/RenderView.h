@@ -0,0 +1,65 @@
+#pragma once
+
+#include "Renderer/Base/CullingScene.h"
+#include "Renderer/Base/FrameProfiler.h"
+#include "Renderer/Base/RenderNode.h"
+#include "Renderer/Base/StaticBatch.h"
+
+#include <AzCore/Memory/SystemAllocator.h>
+#include <AzCore/Math/Vector3.h>
+#include <AzCore/std/containers/vector.h>
+
+#include <bgfx/bgfx.h>
+
+namespace Module
+{
+    class CameraComponent;
+
+    // Render queue of one camera. It is filled and sorted by the culling job of the camera and read by the
+    // submission jobs afterwards, the vectors are reused between frames.
+    struct RenderView
+    {
+        AZ_CLASS_ALLOCATOR(RenderView, AZ::SystemAllocator, 0);
+
+        CameraComponent*                  m_camera       = nullptr;
+        bgfx::ViewId                      m_viewId       = 0;
+        AZ::Vector3                       m_position     = AZ::Vector3::CreateZero();
+        bool                              m_isSequential = false; // bgfx keeps the submission order, one encoder only
+        bool                              m_isOccluding  = false; // the occluders are drawn into m_occlusionBuffer this frame
+
+        AZStd::vector<RenderNode>         m_renderNodes;
+        AZStd::vector<AZ::u64>            m_sortKeys;
+        AZStd::vector<AZ::u32>            m_sortIndices;
+        AZStd::vector<AZ::u64>            m_tempSortKeys;
+        AZStd::vector<AZ::u32>            m_tempSortIndices;
+        AZStd::vector<StaticBatch::Range> m_visibleRanges;
+        SortIdRemap                       m_programIds; // dense per frame, so sort keys do not mask the global ids
+        SortIdRemap                       m_materialIds;
+        SortIdRemap                       m_meshIds;
+        SortIdRemap                       m_textureIds;
+
+        // culling output, the visible ranges of a static batch end at `m_rangeEnd` in m_visibleRanges
+        struct VisibleBatch
+        {
+            AZ::u32 m_batchIndex;
+            AZ::u32 m_rangeEnd;
+        };
+        VisibilityBits                    m_visibleProxies;
+        AZStd::vector<VisibleBatch>       m_visibleBatches;
+        OcclusionBuffer                   m_occlusionBuffer;
+
+        // level of detail the camera picked for a proxy, indexed like the proxies
+        struct LodState
+        {
+            static const AZ::u8 InvalidLevel = 0xff;
+
+            AZ::u8  m_level    = InvalidLevel;
+            AZ::u8  m_previous = InvalidLevel; // faded out while m_fade goes up to 1
+            float   m_fade     = 1.0f;
+            AZ::u32 m_frame    = 0;            // the state is stale when the camera did not see the proxy last frame
+        };
+        AZStd::vector<LodState>           m_lodStates;
+
+        CameraFrameStats                  m_stats;
+    };
+}
@@ -0,0 +1,243 @@
+#pragma once
+
+#include <AzCore/Memory/SystemAllocator.h>
+#include <AzCore/RTTI/TypeInfo.h>
+#include <AzCore/std/containers/list.h>
+#include <AzCore/std/containers/unordered_map.h>
+#include <AzCore/std/containers/vector.h>
+#include <AzCore/std/functional.h>
+#include <AzCore/std/parallel/mutex.h>
+#include <AzCore/std/smart_ptr/make_shared.h>
+#include <AzCore/std/smart_ptr/shared_ptr.h>
+#include <AzCore/std/smart_ptr/unique_ptr.h>
+#include <AzCore/std/smart_ptr/weak_ptr.h>
+#include <AzCore/std/string/string.h>
+
+namespace Module
+{
+    struct ResidentCacheStats
+    {
+        AZ_TYPE_INFO(ResidentCacheStats, "{0F6D8D1E-3E0A-4F54-9C0B-6E4C5C7A9B21}");
+
+        AZ::u32 m_hits          = 0; // lookups served by a live or a held resource
+        AZ::u32 m_misses        = 0; // lookups which had to load the resource
+        AZ::u32 m_evictions     = 0; // held resources destroyed to stay within the budget
+        AZ::u32 m_liveCount     = 0; // resources referenced from outside the cache
+        AZ::u32 m_heldCount     = 0; // released resources kept for reuse
+        AZ::u64 m_heldBytes     = 0;
+        AZ::u64 m_budgetBytes   = 0;
+    };
+
+    // Path keyed cache which keeps released resources resident. The handed out pointers return their resource to the
+    // cache when the last reference goes away, it is then held in a LRU list and handed out again by the next lookup
+    // instead of being loaded again. The least recently released resources are destroyed once the held bytes exceed
+    // the budget, resources whose size is still unknown (not loaded yet) are destroyed right away.
+    template<class T>
+    class ResidentCache
+    {
+    public:
+        using Pointer = AZStd::shared_ptr<T>;
+        using SizeFunction = AZStd::function<AZ::u64(const T&)>;
+
+        explicit ResidentCache(const SizeFunction& sizeFunction)
+            : m_state(AZStd::make_shared<State>())
+        {
+            m_state->m_sizeFunction = sizeFunction;
+        }
+
+        ~ResidentCache()
+        {
+            Clear();
+
+            // live resources are destroyed by the deleters of their pointers once the state is gone
+            AZStd::lock_guard<AZStd::mutex> lock(m_state->m_mutex);
+            for (auto& entry : m_state->m_entries)
+            {
+                entry.second.m_object.release();
+            }
+        }
+
+        // non-copyable
+        ResidentCache(const ResidentCache&) = delete;
+        ResidentCache& operator=(const ResidentCache&) = delete;
+
+        // returns the live or held resource, nullptr when the path has to be loaded with Insert
+        Pointer Find(const AZStd::string& path)
+        {
+            AZStd::lock_guard<AZStd::mutex> lock(m_state->m_mutex);
+
+            auto iterator = m_state->m_entries.find(path);
+            if (iterator == m_state->m_entries.end())
+            {
+                ++m_state->m_stats.m_misses;
+                return nullptr;
+            }
+
+            auto& entry = iterator->second;
+            ++m_state->m_stats.m_hits;
+
+            if (auto live = entry.m_live.lock())
+            {
+                return live;
+            }
+
+            // back from the holding list, without m_isHeld the last reference is being released on another thread
+            if (entry.m_isHeld)
+            {
+                m_state->m_held.erase(entry.m_heldIterator);
+                --m_state->m_stats.m_heldCount;
+                m_state->m_stats.m_heldBytes -= entry.m_size;
+                entry.m_isHeld = false;
+                entry.m_size = 0;
+            }
+
+            return Share(iterator->first, entry);
+        }
+
+        // takes ownership of a resource loaded after Find missed
+        Pointer Insert(const AZStd::string& path, T* object)
+        {
+            AZStd::lock_guard<AZStd::mutex> lock(m_state->m_mutex);
+
+            auto& entry = m_state->m_entries[path];
+            AZ_Assert(!entry.m_object, "Resident cache already holds %s\n", path.c_str());
+            entry.m_object.reset(object);
+
+            return Share(path, entry);
+        }
+
+        void SetBudget(AZ::u64 bytes)
+        {
+            AZStd::vector<AZStd::unique_ptr<T>> evicted;
+            {
+                AZStd::lock_guard<AZStd::mutex> lock(m_state->m_mutex);
+                m_state->m_stats.m_budgetBytes = bytes;
+                m_state->Evict(evicted);
+            }
+        }
+
+        ResidentCacheStats GetStats() const
+        {
+            AZStd::lock_guard<AZStd::mutex> lock(m_state->m_mutex);
+            return m_state->m_stats;
+        }
+
+        // destroys the held resources, live ones are destroyed by their last reference
+        void Clear()
+        {
+            AZStd::vector<AZStd::unique_ptr<T>> evicted;
+            {
+                AZStd::lock_guard<AZStd::mutex> lock(m_state->m_mutex);
+                for (auto& path : m_state->m_held)
+                {
+                    auto iterator = m_state->m_entries.find(path);
+                    evicted.emplace_back(AZStd::move(iterator->second.m_object));
+                    m_state->m_entries.erase(iterator);
+                }
+                m_state->m_held.clear();
+                m_state->m_stats.m_heldCount = 0;
+                m_state->m_stats.m_heldBytes = 0;
+            }
+        }
+
+    private:
+        struct Entry
+        {
+            AZStd::unique_ptr<T>                         m_object;
+            AZStd::weak_ptr<T>                           m_live;
+            typename AZStd::list<AZStd::string>::iterator m_heldIterator;
+            AZ::u64                                      m_size       = 0;
+            AZ::u32                                      m_generation = 0; // bumped whenever the resource is shared again
+            bool                                         m_isHeld     = false;
+        };
+
+        // shared with the deleters of the handed out pointers, which may outlive the cache
+        struct State
+        {
+            AZ_CLASS_ALLOCATOR(State, AZ::SystemAllocator, 0);
+
+            // destroys the least recently released resources until the held ones fit into the budget
+            void Evict(AZStd::vector<AZStd::unique_ptr<T>>& evicted)
+            {
+                while (!m_held.empty() && m_stats.m_heldBytes > m_stats.m_budgetBytes)
+                {
+                    auto iterator = m_entries.find(m_held.back());
+                    m_held.pop_back();
+
+                    m_stats.m_heldBytes -= iterator->second.m_size;
+                    --m_stats.m_heldCount;
+                    ++m_stats.m_evictions;
+
+                    evicted.emplace_back(AZStd::move(iterator->second.m_object));
+                    m_entries.erase(iterator);
+                }
+            }
+
+            void Release(const AZStd::string& path, AZ::u32 generation)
+            {
+                // destructors run outside the lock, they may release resources of this cache
+                AZStd::vector<AZStd::unique_ptr<T>> evicted;
+                {
+                    AZStd::lock_guard<AZStd::mutex> lock(m_mutex);
+                    --m_stats.m_liveCount;
+
+                    auto iterator = m_entries.find(path);
+                    auto& entry = iterator->second;
+                    if (entry.m_generation != generation)
+                    {
+                        // handed out again while the last reference was released
+                        return;
+                    }
+
+                    entry.m_size = m_sizeFunction(*entry.m_object);
+                    if (entry.m_size == 0)
+                    {
+                        evicted.emplace_back(AZStd::move(entry.m_object));
+                        m_entries.erase(iterator);
+                    }
+                    else
+                    {
+                        m_held.push_front(path);
+                        entry.m_heldIterator = m_held.begin();
+                        entry.m_isHeld = true;
+                        ++m_stats.m_heldCount;
+                        m_stats.m_heldBytes += entry.m_size;
+                    }
+
+                    Evict(evicted);
+                }
+            }
+
+            mutable AZStd::mutex                        m_mutex;
+            AZStd::unordered_map<AZStd::string, Entry>  m_entries;
+            AZStd::list<AZStd::string>                  m_held; // most recently released first
+            SizeFunction                                m_sizeFunction;
+            ResidentCacheStats                          m_stats;
+        };
+
+        // called with the lock held
+        Pointer Share(const AZStd::string& path, Entry& entry)
+        {
+            ++m_state->m_stats.m_liveCount;
+
+            AZStd::weak_ptr<State> state = m_state;
+            const AZ::u32 generation = ++entry.m_generation;
+            Pointer pointer(entry.m_object.get(), [state, path, generation](T* object)
+            {
+                if (auto owner = state.lock())
+                {
+                    owner->Release(path, generation);
+                }
+                else
+                {
+                    // the cache is gone, it already gave up the ownership of live resources
+                    delete object;
+                }
+            });
+            entry.m_live = pointer;
+            return pointer;
+        }
+
+        AZStd::shared_ptr<State> m_state;
+    };
+}
@@ -1,4 +1,5 @@
 #include "Renderer/Base/Shader.h"
+#include "Renderer/Base/Material.h"
 
 #include <AzCore/StringFunc/StringFunc.h>
 
@@ -22,8 +23,16 @@ namespace Module
         {
             m_passes.emplace_back(passConfig);
         }
+        m_defaultProperties = m_config.Get()->m_properties;
+        m_isLoaded = true;
 
         m_config.Release();
+
+        for (auto material : m_waitingMaterials)
+        {
+            material->AddDefaultProperties(m_defaultProperties);
+        }
+        m_waitingMaterials.clear();
     }
 
     void Shader::SetReverseCull(bool flag)
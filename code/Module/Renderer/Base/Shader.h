@@ -9,6 +9,8 @@
 
 namespace Module
 {
+    class Material;
+
     class Shader
         : public AZStd::intrusive_list_node<Shader>
         , public AZ::Data::AssetBus::Handler
@@ -29,10 +31,21 @@ namespace Module
 
         bool IsValid() const;
 
+        // the config was read, the passes and the default properties are known
+        bool IsLoaded() const { return m_isLoaded; }
+
+        const AZStd::vector<MaterialAsset::Property>& GetDefaultProperties() const { return m_defaultProperties; }
+
     private:
-        AZ::Data::Asset<ShaderAsset> m_config;
-        AZStd::vector<Pass>          m_passes;
+        AZ::Data::Asset<ShaderAsset>           m_config;
+        AZStd::vector<Pass>                    m_passes;
+        AZStd::vector<MaterialAsset::Property> m_defaultProperties;
+        bool                                   m_isLoaded = false;
+
+        // materials loaded before the shader, they take the default properties once it is loaded
+        AZStd::vector<Material*>               m_waitingMaterials;
 
+        friend class Material;
         friend class RendererSystemComponent;
     };
 
@@ -35,16 +35,32 @@ namespace Module
             auto* textureAsset = m_texture->m_asset.Get();
             if (textureAsset)
             {
-                for (auto& spriteData : textureAsset->m_sprites)
-                {
-                    if (spriteData.m_name == m_spriteName)
-                    {
-                        m_spriteData = &spriteData;
-                        return true;
-                    }
-                }
+                m_spriteData = textureAsset->FindSprite(m_spriteName);
+                return m_spriteData != nullptr;
             }
         }
         return false;
     }
+
+    bool Sprite::GetBounds(AZ::Aabb& bounds)
+    {
+        if (!IsValid() || m_spriteData->m_positions.empty())
+        {
+            return false;
+        }
+
+        const float unitsPerPixel = GetUnitsPerPixel();
+
+        bounds = AZ::Aabb::CreateNull();
+        for (const auto& position : m_spriteData->m_positions)
+        {
+            bounds.AddPoint(position * unitsPerPixel);
+        }
+        return true;
+    }
+
+    float Sprite::GetUnitsPerPixel() const
+    {
+        return 1.0f / m_texture->m_asset.Get()->m_pixelsToUnits;
+    }
 }
@@ -2,6 +2,7 @@
 
 #include "Renderer/Base/Texture.h"
 
+#include <AzCore/Math/Aabb.h>
 #include <AzCore/std/smart_ptr/shared_ptr.h>
 
 namespace Module
@@ -23,10 +24,21 @@ namespace Module
 
         bool IsValid();
 
+        // bounds of the sprite mesh in local units, valid once the texture is loaded
+        bool GetBounds(AZ::Aabb& bounds);
+
+        Texture* GetTexture() const { return m_texture.get(); }
+
+        // mesh of the sprite in pixels, null until the sprite is valid
+        const TextureAsset::SpriteData* GetSpriteData() const { return m_spriteData; }
+
+        // scale from the pixels of the sprite mesh to local units
+        float GetUnitsPerPixel() const;
+
     private:
         TexturePtr                m_texture;
         AZStd::string             m_spriteName;
-        TextureAsset::SpriteData* m_spriteData = nullptr;
+        const TextureAsset::SpriteData* m_spriteData = nullptr;
     };
 
     using SpritePtr = AZStd::shared_ptr<Sprite>;
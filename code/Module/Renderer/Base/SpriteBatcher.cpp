@@ -0,0 +1,131 @@
+#include "Renderer/Base/SpriteBatcher.h"
+#include "Renderer/Base/RenderNode.h"
+#include "Renderer/Base/Material.h"
+#include "Renderer/Base/Pass.h"
+#include "Renderer/Base/Texture.h"
+#include "Renderer/Component/RendererComponent.h"
+#include "Renderer/Util/TransientUtil.h"
+
+#include <AzCore/std/algorithm.h>
+
+namespace Module
+{
+    const bgfx::VertexDecl& SpriteBatcher::GetVertexDecl()
+    {
+        // shared by the batchers of all submission jobs, the static initialization runs once
+        static const bgfx::VertexDecl s_decl = []()
+        {
+            bgfx::VertexDecl decl;
+            decl.begin()
+                .add(bgfx::Attrib::Position, 3, bgfx::AttribType::Float)
+                .add(bgfx::Attrib::Color0, 4, bgfx::AttribType::Uint8, true)
+                .add(bgfx::Attrib::TexCoord0, 2, bgfx::AttribType::Float)
+                .end();
+            AZ_Assert(decl.getStride() == sizeof(Vertex), "Sprite vertex declaration does not match the vertex layout\n");
+            return decl;
+        }();
+        return s_decl;
+    }
+
+    void SpriteBatcher::Init()
+    {
+        // the sprite texture replaces the main texture of the material
+        m_texColor = bgfx::createUniform("s_texColor", bgfx::UniformType::Int1);
+    }
+
+    void SpriteBatcher::Shutdown()
+    {
+        if (bgfx::isValid(m_texColor))
+        {
+            bgfx::destroy(m_texColor);
+            m_texColor = BGFX_INVALID_HANDLE;
+        }
+    }
+
+    AZ::u32 SpriteBatcher::Submit(bgfx::Encoder* encoder, bgfx::ViewId viewId, const RenderNode* nodes, const AZ::u32* indices, AZ::u32 count)
+    {
+        auto& first = nodes[indices[0]];
+
+        // take as many nodes as fit into 16 bit indices
+        AZ::u32 vertexCount = 0;
+        AZ::u32 indexCount = 0;
+        AZ::u32 nodeCount = 0;
+        for (; nodeCount < count; ++nodeCount)
+        {
+            AZ::u32 nodeVertexCount = 0;
+            AZ::u32 nodeIndexCount = 0;
+            nodes[indices[nodeCount]].m_renderer->GetBatchGeometrySize(nodeVertexCount, nodeIndexCount);
+            if (nodeCount > 0 && vertexCount + nodeVertexCount > MaxVertexCount)
+            {
+                break;
+            }
+            vertexCount += nodeVertexCount;
+            indexCount += nodeIndexCount;
+        }
+
+        if (vertexCount == 0)
+        {
+            return nodeCount;
+        }
+        if (vertexCount > MaxVertexCount || !Allocate(vertexCount, indexCount))
+        {
+            m_droppedCount += nodeCount;
+            return nodeCount;
+        }
+
+        for (AZ::u32 i = 0; i < nodeCount; ++i)
+        {
+            const auto& node = nodes[indices[i]];
+
+            AZ::u32 nodeVertexCount = 0;
+            AZ::u32 nodeIndexCount = 0;
+            node.m_renderer->GetBatchGeometrySize(nodeVertexCount, nodeIndexCount);
+
+            auto geometry = Append(nodeVertexCount, nodeIndexCount);
+            node.m_renderer->FillBatchGeometry(geometry, node.m_worldMatrix);
+        }
+
+        Bind(encoder);
+        first.m_material->Apply(encoder, first.m_propertyBlock);
+        first.m_batchTexture->Apply(encoder, 0, m_texColor);
+        first.m_pass->Apply(encoder, viewId);
+
+        ++m_batchCount;
+        m_spriteCount += nodeCount;
+
+        return nodeCount;
+    }
+
+    bool SpriteBatcher::Allocate(AZ::u32 vertexCount, AZ::u32 indexCount)
+    {
+        AZ_Assert(vertexCount <= MaxVertexCount, "Too many vertices for one sprite batch\n");
+
+        m_vertexCount = vertexCount;
+        m_indexCount = indexCount;
+        m_usedVertices = 0;
+        m_usedIndices = 0;
+
+        return TransientUtil::AllocBuffers(&m_vertexBuffer, GetVertexDecl(), vertexCount, &m_indexBuffer, indexCount);
+    }
+
+    SpriteBatcher::Geometry SpriteBatcher::Append(AZ::u32 vertexCount, AZ::u32 indexCount)
+    {
+        AZ_Assert(m_usedVertices + vertexCount <= m_vertexCount && m_usedIndices + indexCount <= m_indexCount, "Sprite batch overflow\n");
+
+        Geometry geometry;
+        geometry.m_vertices = reinterpret_cast<Vertex*>(m_vertexBuffer.data) + m_usedVertices;
+        geometry.m_indices = reinterpret_cast<AZ::u16*>(m_indexBuffer.data) + m_usedIndices;
+        geometry.m_baseVertex = static_cast<AZ::u16>(m_usedVertices);
+
+        m_usedVertices += vertexCount;
+        m_usedIndices += indexCount;
+
+        return geometry;
+    }
+
+    void SpriteBatcher::Bind(bgfx::Encoder* encoder)
+    {
+        encoder->setVertexBuffer(0, &m_vertexBuffer, 0, m_usedVertices);
+        encoder->setIndexBuffer(&m_indexBuffer, 0, m_usedIndices);
+    }
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <AzCore/Memory/SystemAllocator.h>
+
+#include <bgfx/bgfx.h>
+
+namespace Module
+{
+    class RenderNode;
+
+    // Shared per frame batcher for 2D geometry. Consecutive render nodes with the same texture, material and pass
+    // write their vertices into one transient buffer pair and are drawn with a single draw call.
+    // A batcher is used by one submission job at a time, each job has its own.
+    class SpriteBatcher
+    {
+    public:
+        AZ_CLASS_ALLOCATOR(SpriteBatcher, AZ::SystemAllocator, 0);
+
+        struct Vertex
+        {
+            float   m_x;
+            float   m_y;
+            float   m_z;
+            AZ::u32 m_abgr;
+            float   m_u;
+            float   m_v;
+        };
+
+        // part of the transient buffers a producer writes its geometry into
+        struct Geometry
+        {
+            Vertex*  m_vertices   = nullptr;
+            AZ::u16* m_indices    = nullptr;
+            AZ::u16  m_baseVertex = 0;
+        };
+
+        // transient geometry is indexed with 16 bits
+        static const AZ::u32 MaxVertexCount = 0xFFFF;
+
+        static const bgfx::VertexDecl& GetVertexDecl();
+
+        SpriteBatcher() = default;
+
+        // non-copyable
+        SpriteBatcher(const SpriteBatcher&) = delete;
+        SpriteBatcher& operator=(const SpriteBatcher&) = delete;
+
+        // needs an initialized bgfx
+        void Init();
+        void Shutdown();
+
+        // draws as many of the nodes at `indices` as fit into one batch and returns how many were drawn, the
+        // nodes must share texture, material and pass
+        AZ::u32 Submit(bgfx::Encoder* encoder, bgfx::ViewId viewId, const RenderNode* nodes, const AZ::u32* indices, AZ::u32 count);
+
+        // allocates the transient buffers of one draw call, fails when transient memory is exhausted
+        bool Allocate(AZ::u32 vertexCount, AZ::u32 indexCount);
+
+        // hands out the next part of the allocated buffers
+        Geometry Append(AZ::u32 vertexCount, AZ::u32 indexCount);
+
+        // sets the allocated buffers for the next draw call
+        void Bind(bgfx::Encoder* encoder);
+
+        AZ::u32 GetBatchCount() const { return m_batchCount; }
+        AZ::u32 GetSpriteCount() const { return m_spriteCount; }
+        // sprites skipped by Submit because the transient buffers of their batch could not be allocated
+        AZ::u32 GetDroppedCount() const { return m_droppedCount; }
+        void ResetStats() { m_batchCount = 0; m_spriteCount = 0; m_droppedCount = 0; }
+
+    private:
+        bgfx::UniformHandle           m_texColor    = BGFX_INVALID_HANDLE;
+
+        bgfx::TransientVertexBuffer   m_vertexBuffer;
+        bgfx::TransientIndexBuffer    m_indexBuffer;
+        AZ::u32                       m_vertexCount = 0;
+        AZ::u32                       m_indexCount  = 0;
+        AZ::u32                       m_usedVertices = 0;
+        AZ::u32                       m_usedIndices  = 0;
+
+        AZ::u32                       m_batchCount  = 0;
+        AZ::u32                       m_spriteCount = 0;
+        AZ::u32                       m_droppedCount = 0;
+    };
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "Renderer/Base/Material.h"
+#include "Renderer/Base/Mesh.h"
+
+#include <AzCore/Math/Aabb.h>
+#include <AzCore/std/containers/vector.h>
+#include <AzCore/std/smart_ptr/unique_ptr.h>
+
+namespace Module
+{
+    // Geometry of static renderers sharing a material, pre-transformed to world space and merged into one mesh.
+    // Every merged sub mesh keeps its own index range and bounds so it can still be culled on its own.
+    struct StaticBatch
+    {
+        AZ_CLASS_ALLOCATOR(StaticBatch, AZ::SystemAllocator, 0);
+
+        struct Range
+        {
+            AZ::Aabb m_worldBounds = AZ::Aabb::CreateNull();
+            AZ::u32  m_firstIndex  = 0;
+            AZ::u32  m_indexCount  = 0;
+        };
+
+        MaterialPtr          m_material;
+        AZ::s16              m_sortingLayer = 0;
+        AZ::s16              m_orderInLayer = 0;
+        AZ::u16              m_sortingRank  = 0;
+        AZ::u8               m_layer        = 0;
+
+        Mesh                 m_mesh;
+        AZ::Aabb             m_worldBounds  = AZ::Aabb::CreateNull();
+        AZStd::vector<Range> m_ranges;
+    };
+
+    using StaticBatchPtr = AZStd::unique_ptr<StaticBatch>;
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <AzCore/Memory/SystemAllocator.h>
+
+namespace Module
+{
+    class RenderNode;
+
+    // Bindings left in an encoder by the previous submit of a submission job. Consecutive nodes that share material
+    // and pass are submitted with preserved state, the following node then only sets what differs.
+    struct SubmitState
+    {
+        AZ_CLASS_ALLOCATOR(SubmitState, AZ::SystemAllocator, 0);
+
+        // bind calls that were skipped because the encoder still held the same values
+        struct Stats
+        {
+            AZ::u32 m_savedGeometryBinds = 0;
+            AZ::u32 m_savedMaterialBinds = 0;
+            AZ::u32 m_savedStateBinds    = 0;
+        };
+
+        const RenderNode* m_boundNode = nullptr; // node submitted with preserved state, nullptr after a discard
+        Stats             m_stats;
+    };
+}
@@ -4,6 +4,12 @@
 
 namespace Module
 {
+    AZ::u16 Texture::NextSortId()
+    {
+        static AZ::u16 s_nextSortId = 0;
+        return s_nextSortId++;
+    }
+
     Texture::Texture()
     {
     }
@@ -26,6 +32,7 @@ namespace Module
         m_asset = rhv.m_asset;
         m_handle = rhv.m_handle;
         m_info = rhv.m_info;
+        m_sortId = rhv.m_sortId;
 
         rhv.m_handle = BGFX_INVALID_HANDLE;
 
@@ -57,11 +64,11 @@ namespace Module
         m_info = m_asset.Get()->m_info;
     }
 
-    void Texture::Apply(int stage, bgfx::UniformHandle uniform)
+    void Texture::Apply(bgfx::Encoder* encoder, int stage, bgfx::UniformHandle uniform)
     {
         if (bgfx::isValid(uniform) && bgfx::isValid(m_handle))
         {
-            bgfx::setTexture(stage, uniform, m_handle);
+            encoder->setTexture(stage, uniform, m_handle);
         }
     }
 }
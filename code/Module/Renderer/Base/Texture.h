@@ -36,12 +36,18 @@ namespace Module
 
         bool IsValid() const { return bgfx::isValid(m_handle); }
 
-        void Apply(int stage, bgfx::UniformHandle uniform);
+        void Apply(bgfx::Encoder* encoder, int stage, bgfx::UniformHandle uniform);
+
+        // unique per texture instance, used to keep sprites of the same texture adjacent so they can be batched
+        AZ::u16 GetSortId() const { return m_sortId; }
 
     private:
+        static AZ::u16 NextSortId();
+
         AZ::Data::Asset<TextureAsset> m_asset;
         bgfx::TextureHandle           m_handle = BGFX_INVALID_HANDLE;
         bgfx::TextureInfo             m_info   = {};
+        AZ::u16                       m_sortId = NextSortId();
 
         friend class Sprite;
     };
@@ -0,0 +1,122 @@
+#include "Renderer/Base/TransientGeometry.h"
+#include "Renderer/Util/TransientUtil.h"
+
+#include <AzCore/std/parallel/lock.h>
+
+namespace Module
+{
+    TransientGeometry::Range TransientGeometry::Allocate(const bgfx::VertexDecl& decl, AZ::u32 vertexCount, AZ::u32 indexCount)
+    {
+        Range range;
+        if (vertexCount == 0 || indexCount == 0 || vertexCount > MaxBlockVertexCount)
+        {
+            return range;
+        }
+
+        AZStd::lock_guard<AZStd::mutex> lock(m_mutex);
+
+        // only the latest block of a layout is still filled
+        Block* block = nullptr;
+        for (size_t i = m_blocks.size(); i > 0; --i)
+        {
+            if (m_blocks[i - 1].m_layoutHash == decl.m_hash)
+            {
+                block = &m_blocks[i - 1];
+                break;
+            }
+        }
+
+        if (block == nullptr
+            || block->m_usedVertices + vertexCount > block->m_vertexCount
+            || block->m_usedIndices + indexCount > block->m_indexCount)
+        {
+            AZ_Assert(m_blocks.size() < InvalidBlock, "Too many transient geometry blocks\n");
+
+            Block newBlock;
+            newBlock.m_layoutHash = decl.m_hash;
+            newBlock.m_vertexCount = AZStd::GetMax<AZ::u32>(vertexCount, AZ::u32(BlockVertexCount));
+            newBlock.m_indexCount = AZStd::GetMax<AZ::u32>(indexCount, AZ::u32(BlockIndexCount));
+
+            // a block the size of the range alone when the full one does not fit anymore
+            if (!TransientUtil::AllocBuffers(&newBlock.m_vertexBuffer, decl, newBlock.m_vertexCount, &newBlock.m_indexBuffer, newBlock.m_indexCount))
+            {
+                newBlock.m_vertexCount = vertexCount;
+                newBlock.m_indexCount = indexCount;
+                if (!TransientUtil::AllocBuffers(&newBlock.m_vertexBuffer, decl, vertexCount, &newBlock.m_indexBuffer, indexCount))
+                {
+                    AZ_Warning("TransientGeometry", m_failedCount > 0, "Out of transient memory, geometry is dropped for this frame\n");
+                    ++m_failedCount;
+                    return range;
+                }
+            }
+
+            m_blocks.push_back(newBlock);
+            block = &m_blocks.back();
+        }
+
+        range.m_vertices = block->m_vertexBuffer.data + block->m_usedVertices * decl.getStride();
+        range.m_indices = reinterpret_cast<AZ::u16*>(block->m_indexBuffer.data) + block->m_usedIndices;
+        range.m_baseVertex = static_cast<AZ::u16>(block->m_usedVertices);
+        range.m_block = static_cast<AZ::u16>(block - m_blocks.data());
+        range.m_firstIndex = block->m_usedIndices;
+        range.m_vertexCount = vertexCount;
+        range.m_indexCount = indexCount;
+        range.m_frame = m_frame;
+
+        block->m_usedVertices += vertexCount;
+        block->m_usedIndices += indexCount;
+        ++m_rangeCount;
+        return range;
+    }
+
+    TransientGeometry::Range TransientGeometry::AllocateCopy(const bgfx::VertexDecl& decl, const void* vertices, AZ::u32 vertexCount, const AZ::u16* indices, AZ::u32 indexCount)
+    {
+        const Range range = Allocate(decl, vertexCount, indexCount);
+        if (range.IsValid())
+        {
+            memcpy(range.m_vertices, vertices, vertexCount * decl.getStride());
+            for (AZ::u32 i = 0; i < indexCount; ++i)
+            {
+                range.m_indices[i] = indices[i] + range.m_baseVertex;
+            }
+        }
+        return range;
+    }
+
+    void TransientGeometry::Apply(bgfx::Encoder* encoder, const Range& range, AZ::u32 firstIndex, AZ::u32 indexCount) const
+    {
+        AZ_Assert(IsCurrent(range), "Transient geometry of another frame\n");
+
+        const auto& block = m_blocks[range.m_block];
+        encoder->setVertexBuffer(0, &block.m_vertexBuffer, 0, block.m_usedVertices);
+        encoder->setIndexBuffer(&block.m_indexBuffer, firstIndex, indexCount);
+    }
+
+    void TransientGeometry::NextFrame()
+    {
+        AZStd::lock_guard<AZStd::mutex> lock(m_mutex);
+
+        m_blocks.clear();
+        m_rangeCount = 0;
+        m_failedCount = 0;
+
+        // 0 is never a frame, default constructed ranges are never current
+        m_frame = m_frame + 1 != 0 ? m_frame + 1 : 1;
+    }
+
+    TransientGeometry::Stats TransientGeometry::GetStats() const
+    {
+        AZStd::lock_guard<AZStd::mutex> lock(m_mutex);
+
+        Stats stats;
+        stats.m_blockCount = static_cast<AZ::u32>(m_blocks.size());
+        stats.m_rangeCount = m_rangeCount;
+        stats.m_failedCount = m_failedCount;
+        for (const auto& block : m_blocks)
+        {
+            stats.m_usedVertexBytes += block.m_usedVertices * block.m_vertexBuffer.stride;
+            stats.m_reservedVertexBytes += block.m_vertexCount * block.m_vertexBuffer.stride;
+        }
+        return stats;
+    }
+}
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <AzCore/Memory/SystemAllocator.h>
+#include <AzCore/std/containers/vector.h>
+#include <AzCore/std/parallel/mutex.h>
+
+#include <bgfx/bgfx.h>
+
+namespace Module
+{
+    // Per frame ring of geometry for renderers that rebuild their vertices every frame, like particles, skeletal 2D
+    // animation, canvases and UI. Producers write straight into bgfx transient memory instead of keeping a cpu copy
+    // and a dynamic buffer of their own. Ranges are carved out of blocks of a few thousand vertices per vertex layout,
+    // consecutive ranges of a producer usually share a block and can be drawn with one index range.
+    //
+    // The blocks are bgfx transient buffers, a range is only valid until the next bgfx::frame, after which the
+    // renderer system starts the next frame of the ring. Producers write their ranges after the renderer ticked and
+    // the render nodes bind them on the next tick.
+    class TransientGeometry
+    {
+    public:
+        AZ_CLASS_ALLOCATOR(TransientGeometry, AZ::SystemAllocator, 0);
+
+        // transient geometry is indexed with 16 bits, a block never has more vertices
+        static const AZ::u32 MaxBlockVertexCount = 0xFFFF;
+        static const AZ::u32 BlockVertexCount    = 4096;
+        static const AZ::u32 BlockIndexCount     = BlockVertexCount * 3 / 2; // quads
+        static const AZ::u16 InvalidBlock        = 0xFFFF;
+
+        struct Range
+        {
+            void*    m_vertices    = nullptr;
+            AZ::u16* m_indices     = nullptr;
+            AZ::u16  m_baseVertex  = 0;            // indices address the whole block, add it to the ones written
+            AZ::u16  m_block       = InvalidBlock;
+            AZ::u32  m_firstIndex  = 0;            // in the block
+            AZ::u32  m_vertexCount = 0;
+            AZ::u32  m_indexCount  = 0;
+            AZ::u32  m_frame       = 0;
+
+            bool IsValid() const { return m_block != InvalidBlock; }
+
+            template <typename Vertex>
+            Vertex* GetVertices() const { return static_cast<Vertex*>(m_vertices); }
+        };
+
+        struct Stats
+        {
+            AZ::u32 m_blockCount          = 0;
+            AZ::u32 m_rangeCount          = 0;
+            AZ::u32 m_failedCount         = 0; // ranges which did not fit into transient memory
+            AZ::u32 m_usedVertexBytes     = 0;
+            AZ::u32 m_reservedVertexBytes = 0;
+        };
+
+        TransientGeometry() = default;
+
+        // non-copyable
+        TransientGeometry(const TransientGeometry&) = delete;
+        TransientGeometry& operator=(const TransientGeometry&) = delete;
+
+        // Returns an invalid range when transient memory is exhausted or the range is larger than a block can be, the
+        // producer does not draw for the frame. Safe to call from several threads, not while the ranges are submitted.
+        Range Allocate(const bgfx::VertexDecl& decl, AZ::u32 vertexCount, AZ::u32 indexCount);
+
+        // for producers that keep their geometry between frames, copies it in and offsets the indices
+        Range AllocateCopy(const bgfx::VertexDecl& decl, const void* vertices, AZ::u32 vertexCount, const AZ::u16* indices, AZ::u32 indexCount);
+
+        // whether `range` was allocated since the last bgfx::frame
+        bool IsCurrent(const Range& range) const { return range.IsValid() && range.m_frame == m_frame; }
+
+        // `next` continues the indices of `first` in the same block, both can be drawn with one index range
+        static bool IsContiguous(const Range& first, const Range& next)
+        {
+            return first.IsValid() && first.m_block == next.m_block && first.m_frame == next.m_frame
+                && first.m_firstIndex + first.m_indexCount == next.m_firstIndex;
+        }
+
+        // binds the block of a current range with `indexCount` of its indices from `firstIndex` on
+        void Apply(bgfx::Encoder* encoder, const Range& range, AZ::u32 firstIndex, AZ::u32 indexCount) const;
+
+        void Apply(bgfx::Encoder* encoder, const Range& range) const { Apply(encoder, range, range.m_firstIndex, range.m_indexCount); }
+
+        // the buffers of the block of a current range, for binding it without an encoder
+        const bgfx::TransientVertexBuffer* GetVertexBuffer(const Range& range) const { return &m_blocks[range.m_block].m_vertexBuffer; }
+        const bgfx::TransientIndexBuffer*  GetIndexBuffer(const Range& range) const { return &m_blocks[range.m_block].m_indexBuffer; }
+
+        // drops the blocks of the frame bgfx::frame just handed over
+        void NextFrame();
+
+        Stats GetStats() const;
+
+    private:
+        struct Block
+        {
+            bgfx::TransientVertexBuffer m_vertexBuffer;
+            bgfx::TransientIndexBuffer  m_indexBuffer;
+            AZ::u32                     m_layoutHash   = 0;
+            AZ::u32                     m_vertexCount  = 0;
+            AZ::u32                     m_indexCount   = 0;
+            AZ::u32                     m_usedVertices = 0;
+            AZ::u32                     m_usedIndices  = 0;
+        };
+
+        mutable AZStd::mutex m_mutex;
+        AZStd::vector<Block> m_blocks;
+        AZ::u32              m_frame       = 1;
+        AZ::u32              m_rangeCount  = 0;
+        AZ::u32              m_failedCount = 0;
+    };
+}
@@ -0,0 +1,23 @@
+#include "Renderer/Base/Vertex2d.h"
+
+#include <AzCore/Debug/Trace.h>
+
+namespace Module
+{
+    const bgfx::VertexDecl& Vertex2d::GetVertexDecl()
+    {
+        // a function local static is initialized once even when submission jobs ask for it concurrently
+        static const bgfx::VertexDecl s_decl = []()
+        {
+            bgfx::VertexDecl decl;
+            decl.begin()
+                .add(bgfx::Attrib::Position, 2, bgfx::AttribType::Float)
+                .add(bgfx::Attrib::TexCoord0, 2, bgfx::AttribType::Int16, true)
+                .add(bgfx::Attrib::Color0, 4, bgfx::AttribType::Uint8, true)
+                .end();
+            AZ_Assert(decl.getStride() == sizeof(Vertex2d), "2D vertex declaration does not match the vertex layout\n");
+            return decl;
+        }();
+        return s_decl;
+    }
+}
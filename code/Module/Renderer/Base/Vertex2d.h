@@ -0,0 +1,67 @@
+#pragma once
+
+#include <AzCore/base.h>
+#include <AzCore/Debug/Trace.h>
+
+#include <bgfx/bgfx.h>
+
+namespace Module
+{
+    // Vertex of the 2D producers, particles, skeletal 2D animation, canvases and UI, 16 bytes instead of the 32 of
+    // a float position, texture coordinate and color. The texture coordinates are signed normalized 16 bit integers
+    // and the color is normalized 8 bit, the vertex fetch turns both back into floats so the shaders read the same
+    // inputs as with floats. Texture coordinates have to stay within [-1, 1], which atlases and frame sheets do.
+    struct Vertex2d
+    {
+        float   m_x;
+        float   m_y;
+        AZ::s16 m_u;
+        AZ::s16 m_v;
+        AZ::u32 m_abgr;
+
+        static const bgfx::VertexDecl& GetVertexDecl();
+
+        // tiled coordinates past [-1, 1] would be clamped, they need the float layout
+        static AZ::s16 PackTexcoord(float value)
+        {
+            AZ_Assert(value >= -1.0f && value <= 1.0f, "Texture coordinate %f is outside of the [-1, 1] range of Vertex2d\n", value);
+            const float scaled = value * 32767.0f;
+            const float clamped = scaled < -32767.0f ? -32767.0f : (scaled > 32767.0f ? 32767.0f : scaled);
+            // rounds half away from zero without a call into the math library
+            return static_cast<AZ::s16>(static_cast<AZ::s32>(clamped + (clamped < 0.0f ? -0.5f : 0.5f)));
+        }
+
+        static AZ::u32 PackColor(AZ::u8 r, AZ::u8 g, AZ::u8 b, AZ::u8 a)
+        {
+            return AZ::u32(r) | (AZ::u32(g) << 8) | (AZ::u32(b) << 16) | (AZ::u32(a) << 24);
+        }
+
+        // components in [0, 1], as AZ::Color::ToU32 packs them
+        static AZ::u32 PackColor(float r, float g, float b, float a)
+        {
+            return PackColor(PackUnorm8(r), PackUnorm8(g), PackUnorm8(b), PackUnorm8(a));
+        }
+
+        void Set(float x, float y, float u, float v, AZ::u32 abgr)
+        {
+            m_x = x;
+            m_y = y;
+            m_u = PackTexcoord(u);
+            m_v = PackTexcoord(v);
+            m_abgr = abgr;
+        }
+
+        void SetTexcoord(float u, float v)
+        {
+            m_u = PackTexcoord(u);
+            m_v = PackTexcoord(v);
+        }
+
+    private:
+        static AZ::u8 PackUnorm8(float value)
+        {
+            const float clamped = value < 0.0f ? 0.0f : (value > 1.0f ? 1.0f : value);
+            return static_cast<AZ::u8>(clamped * 255.0f + 0.5f);
+        }
+    };
+}
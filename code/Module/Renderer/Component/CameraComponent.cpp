@@ -27,6 +27,8 @@ namespace Module
                 ->Field("ClipNear", &CameraComponent::m_clipNear)
                 ->Field("ClipFar", &CameraComponent::m_clipFar)
                 ->Field("Depth", &CameraComponent::m_depth)
+                ->Field("CullingMask", &CameraComponent::m_cullingMask)
+                ->Field("OcclusionCulling", &CameraComponent::m_isOcclusionCulling)
                 ;
         }
         
@@ -52,6 +54,13 @@ namespace Module
                 ->Event("SetRect", &CameraRequestBus::Events::SetRect)
                 ->Event("GetDepth", &CameraRequestBus::Events::GetDepth)
                 ->Event("SetDepth", &CameraRequestBus::Events::SetDepth)
+                ->Event("GetCullingMask", &CameraRequestBus::Events::GetCullingMask)
+                ->Event("SetCullingMask", &CameraRequestBus::Events::SetCullingMask)
+                ->Event("IsOcclusionCulling", &CameraRequestBus::Events::IsOcclusionCulling)
+                ->Event("SetOcclusionCulling", &CameraRequestBus::Events::SetOcclusionCulling)
+                ->Event("GetVisibleCount", &CameraRequestBus::Events::GetVisibleCount)
+                ->Event("GetCulledCount", &CameraRequestBus::Events::GetCulledCount)
+                ->Event("GetOccludedCount", &CameraRequestBus::Events::GetOccludedCount)
                 ;
 
             behaviorContext->Class<CameraClearFlags>("CameraClearFlags")
@@ -70,6 +79,8 @@ namespace Module
                 ->Property("clearColor", BehaviorValueProperty(&CameraComponent::m_clearColor))
                 ->Property("isOrthographic", BehaviorValueProperty(&CameraComponent::m_isOrthographic))
                 ->Property("depth", BehaviorValueProperty(&CameraComponent::m_depth))
+                ->Property("cullingMask", BehaviorValueProperty(&CameraComponent::m_cullingMask))
+                ->Property("isOcclusionCulling", BehaviorValueProperty(&CameraComponent::m_isOcclusionCulling))
                 ->Property("size", BehaviorValueProperty(&CameraComponent::m_size))
                 ->Property("fov", BehaviorValueProperty(&CameraComponent::m_fov))
                 ->Property("clipNear", BehaviorValueProperty(&CameraComponent::m_clipNear))
@@ -166,9 +177,24 @@ namespace Module
 
         bgfx::setViewTransform(id, m_modelTM, projectionMatrix);
 
+        bx::mtxMul(m_viewProjectionTM, m_modelTM, projectionMatrix);
+        m_frustum.SetFromViewProjection(m_viewProjectionTM, bgfx::getCaps()->homogeneousDepth);
+
         bgfx::touch(id);
     }
 
+    float CameraComponent::GetScreenHeight(float radius, float distance) const
+    {
+        if (m_isOrthographic)
+        {
+            return m_size > 0.0f ? radius / m_size : 0.0f;
+        }
+
+        // the projection of ResetView, m_fov is the vertical field of view in degrees
+        const float halfHeight = distance * bx::tan(bx::toRad(m_fov) * 0.5f);
+        return halfHeight > radius ? radius / halfHeight : 1.0f;
+    }
+
     void CameraComponent::DrawSkybox(bgfx::ViewId id)
     {
         if (m_clearFlags == CameraClearFlags::Skybox)
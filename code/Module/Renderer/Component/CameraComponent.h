@@ -4,6 +4,7 @@
 #include <AzCore/Component/TransformBus.h>
 
 #include "Renderer/EBus/CameraComponentBus.h"
+#include "Renderer/Base/Frustum.h"
 
 #include <AzCore/Math/Color.h>
 
@@ -51,6 +52,16 @@ namespace Module
         void ResetView(bgfx::ViewId id);
         void DrawSkybox(bgfx::ViewId id);
 
+        bool IsVisible(const AZ::Aabb& worldBounds) const { return m_frustum.IntersectAabb(worldBounds); }
+
+        const Frustum& GetFrustum() const { return m_frustum; }
+
+        // bx style (row vector) view projection matrix of the last ResetView
+        const float* GetViewProjection() const { return m_viewProjectionTM; }
+
+        // fraction of the viewport height a sphere covers at `distance` from the camera, levels of detail are picked by it
+        float GetScreenHeight(float radius, float distance) const;
+
     protected:
         /////////////////////////////////////////////////////////////////////////////////////
         // AZ::TransformNotificationBus::Handler
@@ -85,6 +96,16 @@ namespace Module
         
         int                GetDepth() const override                      { return m_depth; }
         void               SetDepth(int value) override                   { m_depth = value;}
+
+        AZ::u32            GetCullingMask() const override                { return m_cullingMask; }
+        void               SetCullingMask(AZ::u32 mask) override          { m_cullingMask = mask; }
+
+        bool               IsOcclusionCulling() const override            { return m_isOcclusionCulling; }
+        void               SetOcclusionCulling(bool value) override       { m_isOcclusionCulling = value; }
+
+        AZ::u32            GetVisibleCount() const override               { return m_visibleCount; }
+        AZ::u32            GetCulledCount() const override                { return m_culledCount; }
+        AZ::u32            GetOccludedCount() const override              { return m_occludedCount; }
         /////////////////////////////////////////////////////////////////////////////////////
 
     private:
@@ -95,6 +116,8 @@ namespace Module
         bool             m_isOrthographic = false;
 
         int              m_depth          = 0;
+        AZ::u32          m_cullingMask    = 0xFFFFFFFF;
+        bool             m_isOcclusionCulling = false;
         float            m_size           = 5.0f;
         float            m_fov            = 60.0f;
 
@@ -104,6 +127,12 @@ namespace Module
         AZ::Vector4      m_viewport       = AZ::Vector4(0, 0, 1, 1);
 
         float            m_modelTM[16]    = {};
+        float            m_viewProjectionTM[16] = {};
+
+        Frustum          m_frustum;
+        AZ::u32          m_visibleCount   = 0;
+        AZ::u32          m_culledCount    = 0;
+        AZ::u32          m_occludedCount  = 0;
 
         friend class RendererSystemComponent;
     };
@@ -0,0 +1,64 @@
+#include "Renderer/Component/LodGroupComponent.h"
+
+#include <AzCore/Serialization/SerializeContext.h>
+#include <AzCore/RTTI/BehaviorContext.h>
+
+namespace Module
+{
+    void LodGroupComponent::Reflect(AZ::ReflectContext* context)
+    {
+        if (auto serializeContext = azrtti_cast<AZ::SerializeContext*>(context))
+        {
+            serializeContext->Class<LodLevel>()
+                ->Field("Mesh", &LodLevel::m_mesh)
+                ->Field("ScreenHeight", &LodLevel::m_screenHeight);
+
+            serializeContext->Class<LodGroupComponent, AZ::Component>()
+                ->Field("Levels", &LodGroupComponent::m_levels)
+                ->Field("Hysteresis", &LodGroupComponent::m_hysteresis)
+                ->Field("CrossFadeTime", &LodGroupComponent::m_crossFadeTime);
+        }
+
+        if (auto behaviorContext = azrtti_cast<AZ::BehaviorContext*>(context))
+        {
+            behaviorContext->EBus<LodGroupRequestBus>("LodGroupRequestBus")
+                ->Event("GetHysteresis", &LodGroupRequestBus::Events::GetHysteresis)
+                ->Event("SetHysteresis", &LodGroupRequestBus::Events::SetHysteresis)
+                ->Event("GetCrossFadeTime", &LodGroupRequestBus::Events::GetCrossFadeTime)
+                ->Event("SetCrossFadeTime", &LodGroupRequestBus::Events::SetCrossFadeTime);
+        }
+    }
+
+    void LodGroupComponent::Activate()
+    {
+        LodGroupRequestBus::Handler::BusConnect(GetEntityId());
+    }
+
+    void LodGroupComponent::Deactivate()
+    {
+        LodGroupRequestBus::Handler::BusDisconnect();
+    }
+
+    void LodGroupComponent::SetLevels(const AZStd::vector<LodLevel>& levels)
+    {
+        m_levels = levels;
+        NotifyChanged();
+    }
+
+    void LodGroupComponent::SetHysteresis(float value)
+    {
+        m_hysteresis = value;
+        NotifyChanged();
+    }
+
+    void LodGroupComponent::SetCrossFadeTime(float value)
+    {
+        m_crossFadeTime = value;
+        NotifyChanged();
+    }
+
+    void LodGroupComponent::NotifyChanged()
+    {
+        EBUS_EVENT_ID(GetEntityId(), LodGroupNotificationBus, OnLodGroupChanged);
+    }
+}
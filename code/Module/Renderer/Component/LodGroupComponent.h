@@ -0,0 +1,63 @@
+#pragma once
+
+#include <AzCore/Component/Component.h>
+
+#include "Renderer/EBus/LodGroupComponentBus.h"
+
+namespace Module
+{
+    // Lists the meshes a MeshRendererComponent on the same entity switches between with its size on screen
+    class LodGroupComponent
+        : public AZ::Component
+        , protected LodGroupRequestBus::Handler
+    {
+    public:
+        AZ_COMPONENT(LodGroupComponent, "{4D8A22A8-B7AD-42D3-82D8-7862CE6DB220}");
+
+        static void GetProvidedServices(AZ::ComponentDescriptor::DependencyArrayType& provided)
+        {
+            provided.push_back(AZ_CRC("LodGroupService"));
+        }
+
+        static void GetIncompatibleServices(AZ::ComponentDescriptor::DependencyArrayType& incompatible)
+        {
+            incompatible.push_back(AZ_CRC("LodGroupService"));
+        }
+
+        static void GetDependentServices(AZ::ComponentDescriptor::DependencyArrayType& dependent)
+        {
+        }
+
+        static void GetRequiredServices(AZ::ComponentDescriptor::DependencyArrayType& required)
+        {
+        }
+
+        static void Reflect(AZ::ReflectContext* context);
+
+        /////////////////////////////////////////////////////////////////////////////////////
+        // AZ::Component
+        void Activate() override;
+        void Deactivate() override;
+        /////////////////////////////////////////////////////////////////////////////////////
+
+    protected:
+        /////////////////////////////////////////////////////////////////////////////////////
+        // LodGroupRequestBus::Handler
+        const AZStd::vector<LodLevel>& GetLevels() const                              override { return m_levels; }
+        void                           SetLevels(const AZStd::vector<LodLevel>& levels) override;
+
+        float GetHysteresis() const                override { return m_hysteresis; }
+        void  SetHysteresis(float value)           override;
+
+        float GetCrossFadeTime() const             override { return m_crossFadeTime; }
+        void  SetCrossFadeTime(float value)        override;
+        /////////////////////////////////////////////////////////////////////////////////////
+
+    private:
+        void NotifyChanged();
+
+        AZStd::vector<LodLevel> m_levels;
+        float                   m_hysteresis    = 0.1f;
+        float                   m_crossFadeTime = 0.0f;
+    };
+}
@@ -1,6 +1,7 @@
 #include "Renderer/Component/MeshRendererComponent.h"
 
 #include "Renderer/EBus/MeshFilterComponentBus.h"
+#include "Renderer/EBus/RendererSystemComponentBus.h"
 
 #include <AzCore/Serialization/SerializeContext.h>
 #include <AzCore/RTTI/BehaviorContext.h>
@@ -21,18 +22,139 @@ namespace Module
         RendererComponent::Activate();
 
         EBUS_EVENT_ID_RESULT(m_mesh, GetEntityId(), MeshFilterRequestBus, GetMesh);
+
+        LoadLodGroup();
+        LodGroupNotificationBus::Handler::BusConnect(GetEntityId());
     }
 
     void MeshRendererComponent::Deactivate()
     {
+        LodGroupNotificationBus::Handler::BusDisconnect();
+
         RendererComponent::Deactivate();
+
+        m_lodGroup.m_levels.clear();
+        m_mesh = nullptr;
+    }
+
+    void MeshRendererComponent::PrepareRender()
+    {
+        if (m_mesh)
+        {
+            m_mesh->UpdateBuffers();
+        }
+
+        // levels still loading are created once they are ready, the renderer stays dirty until then
+        for (auto& level : m_lodGroup.m_levels)
+        {
+            if (level.m_mesh && level.m_mesh != m_mesh && level.m_mesh->GetAabb().IsValid())
+            {
+                level.m_mesh->UpdateBuffers();
+            }
+        }
     }
 
-    void MeshRendererComponent::Render(size_t subMeshIndex)
+    void MeshRendererComponent::Render(bgfx::Encoder* encoder, size_t subMeshIndex)
     {
         if (m_mesh)
         {
-            m_mesh->ApplySubMesh(subMeshIndex);
+            m_mesh->ApplySubMesh(encoder, subMeshIndex);
+        }
+    }
+
+    bool MeshRendererComponent::GetLocalBounds(AZ::Aabb& bounds) const
+    {
+        if (m_mesh && m_mesh->GetAabb().IsValid())
+        {
+            bounds = m_mesh->GetAabb();
+            return true;
+        }
+        return false;
+    }
+
+    Mesh* MeshRendererComponent::GetSharedMesh() const
+    {
+        // dynamic meshes change their vertices, they are neither instanced nor batched
+        return m_mesh && !m_mesh->IsDynamic() ? m_mesh.get() : nullptr;
+    }
+
+    const QuantizeUtil::Dequantization* MeshRendererComponent::GetDequantization() const
+    {
+        return m_mesh ? &m_mesh->GetDequantization() : nullptr;
+    }
+
+    const LodGroup* MeshRendererComponent::GetLodGroup() const
+    {
+        return m_lodGroup.m_levels.empty() ? nullptr : &m_lodGroup;
+    }
+
+    void MeshRendererComponent::SetResidentLods(AZ::u32 mask)
+    {
+        bool isChanged = false;
+        for (size_t i = 0; i < m_lodGroup.m_levels.size(); ++i)
+        {
+            auto& level = m_lodGroup.m_levels[i];
+            if (level.m_path.empty())
+            {
+                continue;
+            }
+
+            const bool isResident = (mask & (1u << i)) != 0;
+            if (isResident && !level.m_mesh)
+            {
+                // served from the mesh cache when it was released recently
+                EBUS_EVENT_RESULT(level.m_mesh, RendererSystemRequestBus, GetMesh, level.m_path);
+                isChanged = true;
+            }
+            else if (!isResident && level.m_mesh)
+            {
+                level.m_mesh = nullptr;
+                isChanged = true;
+            }
+        }
+
+        if (isChanged)
+        {
+            MarkDirty();
+        }
+    }
+
+    void MeshRendererComponent::OnLodGroupChanged()
+    {
+        LoadLodGroup();
+        MarkDirty();
+    }
+
+    void MeshRendererComponent::LoadLodGroup()
+    {
+        AZStd::vector<LodLevel> levels;
+        EBUS_EVENT_ID_RESULT(levels, GetEntityId(), LodGroupRequestBus, GetLevels);
+
+        m_lodGroup.m_levels.clear();
+        EBUS_EVENT_ID_RESULT(m_lodGroup.m_hysteresis, GetEntityId(), LodGroupRequestBus, GetHysteresis);
+        EBUS_EVENT_ID_RESULT(m_lodGroup.m_crossFadeTime, GetEntityId(), LodGroupRequestBus, GetCrossFadeTime);
+
+        AZ_Warning("Renderer", levels.size() <= LodGroup::MaxLevels, "Only the first %u levels of detail are used\n", LodGroup::MaxLevels);
+        for (size_t i = 0; i < levels.size() && i < LodGroup::MaxLevels; ++i)
+        {
+            LodGroup::Level level;
+            level.m_path = levels[i].m_mesh;
+            level.m_screenHeight = levels[i].m_screenHeight;
+            if (level.m_path.empty())
+            {
+                level.m_mesh = m_mesh;
+            }
+            else
+            {
+                EBUS_EVENT_RESULT(level.m_mesh, RendererSystemRequestBus, GetMesh, level.m_path);
+            }
+            m_lodGroup.m_levels.push_back(AZStd::move(level));
         }
     }
+
+    bool MeshRendererComponent::IsReady() const
+    {
+        // the aabb is only known once the mesh asset has been loaded
+        return m_mesh && m_mesh->GetAabb().IsValid() && RendererComponent::IsReady();
+    }
 }
@@ -2,8 +2,10 @@
 
 #include "Renderer/Component/RendererComponent.h"
 
+#include "Renderer/Base/LodGroup.h"
 #include "Renderer/Base/Mesh.h"
 
+#include "Renderer/EBus/LodGroupComponentBus.h"
 #include "Renderer/EBus/MeshRendererComponentBus.h"
 
 namespace Module
@@ -11,6 +13,7 @@ namespace Module
     class MeshRendererComponent
         : public RendererComponent
         , protected MeshRendererRequestBus::Handler
+        , protected LodGroupNotificationBus::Handler
     {
     public:
         AZ_COMPONENT(MeshRendererComponent, "{E0FCB0EB-CA85-4468-B514-1CA2FD2481CA}", RendererComponent);
@@ -28,6 +31,7 @@ namespace Module
         static void GetDependentServices(AZ::ComponentDescriptor::DependencyArrayType& dependent)
         {
             dependent.push_back(AZ_CRC("MeshProviderService"));
+            dependent.push_back(AZ_CRC("LodGroupService"));
         }
 
         static void GetRequiredServices(AZ::ComponentDescriptor::DependencyArrayType& required)
@@ -43,9 +47,34 @@ namespace Module
         void Deactivate() override;
         /////////////////////////////////////////////////////////////////////////////////////
 
-        void Render(size_t subMeshIndex) override;
+        void PrepareRender() override;
+
+        void Render(bgfx::Encoder* encoder, size_t subMeshIndex) override;
+
+        bool GetLocalBounds(AZ::Aabb& bounds) const override;
+
+        bool IsReady() const override;
+
+        Mesh* GetSharedMesh() const override;
+
+        const QuantizeUtil::Dequantization* GetDequantization() const override;
+
+        const LodGroup* GetLodGroup() const override;
+
+        void SetResidentLods(AZ::u32 mask) override;
+
+    protected:
+        /////////////////////////////////////////////////////////////////////////////////////
+        // LodGroupNotificationBus::Handler
+        void OnLodGroupChanged() override;
+        /////////////////////////////////////////////////////////////////////////////////////
 
     private:
-        MeshPtr m_mesh;
+        // copies the levels of the LOD group on the entity, with all their meshes resident
+        void LoadLodGroup();
+
+        MeshPtr  m_mesh;
+        LodGroup m_lodGroup; // no levels without a LOD group
+
     };
 }
@@ -1,5 +1,6 @@
 #include "Renderer/Component/RendererComponent.h"
 
+#include "Renderer/Base/CullingScene.h"
 #include "Renderer/EBus/RendererSystemComponentBus.h"
 
 #include <AzCore/Serialization/SerializeContext.h>
@@ -17,7 +18,9 @@ namespace Module
             serializeContext->Class<RendererComponent, AZ::Component>()
                 ->Field("MaterialNames", &RendererComponent::m_materialNames)
                 ->Field("SortingLayer", &RendererComponent::m_sortingLayer)
-                ->Field("OrderInLayer", &RendererComponent::m_orderInLayer);
+                ->Field("OrderInLayer", &RendererComponent::m_orderInLayer)
+                ->Field("Layer", &RendererComponent::m_layer)
+                ->Field("IsOccluder", &RendererComponent::m_isOccluder);
         }
 
         if (auto behaviorContext = azrtti_cast<AZ::BehaviorContext*>(context))
@@ -27,17 +30,24 @@ namespace Module
                 ->Event("SetEnabled", &RendererRequestBus::Events::SetEnabled)
                 ->Event("GetMaterial", &RendererRequestBus::Events::GetMaterial)
                 ->Event("SetMaterial", &RendererRequestBus::Events::SetMaterial)
+                ->Event("GetPropertyBlock", &RendererRequestBus::Events::GetPropertyBlock)
+                ->Event("SetPropertyBlock", &RendererRequestBus::Events::SetPropertyBlock)
                 ->Event("GetSortingLayer", &RendererRequestBus::Events::GetSortingLayer)
                 ->Event("SetSortingLayer", &RendererRequestBus::Events::SetSortingLayer)
                 ->Event("GetOrderInLayer", &RendererRequestBus::Events::GetOrderInLayer)
                 ->Event("SetOrderInLayer", &RendererRequestBus::Events::SetOrderInLayer)
+                ->Event("GetLayer", &RendererRequestBus::Events::GetLayer)
+                ->Event("SetLayer", &RendererRequestBus::Events::SetLayer)
+                ->Event("IsOccluder", &RendererRequestBus::Events::IsOccluder)
+                ->Event("SetOccluder", &RendererRequestBus::Events::SetOccluder)
                 ;
 
             behaviorContext->Class<RendererComponent>("RendererComponent")
                 ->Constructor()
                 ->Property("materialNames", BehaviorValueProperty(&RendererComponent::m_materialNames))
                 ->Property("sortingLayer", BehaviorValueProperty(&RendererComponent::m_sortingLayer))
-                ->Property("orderInLayer", BehaviorValueProperty(&RendererComponent::m_orderInLayer));
+                ->Property("orderInLayer", BehaviorValueProperty(&RendererComponent::m_orderInLayer))
+                ->Property("isOccluder", BehaviorValueProperty(&RendererComponent::m_isOccluder));
         }
         
     }
@@ -52,16 +62,52 @@ namespace Module
             EBUS_EVENT_RESULT(material, RendererSystemRequestBus, GetMaterial, m_materialNames.at(index));
         }
 
+        EBUS_EVENT_ID_RESULT(m_worldTM, GetEntityId(), AZ::TransformBus, GetWorldTM);
+        EBUS_EVENT_ID_RESULT(m_isStatic, GetEntityId(), AZ::TransformBus, IsStaticTransform);
+
         RendererRequestBus::Handler::BusConnect(GetEntityId());
+        AZ::TransformNotificationBus::Handler::BusConnect(GetEntityId());
+
+        EBUS_EVENT(RendererSystemRequestBus, RegisterRenderer, this);
     }
 
     void RendererComponent::Deactivate()
     {
+        EBUS_EVENT(RendererSystemRequestBus, UnregisterRenderer, this);
+
         m_materials.clear();
 
+        AZ::TransformNotificationBus::Handler::BusDisconnect();
         RendererRequestBus::Handler::BusDisconnect();
     }
 
+    bool RendererComponent::IsReady() const
+    {
+        for (auto& material : m_materials)
+        {
+            if (!material || !material->IsValid())
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void RendererComponent::OnTransformChanged(const AZ::Transform& local, const AZ::Transform& world)
+    {
+        m_worldTM = world;
+
+        MarkDirty();
+    }
+
+    void RendererComponent::MarkDirty()
+    {
+        if (!m_isDirty && m_proxyIndex != RenderProxy::InvalidIndex)
+        {
+            EBUS_EVENT(RendererSystemRequestBus, MarkRendererDirty, this);
+        }
+    }
+
     MaterialPtr RendererComponent::GetMaterial(size_t index) const
     {
         if (index < m_materials.size())
@@ -76,6 +122,45 @@ namespace Module
         if (index < m_materials.size())
         {
             m_materials[index] = material;
+
+            MarkDirty();
+        }
+    }
+
+    void RendererComponent::SetLayer(AZ::u8 value)
+    {
+        if (value >= CullingScene::LayerCount)
+        {
+            AZ_Warning("Renderer", false, "Layer %u is out of range, there are %u layers\n", value, CullingScene::LayerCount);
+            return;
+        }
+
+        m_layer = value;
+
+        MarkDirty();
+    }
+
+    AZ::u8 RendererComponent::GetCullingLayer() const
+    {
+        if (m_layer >= CullingScene::LayerCount)
+        {
+            AZ_Warning("Renderer", false, "Layer %u is out of range, there are %u layers\n", m_layer, CullingScene::LayerCount);
+            return 0;
+        }
+        return m_layer;
+    }
+
+    void RendererComponent::SetPropertyBlock(const MaterialPropertyBlock& block)
+    {
+        // the nodes read the values while submitting, only switching between shared and overridden materials
+        // changes how the renderer is batched
+        const bool wasEmpty = m_propertyBlock.IsEmpty();
+
+        m_propertyBlock = block;
+
+        if (wasEmpty != m_propertyBlock.IsEmpty())
+        {
+            MarkDirty();
         }
     }
 }
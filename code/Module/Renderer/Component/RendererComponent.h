@@ -1,16 +1,24 @@
 #pragma once
 
 #include <AzCore/Component/Component.h>
+#include <AzCore/Component/TransformBus.h>
+#include <AzCore/Math/Aabb.h>
 
 #include "Renderer/Base/Material.h"
 #include "Renderer/Base/RenderNode.h"
+#include "Renderer/Base/RenderProxy.h"
+#include "Renderer/Base/SpriteBatcher.h"
 #include "Renderer/EBus/RendererComponentBus.h"
+#include "Renderer/Util/QuantizeUtil.h"
 
 namespace Module
 {
+    struct LodGroup;
+
     class RendererComponent
         : public AZ::Component
         , protected RendererRequestBus::Handler
+        , protected AZ::TransformNotificationBus::Handler
     {
     public:
         AZ_COMPONENT(RendererComponent, "{BC5AB98F-16F7-4136-A10C-A4A4FD5DCDEE}");
@@ -41,34 +49,109 @@ namespace Module
         void Deactivate() override;
         /////////////////////////////////////////////////////////////////////////////////////
 
-        virtual void Render(size_t subMeshIndex = 0) {}
+        // called on the main thread whenever the render proxy is rebuilt, creates the gpu resources Render reads
+        virtual void PrepareRender() {}
+
+        // called from the submission jobs, must only read the renderer and record into the given encoder
+        virtual void Render(bgfx::Encoder* encoder, size_t subMeshIndex = 0) {}
+
+        // Whether Render has something to draw this frame. Renderers drawing per frame geometry return false until
+        // their geometry of the frame is written, their draws are then skipped instead of submitted empty or stale.
+        virtual bool HasGeometry(size_t subMeshIndex) const { return true; }
+
+        // local space bounds used for culling, renderers without bounds are never culled
+        virtual bool GetLocalBounds(AZ::Aabb& bounds) const { return false; }
+
+        // renderers that are not ready yet stay dirty and are rebuilt again next frame
+        virtual bool IsReady() const;
+
+        // Static mesh geometry of the renderer, render nodes bind its sub meshes without calling Render. Renderers
+        // returning the same mesh are drawn with GPU instancing when their material and pass match, static renderers
+        // with one are merged into static batches.
+        virtual Mesh* GetSharedMesh() const { return nullptr; }
+
+        // Dequantization of the vertices Render binds, nullptr for float vertices. Nodes drawn through Render, like
+        // the ones of dynamic meshes, upload it instead of the one of a shared mesh.
+        virtual const QuantizeUtil::Dequantization* GetDequantization() const { return nullptr; }
+
+        // Levels of detail, nullptr without them. The renderer system picks one level per camera and draws its mesh
+        // instead of the shared mesh, renderers with levels are never merged into static batches.
+        virtual const LodGroup* GetLodGroup() const { return nullptr; }
+
+        // keeps the meshes of the levels whose bit is set in `mask` and releases the others
+        virtual void SetResidentLods(AZ::u32 mask) {}
+
+        // Texture of a renderer that writes its geometry into the shared sprite batch instead of drawing itself.
+        // Consecutive renderers with the same texture, material and pass are drawn with one draw call.
+        virtual Texture* GetBatchTexture() const { return nullptr; }
+
+        // size of the geometry written by FillBatchGeometry
+        virtual void GetBatchGeometrySize(AZ::u32& vertexCount, AZ::u32& indexCount) const { vertexCount = 0; indexCount = 0; }
+
+        // writes the geometry in world space, indices are offset by the base vertex of the geometry
+        virtual void FillBatchGeometry(const SpriteBatcher::Geometry& geometry, const float* worldMatrix) const {}
+
+        bool IsStatic() const { return m_isStatic; }
+
+        // nullptr while the renderer draws its materials unchanged
+        const MaterialPropertyBlock* GetActivePropertyBlock() const { return m_propertyBlock.IsEmpty() ? nullptr : &m_propertyBlock; }
 
     protected:
         /////////////////////////////////////////////////////////////////////////////////////
         // RendererRequestBus::Handler
         bool        IsEnabled() const                               override { return m_isEnabled; }
-        void        SetEnabled(bool value)                          override { m_isEnabled = value; }
+        void        SetEnabled(bool value)                          override { m_isEnabled = value; MarkDirty(); }
 
         size_t      GetMaterialCount() const                        override { return m_materials.size(); }
-        void        SetMaterialCount(size_t value)                  override { m_materials.resize(value); }
+        void        SetMaterialCount(size_t value)                  override { m_materials.resize(value); MarkDirty(); }
 
         MaterialPtr GetMaterial(size_t index) const                 override;
         void        SetMaterial(size_t index, MaterialPtr material) override;
 
+        MaterialPropertyBlock GetPropertyBlock() const                           override { return m_propertyBlock; }
+        void                  SetPropertyBlock(const MaterialPropertyBlock& block) override;
+
         AZ::s16     GetSortingLayer() const                         override { return m_sortingLayer; }
-        void        SetSortingLayer(AZ::s16 value)                  override { m_sortingLayer = value; }
+        void        SetSortingLayer(AZ::s16 value)                  override { m_sortingLayer = value; MarkDirty(); }
 
         AZ::s16     GetOrderInLayer() const                         override { return m_orderInLayer; }
-        void        SetOrderInLayer(AZ::s16 value)                  override { m_orderInLayer = value; }
+        void        SetOrderInLayer(AZ::s16 value)                  override { m_orderInLayer = value; MarkDirty(); }
+
+        AZ::u8      GetLayer() const                                override { return m_layer; }
+        void        SetLayer(AZ::u8 value)                          override;
+
+        bool        IsOccluder() const                              override { return m_isOccluder; }
+        void        SetOccluder(bool value)                         override { m_isOccluder = value; MarkDirty(); }
         /////////////////////////////////////////////////////////////////////////////////////
 
+        /////////////////////////////////////////////////////////////////////////////////////
+        // AZ::TransformNotificationBus::Handler
+        void OnTransformChanged(const AZ::Transform& local, const AZ::Transform& world) override;
+        /////////////////////////////////////////////////////////////////////////////////////
+
+        // asks the renderer system to rebuild the render proxy before the next frame
+        void MarkDirty();
+
     private:
+        // the layer of the culling scene, one out of range, which only a serialized value can be, falls back to the
+        // default layer
+        AZ::u8 GetCullingLayer() const;
+
         AZStd::vector<AZStd::string> m_materialNames;
 
         bool                         m_isEnabled    = true;
         AZStd::vector<MaterialPtr>   m_materials;
+        MaterialPropertyBlock        m_propertyBlock;
         AZ::s16                      m_sortingLayer = 0;
         AZ::s16                      m_orderInLayer = 0;
+        AZ::u8                       m_layer        = 0;
+        bool                         m_isOccluder   = false;
+
+        AZ::Transform                m_worldTM      = AZ::Transform::CreateIdentity();
+        AZ::u32                      m_proxyIndex   = RenderProxy::InvalidIndex;
+        bool                         m_isDirty      = false;
+        bool                         m_isStatic     = false;
+        bool                         m_isBatched    = false;
 
         friend class RendererSystemComponent;
     };
@@ -8,24 +8,106 @@
 
 #include "Renderer/Base/Shader.h"
 #include "Renderer/Base/Material.h"
+#include "Renderer/Base/RenderThread.h"
 
+#include "Renderer/Util/BatchUtil.h"
 #include "Renderer/Util/MeshUtil.h"
 
 #include "Window/EBus/WindowSystemComponentBus.h"
 
 #include <AzCore/Asset/AssetManager.h>
 #include <AzCore/Component/TransformBus.h>
+#include <AzCore/Jobs/JobCompletion.h>
+#include <AzCore/Jobs/JobContext.h>
+#include <AzCore/Jobs/JobFunction.h>
 #include <AzCore/StringFunc/StringFunc.h>
 #include <AzCore/Serialization/SerializeContext.h>
 #include <AzCore/std/smart_ptr/make_shared.h>
 #include <AzCore/std/sort.h>
+#include <AzCore/std/algorithm.h>
 #include <AzCore/RTTI/BehaviorContext.h>
 
 #include <bgfx/bgfx.h>
 #include <bgfx/platform.h>
+#include <bx/timer.h>
 
 namespace Module
 {
+    namespace
+    {
+        // smaller ranges are not worth an own submission job
+        const AZ::u32 k_minSubmitRangeSize = 256;
+
+        // released programs stay resident so a shader loaded again after its eviction finds its programs
+        const AZ::u64 k_programBudgetBytes = 1024 * 1024;
+
+        // frames a level of detail stays loaded after the last camera picked it
+        const AZ::u32 k_lodReleaseFrames = 120;
+
+        // runs function(index) for every index on the job manager and waits for all of them, runs them inline
+        // when there is a single one or no job manager
+        template <typename Function>
+        void RunParallel(AZ::u32 count, const Function& function)
+        {
+            auto context = AZ::JobContext::GetGlobalContext();
+            if (context == nullptr || count <= 1)
+            {
+                for (AZ::u32 i = 0; i < count; ++i)
+                {
+                    function(i);
+                }
+                return;
+            }
+
+            AZ::JobCompletion completion(context);
+            for (AZ::u32 i = 0; i < count; ++i)
+            {
+                auto job = AZ::CreateJobFunction([&function, i]() { function(i); }, true, context);
+                job->SetDependent(&completion);
+                job->Start();
+            }
+            completion.StartAndWaitForCompletion();
+        }
+
+        // finest level whose threshold the screen height reaches, the level count when it is below all of them
+        AZ::u32 FindLod(const RenderProxy& proxy, float screenHeight)
+        {
+            for (AZ::u32 level = 0; level < proxy.m_lodCount; ++level)
+            {
+                if (screenHeight >= proxy.m_lodScreenHeights[level])
+                {
+                    return level;
+                }
+            }
+            return proxy.m_lodCount;
+        }
+
+        // the level itself when its mesh is loaded, otherwise the closest coarser and then the closest finer loaded one
+        AZ::u32 FindLoadedLod(const RenderProxy& proxy, AZ::u32 level)
+        {
+            for (AZ::u32 coarser = level; coarser < proxy.m_lodCount; ++coarser)
+            {
+                if (proxy.m_loadedLods & (1u << coarser))
+                {
+                    return coarser;
+                }
+            }
+            for (AZ::u32 finer = AZStd::GetMin(level, proxy.m_lodCount); finer-- > 0;)
+            {
+                if (proxy.m_loadedLods & (1u << finer))
+                {
+                    return finer;
+                }
+            }
+            return proxy.m_lodCount;
+        }
+
+        float ToMilliseconds(int64_t ticks, int64_t frequency = bx::getHPFrequency())
+        {
+            return frequency > 0 ? static_cast<float>(double(ticks) * 1000.0 / double(frequency)) : 0.0f;
+        }
+    }
+
     void RendererSystemComponent::Reflect(AZ::ReflectContext* context)
     {
         TextureAsset::Reflect(context);
@@ -34,28 +116,70 @@ namespace Module
         MaterialAsset::Reflect(context);
 
         Material::Reflect(context);
+        MaterialPropertyBlock::Reflect(context);
         Mesh::Reflect(context);
         Sprite::Reflect(context);
         Texture::Reflect(context);
+        FrameProfiler::Reflect(context);
 
         if (auto serializeContext = azrtti_cast<AZ::SerializeContext*>(context))
         {
             serializeContext->Class<RendererSystemComponent, AZ::Component>()
-                ->Field("resetFlags", &RendererSystemComponent::m_resetFlags);
+                ->Field("resetFlags", &RendererSystemComponent::m_resetFlags)
+                ->Field("textureBudgetMB", &RendererSystemComponent::m_textureBudgetMB)
+                ->Field("meshBudgetMB", &RendererSystemComponent::m_meshBudgetMB)
+                ->Field("profiledFrameCount", &RendererSystemComponent::m_profiledFrameCount)
+                ->Field("rendererType", &RendererSystemComponent::m_rendererType)
+                ->Field("maxFramesInFlight", &RendererSystemComponent::m_maxFramesInFlight);
         }
 
         if (auto behaviorContext = azrtti_cast<AZ::BehaviorContext*>(context))
         {
             behaviorContext->Class<RendererSystemComponent>("RendererSystemComponent")
                 ->Constructor()
-                ->Property("resetFlags", BehaviorValueProperty(&RendererSystemComponent::m_resetFlags));
+                ->Property("resetFlags", BehaviorValueProperty(&RendererSystemComponent::m_resetFlags))
+                ->Property("textureBudgetMB", BehaviorValueProperty(&RendererSystemComponent::m_textureBudgetMB))
+                ->Property("meshBudgetMB", BehaviorValueProperty(&RendererSystemComponent::m_meshBudgetMB))
+                ->Property("profiledFrameCount", BehaviorValueProperty(&RendererSystemComponent::m_profiledFrameCount))
+                ->Property("maxFramesInFlight", BehaviorValueProperty(&RendererSystemComponent::m_maxFramesInFlight));
+
+            behaviorContext->Class<ResidentCacheStats>("ResidentCacheStats")
+                ->Property("hits", BehaviorValueGetter(&ResidentCacheStats::m_hits), nullptr)
+                ->Property("misses", BehaviorValueGetter(&ResidentCacheStats::m_misses), nullptr)
+                ->Property("evictions", BehaviorValueGetter(&ResidentCacheStats::m_evictions), nullptr)
+                ->Property("liveCount", BehaviorValueGetter(&ResidentCacheStats::m_liveCount), nullptr)
+                ->Property("heldCount", BehaviorValueGetter(&ResidentCacheStats::m_heldCount), nullptr)
+                ->Property("heldBytes", BehaviorValueGetter(&ResidentCacheStats::m_heldBytes), nullptr)
+                ->Property("budgetBytes", BehaviorValueGetter(&ResidentCacheStats::m_budgetBytes), nullptr);
 
             behaviorContext->EBus<RendererSystemRequestBus>("RendererSystemRequestBus")
-                ->Event("SetResetFlags", &RendererSystemRequestBus::Events::SetResetFlags);
+                ->Event("SetResetFlags", &RendererSystemRequestBus::Events::SetResetFlags)
+                ->Event("SetTextureBudget", &RendererSystemRequestBus::Events::SetTextureBudget)
+                ->Event("GetTextureCacheStats", &RendererSystemRequestBus::Events::GetTextureCacheStats)
+                ->Event("SetMeshBudget", &RendererSystemRequestBus::Events::SetMeshBudget)
+                ->Event("GetMeshCacheStats", &RendererSystemRequestBus::Events::GetMeshCacheStats)
+                ->Event("SetMaxFramesInFlight", &RendererSystemRequestBus::Events::SetMaxFramesInFlight)
+                ->Event("SetFrameProfilerCapacity", &RendererSystemRequestBus::Events::SetFrameProfilerCapacity)
+                ->Event("GetProfiledFrameCount", &RendererSystemRequestBus::Events::GetProfiledFrameCount)
+                ->Event("GetProfiledFrame", &RendererSystemRequestBus::Events::GetProfiledFrame)
+                ->Event("DumpFrameProfile", &RendererSystemRequestBus::Events::DumpFrameProfile);
         }
     }
 
     RendererSystemComponent::RendererSystemComponent()
+        : m_textures([](const Texture& texture) -> AZ::u64
+        {
+            return texture.IsValid() ? texture.GetInfo().storageSize : 0;
+        })
+        , m_programs([](const Program& program) -> AZ::u64
+        {
+            return program.IsValid() ? program.GetSize() : 0;
+        })
+        , m_meshes([](const Mesh& mesh) -> AZ::u64
+        {
+            // a mesh modified after MarkUnique is not the asset anymore, it is not handed out again
+            return mesh.IsShared() ? mesh.GetVertexDataSize() + mesh.GetIndexCount() * mesh.GetIndexSize() : 0;
+        })
     {
     }
 
@@ -77,7 +201,9 @@ namespace Module
         int width, height;
         EBUS_EVENT(WindowSystemRequestBus, GetWindowSize, width, height);
 
-        bgfx::init();
+        bgfx::Init init;
+        init.type = static_cast<bgfx::RendererType::Enum>(m_rendererType);
+        bgfx::init(init);
         bgfx::reset(width, height
 #if defined(AZ_PLATFORM_WINDOWS)
             , m_resetFlags
@@ -88,6 +214,31 @@ namespace Module
         bgfx::setDebug(BGFX_DEBUG_TEXT);
 #endif
 
+        m_isInstancingSupported = (bgfx::getCaps()->supported & BGFX_CAPS_INSTANCING) != 0;
+        m_isRenderThreaded = (bgfx::getCaps()->supported & BGFX_CAPS_RENDERER_MULTITHREADED) != 0;
+        SetMaxFramesInFlight(m_maxFramesInFlight);
+
+        if (m_profiledFrameCount > 0)
+        {
+            SetFrameProfilerCapacity(m_profiledFrameCount);
+        }
+
+        m_textures.SetBudget(AZ::u64(m_textureBudgetMB) * 1024 * 1024);
+        m_programs.SetBudget(k_programBudgetBytes);
+        m_meshes.SetBudget(AZ::u64(m_meshBudgetMB) * 1024 * 1024);
+
+        RenderNode::InitUniforms();
+
+        // the main thread keeps the first encoder
+        const AZ::u32 maxEncoders = bgfx::getCaps()->limits.maxEncoders;
+        m_submitJobCount = maxEncoders > 1 ? maxEncoders - 1 : 1;
+        m_submitStates.resize(m_submitJobCount);
+        for (AZ::u32 i = 0; i < m_submitJobCount; ++i)
+        {
+            m_spriteBatchers.emplace_back(aznew SpriteBatcher);
+            m_spriteBatchers.back()->Init();
+        }
+
         AZ::SystemTickBus::Handler::BusConnect();
         RendererSystemRequestBus::Handler::BusConnect();
         WindowsSystemNotificationBus::Handler::BusConnect();
@@ -95,16 +246,37 @@ namespace Module
 
     void RendererSystemComponent::Deactivate()
     {
+        m_staticBatches.clear();
+
+        for (auto mesh : m_dirtyMeshes)
+        {
+            mesh->m_isDirty = false;
+        }
+        m_dirtyMeshes.clear();
+
         m_sprites.clear();
         m_shaders.clear();
         m_materials.clear();
-        m_meshes.clear();
+        m_programs.Clear();
+        m_meshes.Clear();
+        m_textures.Clear();
         m_assetHandlers.clear();
 
         AZ::SystemTickBus::Handler::BusDisconnect();
         RendererSystemRequestBus::Handler::BusDisconnect();
         WindowsSystemNotificationBus::Handler::BusDisconnect();
 
+        for (auto& spriteBatcher : m_spriteBatchers)
+        {
+            spriteBatcher->Shutdown();
+        }
+        m_spriteBatchers.clear();
+        m_submitStates.clear();
+        m_transientGeometry.NextFrame();
+        m_views.clear();
+
+        RenderNode::ShutdownUniforms();
+
         bgfx::shutdown();
     }
 
@@ -124,73 +296,582 @@ namespace Module
             return lhv->m_depth < rhv->m_depth;
         });
 
-        bgfx::ViewId currentViewId = 0;
+        const int64_t updateBegin = bx::getHPCounter();
+
+        ++m_frameNumber;
+        EBUS_EVENT_RESULT(m_frameDeltaTime, AZ::TickRequestBus, GetTickDeltaTime);
 
-        for (auto camera : cameras)
+        UpdateDirtyMeshes();
+        UpdateDirtyRenderers();
+
+        if (m_isStaticBatchStale || m_hasNewStaticRenderers)
         {
+            RebuildStaticBatches();
+        }
+
+        if (m_isSortingRankStale)
+        {
+            UpdateSortingRanks();
+        }
+
+        if (m_cullingScene.IsStale())
+        {
+            m_cullingScene.Build(m_renderProxies);
+        }
+
+        // views are set up on the main thread, the bgfx view api is not thread safe
+        m_views.resize(cameras.size());
+        m_occludingViews.clear();
+        for (size_t i = 0; i < cameras.size(); ++i)
+        {
+            auto camera = cameras[i];
+            auto& view = m_views[i];
+
             AZ::Transform cameraWorldTM;
             EBUS_EVENT_ID_RESULT(cameraWorldTM, camera->GetEntityId(), AZ::TransformBus, GetWorldTM);
 
-            camera->ResetView(currentViewId);
+            // the levels of detail picked for another camera do not apply
+            if (view.m_camera != camera)
+            {
+                view.m_lodStates.clear();
+            }
+
+            view.m_camera = camera;
+            view.m_viewId = static_cast<bgfx::ViewId>(i);
+            view.m_position = cameraWorldTM.GetPosition();
+            view.m_isSequential = camera->m_isOrthographic; // orthographic cameras use ViewMode::Sequential
+            view.m_isOccluding = camera->m_isOcclusionCulling && m_cullingScene.HasOccluders(camera->m_cullingMask);
+
+            view.m_stats = CameraFrameStats();
+            view.m_stats.m_cameraId = camera->GetEntityId();
+            view.m_stats.m_viewId = view.m_viewId;
 
-            AZStd::vector<RenderNode> renderNodes;
+            camera->ResetView(view.m_viewId);
+            camera->m_visibleCount = 0;
+            camera->m_culledCount = 0;
+            camera->m_occludedCount = 0;
 
-            RendererRequestBus::EnumerateHandlers([&](RendererRequest* rendererHandler)
+            if (view.m_isOccluding)
             {
-                auto* renderer = azrtti_cast<RendererComponent*>(rendererHandler);
+                m_occludingViews.push_back(static_cast<AZ::u32>(i));
+            }
+        }
 
-                AZ::Transform rnWorldTM;
-                EBUS_EVENT_ID_RESULT(rnWorldTM, renderer->GetEntityId(), AZ::TransformBus, GetWorldTM);
+        const int64_t cullBegin = bx::getHPCounter();
 
-                float distance = cameraWorldTM.GetPosition().GetDistance(rnWorldTM.GetPosition());
+        // the occluders are drawn while the views are culled, the views need both before they drop occluded proxies
+        const AZ::u32 viewCount = static_cast<AZ::u32>(m_views.size());
+        RunParallel(viewCount + static_cast<AZ::u32>(m_occludingViews.size()), [this, viewCount](AZ::u32 index)
+        {
+            if (index < viewCount)
+            {
+                CullView(m_views[index]);
+            }
+            else
+            {
+                DrawOccluders(m_views[m_occludingViews[index - viewCount]]);
+            }
+        });
 
-                /* TODO cull render node
-                if (camera->CullRenderNode(renderer, mesh)) return;
-                */
+        RunParallel(viewCount, [this](AZ::u32 index)
+        {
+            BuildView(m_views[index]);
+        });
 
-                // TODO check pass valid or not
-                for (size_t materialIndex = 0; materialIndex < renderer->GetMaterialCount(); ++materialIndex)
-                {
-                    auto material = renderer->GetMaterial(materialIndex);
-                    auto shader = material->m_shader;
+        UpdateLodResidency();
 
-                    for (size_t passIndex = 0; passIndex < shader->m_passes.size(); ++passIndex)
-                    {
-                        renderNodes.emplace_back(renderer,
-                                                 materialIndex,
-                                                 material.get(),
-                                                 shader.get(),
-                                                 &shader->m_passes.at(passIndex),
-                                                 distance,
-                                                 rnWorldTM,
-                                                 renderer->GetSortingLayer(),
-                                                 renderer->GetOrderInLayer());
-                    }
-                }
+        const int64_t submitBegin = bx::getHPCounter();
 
-                return true;
-            });
+        // Split the sorted queues into ranges for the submission jobs. bgfx numbers the draws of sequential views
+        // in submission order across all encoders, so those are recorded by a single job.
+        m_submitRanges.clear();
+        for (AZ::u32 viewIndex = 0; viewIndex < m_views.size(); ++viewIndex)
+        {
+            const AZ::u32 nodeCount = static_cast<AZ::u32>(m_views[viewIndex].m_sortIndices.size());
+            const AZ::u32 rangeSize = m_views[viewIndex].m_isSequential ? nodeCount :
+                AZStd::GetMax(k_minSubmitRangeSize, (nodeCount + m_submitJobCount - 1) / m_submitJobCount);
 
-            AZStd::sort(renderNodes.begin(), renderNodes.end());
+            for (AZ::u32 begin = 0; begin < nodeCount; begin += rangeSize)
+            {
+                SubmitRange range;
+                range.m_viewIndex = viewIndex;
+                range.m_begin = begin;
+                range.m_end = AZStd::GetMin(begin + rangeSize, nodeCount);
+                m_submitRanges.push_back(range);
+            }
+        }
+
+        // every job records into its own encoder, there are never more jobs than encoders
+        const AZ::u32 jobCount = AZStd::GetMin(m_submitJobCount, static_cast<AZ::u32>(m_submitRanges.size()));
+        for (auto& state : m_submitStates)
+        {
+            state.m_stats = SubmitState::Stats();
+        }
+        RunParallel(jobCount, [this, jobCount](AZ::u32 jobIndex)
+        {
+            bgfx::Encoder* encoder = bgfx::begin();
+            AZ_Assert(encoder, "Ran out of bgfx encoders\n");
 
-            for (auto& rn : renderNodes)
+            auto& state = m_submitStates[jobIndex];
+            for (size_t i = jobIndex; i < m_submitRanges.size(); i += jobCount)
             {
-                rn.Apply(currentViewId);
+                auto& range = m_submitRanges[i];
+                const int64_t begin = bx::getHPCounter();
+                SubmitView(encoder, *m_spriteBatchers[jobIndex], state, m_views[range.m_viewIndex], range);
+                range.m_ticks = bx::getHPCounter() - begin;
             }
 
-            camera->DrawSkybox(currentViewId);
+            bgfx::end(encoder);
+        });
 
-            ++currentViewId;
+        for (const auto& view : m_views)
+        {
+            view.m_camera->DrawSkybox(view.m_viewId);
         }
 
+        const int64_t submitEnd = bx::getHPCounter();
+
 #if defined(AZ_ENABLE_TRACING)
         float delta = 0.0f;
         EBUS_EVENT_RESULT(delta, AZ::TickRequestBus, GetTickDeltaTime);
         const auto stat = bgfx::getStats();
-        bgfx::dbgTextPrintf(0, 0, 0x0F, "FPS: %.2f DC: %d", 1.0f / delta, stat->numDraw);
+        SubmitState::Stats saved;
+        for (const auto& state : m_submitStates)
+        {
+            saved.m_savedGeometryBinds += state.m_stats.m_savedGeometryBinds;
+            saved.m_savedMaterialBinds += state.m_stats.m_savedMaterialBinds;
+            saved.m_savedStateBinds += state.m_stats.m_savedStateBinds;
+        }
+        bgfx::dbgTextPrintf(0, 0, 0x0F, "FPS: %.2f DC: %d Saved binds: geometry %u material %u state %u", 1.0f / delta, stat->numDraw,
+            saved.m_savedGeometryBinds, saved.m_savedMaterialBinds, saved.m_savedStateBinds);
+
+        const auto textureStats = m_textures.GetStats();
+        bgfx::dbgTextPrintf(0, 1, 0x0F, "Textures: live %u held %u (%.1f / %.1f MB) hits %u misses %u evictions %u",
+            textureStats.m_liveCount, textureStats.m_heldCount,
+            textureStats.m_heldBytes / (1024.0 * 1024.0), textureStats.m_budgetBytes / (1024.0 * 1024.0),
+            textureStats.m_hits, textureStats.m_misses, textureStats.m_evictions);
+
+        // the profiled frame before this one, the bgfx timings of this one are only known after bgfx::frame
+        if (auto latest = m_frameProfiler.GetLatest())
+        {
+            bgfx::dbgTextPrintf(0, 2, 0x0F, "Frame %.2f ms: update %.2f cull %.2f submit %.2f render %.2f (overlap %.2f) gpu %.2f",
+                latest->m_frameMs, latest->m_updateMs, latest->m_cullMs, latest->m_submitMs, latest->m_renderCpuMs, latest->m_overlapMs,
+                latest->m_gpuMs);
+            for (AZ::u32 i = 0; i < latest->m_cameras.size(); ++i)
+            {
+                const auto& camera = latest->m_cameras[i];
+                bgfx::dbgTextPrintf(0, static_cast<uint16_t>(3 + i), 0x0F,
+                    "  view %u: cull %.2f gather %.2f sort %.2f submit %.2f gpu %.2f ms, visible %u culled %u occluded %u nodes %u states %u triangles %u",
+                    camera.m_viewId, camera.m_cullMs, camera.m_gatherMs, camera.m_sortMs, camera.m_submitMs, camera.m_gpuMs,
+                    camera.m_visibleCount, camera.m_culledCount, camera.m_occludedCount, camera.m_nodeCount, camera.m_stateChanges, camera.m_triangleCount);
+            }
+        }
 #endif
 
-        bgfx::frame();
+        const AZ::u32 frameNumber = bgfx::frame();
+        m_transientGeometry.NextFrame();
+
+        // bgfx::frame only waits for the frame before, the render thread is still busy with this one
+        if (m_maxFramesInFlight == 0)
+        {
+            if (auto renderThread = RenderThread::GetRunning())
+            {
+                renderThread->WaitForFrame(frameNumber);
+            }
+        }
+
+        if (m_frameProfiler.IsEnabled())
+        {
+            auto& frame = m_frameProfiler.BeginFrame();
+            frame.m_updateMs = ToMilliseconds(cullBegin - updateBegin);
+            frame.m_cullMs = ToMilliseconds(submitBegin - cullBegin);
+            frame.m_submitMs = ToMilliseconds(submitEnd - submitBegin);
+
+            for (const auto& range : m_submitRanges)
+            {
+                auto& stats = m_views[range.m_viewIndex].m_stats;
+                stats.m_submitMs += ToMilliseconds(range.m_ticks);
+                stats.m_stateChanges += range.m_stateChanges;
+                stats.m_triangleCount += range.m_triangleCount;
+                stats.m_spriteBatchCount += range.m_spriteBatchCount;
+                stats.m_droppedSpriteCount += range.m_droppedSpriteCount;
+            }
+
+            // with a single threaded bgfx the stats describe the frame which was just rendered, with a render thread
+            // they lag one frame behind
+            const auto stats = bgfx::getStats();
+            frame.m_frameMs = ToMilliseconds(stats->cpuTimeFrame, stats->cpuTimerFreq);
+            frame.m_renderCpuMs = ToMilliseconds(stats->cpuTimeEnd - stats->cpuTimeBegin, stats->cpuTimerFreq);
+            frame.m_gpuMs = ToMilliseconds(stats->gpuTimeEnd - stats->gpuTimeBegin, stats->gpuTimerFreq);
+            frame.m_waitRenderMs = ToMilliseconds(stats->waitRender, stats->cpuTimerFreq);
+            frame.m_waitSubmitMs = ToMilliseconds(stats->waitSubmit, stats->cpuTimerFreq);
+            frame.m_overlapMs = m_isRenderThreaded ? AZStd::GetMax(frame.m_renderCpuMs - frame.m_waitRenderMs, 0.0f) : 0.0f;
+            frame.m_drawCount = stats->numDraw;
+
+            for (auto& view : m_views)
+            {
+                for (uint16_t i = 0; i < stats->numViews; ++i)
+                {
+                    if (stats->viewStats[i].view == view.m_viewId)
+                    {
+                        view.m_stats.m_renderCpuMs = ToMilliseconds(stats->viewStats[i].cpuTimeElapsed, stats->cpuTimerFreq);
+                        view.m_stats.m_gpuMs = ToMilliseconds(stats->viewStats[i].gpuTimeElapsed, stats->gpuTimerFreq);
+                    }
+                }
+                frame.m_cameras.push_back(view.m_stats);
+            }
+        }
+    }
+
+    void RendererSystemComponent::CullView(RenderView& view)
+    {
+        auto camera = view.m_camera;
+
+        const int64_t cullBegin = bx::getHPCounter();
+
+        view.m_visibleProxies.Reset(static_cast<AZ::u32>(m_renderProxies.size()));
+        m_cullingScene.Cull(camera->GetFrustum(), camera->m_cullingMask, view.m_visibleProxies, camera->m_visibleCount, camera->m_culledCount);
+
+        view.m_stats.m_cullMs = ToMilliseconds(bx::getHPCounter() - cullBegin);
+    }
+
+    void RendererSystemComponent::DrawOccluders(RenderView& view)
+    {
+        const int64_t begin = bx::getHPCounter();
+
+        view.m_occlusionBuffer.Begin(view.m_camera->GetViewProjection());
+        // occluders of layers the camera does not render do not hide anything from it
+        m_cullingScene.DrawOccluders(view.m_occlusionBuffer, view.m_camera->m_cullingMask);
+        view.m_occlusionBuffer.End();
+
+        view.m_stats.m_occlusionMs = ToMilliseconds(bx::getHPCounter() - begin);
+    }
+
+    void RendererSystemComponent::BuildView(RenderView& view)
+    {
+        auto camera = view.m_camera;
+
+        view.m_renderNodes.clear();
+        view.m_sortKeys.clear();
+        view.m_sortIndices.clear();
+        view.m_visibleBatches.clear();
+        view.m_visibleRanges.clear();
+
+        // new proxies start without a level of detail
+        view.m_lodStates.resize(m_renderProxies.size());
+
+        const int64_t occlusionBegin = bx::getHPCounter();
+
+        const OcclusionBuffer* occlusionBuffer = view.m_isOccluding ? &view.m_occlusionBuffer : nullptr;
+        if (occlusionBuffer)
+        {
+            view.m_visibleProxies.ForEach([this, &view, camera, occlusionBuffer](AZ::u32 proxyIndex)
+            {
+                const auto& proxy = m_renderProxies[proxyIndex];
+                if (proxy.m_hasBounds && occlusionBuffer->IsOccluded(proxy.m_worldBounds))
+                {
+                    view.m_visibleProxies.Clear(proxyIndex);
+                    --camera->m_visibleCount;
+                    ++camera->m_occludedCount;
+                }
+            });
+        }
+
+        const int64_t cullBegin = bx::getHPCounter();
+
+        for (AZ::u32 batchIndex = 0; batchIndex < m_staticBatches.size(); ++batchIndex)
+        {
+            const auto& batch = m_staticBatches[batchIndex];
+            if ((camera->m_cullingMask & (1u << batch->m_layer)) == 0)
+            {
+                continue;
+            }
+
+            if (!camera->IsVisible(batch->m_worldBounds))
+            {
+                camera->m_culledCount += static_cast<AZ::u32>(batch->m_ranges.size());
+                continue;
+            }
+
+            BatchUtil::CollectVisibleRanges(*batch, [camera, occlusionBuffer](const StaticBatch::Range& range)
+            {
+                if (!camera->IsVisible(range.m_worldBounds))
+                {
+                    ++camera->m_culledCount;
+                    return false;
+                }
+                if (occlusionBuffer && occlusionBuffer->IsOccluded(range.m_worldBounds))
+                {
+                    ++camera->m_occludedCount;
+                    return false;
+                }
+                ++camera->m_visibleCount;
+                return true;
+            }, view.m_visibleRanges);
+            view.m_visibleBatches.push_back({ batchIndex, static_cast<AZ::u32>(view.m_visibleRanges.size()) });
+        }
+
+        const int64_t gatherBegin = bx::getHPCounter();
+
+        view.m_programIds.Clear();
+        view.m_materialIds.Clear();
+        view.m_meshIds.Clear();
+        view.m_textureIds.Clear();
+
+        view.m_visibleProxies.ForEach([this, &view](AZ::u32 proxyIndex)
+        {
+            const auto& proxy = m_renderProxies[proxyIndex];
+            const float distance = view.m_position.GetDistance(proxy.m_position);
+
+            if (proxy.m_lodCount > 0)
+            {
+                GatherLodDraws(view, proxyIndex, distance);
+                return;
+            }
+
+            for (const auto& draw : proxy.m_draws)
+            {
+                if (draw.m_mesh == nullptr && draw.m_batchTexture == nullptr && !proxy.m_renderer->HasGeometry(draw.m_materialIndex))
+                {
+                    continue;
+                }
+                GatherDraw(view, proxy, draw, distance);
+            }
+        });
+
+        AZ::u32 rangeBegin = 0;
+        for (const auto& visibleBatch : view.m_visibleBatches)
+        {
+            const auto& batch = m_staticBatches[visibleBatch.m_batchIndex];
+            auto material = batch->m_material.get();
+            auto shader = material->m_shader.get();
+            const AZ::u32 materialId = view.m_materialIds.Get(material->GetSortId());
+            const AZ::u32 geometryId = view.m_meshIds.Get(batch->m_mesh.GetSortId());
+
+            for (AZ::u32 rangeIndex = rangeBegin; rangeIndex < visibleBatch.m_rangeEnd; ++rangeIndex)
+            {
+                const auto& range = view.m_visibleRanges[rangeIndex];
+                const float distance = view.m_position.GetDistance(range.m_worldBounds.GetCenter());
+
+                for (size_t passIndex = 0; passIndex < shader->m_passes.size(); ++passIndex)
+                {
+                    auto& pass = shader->m_passes[passIndex];
+
+                    const AZ::u64 sortKey = RenderNode::MakeSortKey(batch->m_sortingRank,
+                                                                    material->GetQueue(),
+                                                                    distance,
+                                                                    view.m_programIds.Get(pass.GetProgramSortId()),
+                                                                    materialId,
+                                                                    static_cast<AZ::u32>(passIndex),
+                                                                    geometryId);
+
+                    view.m_sortKeys.push_back(sortKey);
+                    view.m_sortIndices.push_back(static_cast<AZ::u32>(view.m_renderNodes.size()));
+                    view.m_renderNodes.emplace_back(&batch->m_mesh,
+                                                    range.m_firstIndex,
+                                                    range.m_indexCount,
+                                                    material,
+                                                    shader,
+                                                    &pass,
+                                                    sortKey);
+                }
+            }
+            rangeBegin = visibleBatch.m_rangeEnd;
+        }
+
+        const int64_t sortBegin = bx::getHPCounter();
+
+        RenderNode::Sort(view.m_sortKeys, view.m_sortIndices, view.m_tempSortKeys, view.m_tempSortIndices);
+
+        const int64_t sortEnd = bx::getHPCounter();
+
+        auto& stats = view.m_stats;
+        stats.m_cullMs += ToMilliseconds(gatherBegin - cullBegin);
+        stats.m_occlusionMs += ToMilliseconds(cullBegin - occlusionBegin);
+        stats.m_gatherMs = ToMilliseconds(sortBegin - gatherBegin);
+        stats.m_sortMs = ToMilliseconds(sortEnd - sortBegin);
+        stats.m_visibleCount = camera->m_visibleCount;
+        stats.m_culledCount = camera->m_culledCount;
+        stats.m_occludedCount = camera->m_occludedCount;
+        stats.m_nodeCount = static_cast<AZ::u32>(view.m_renderNodes.size());
+    }
+
+    RenderNode& RendererSystemComponent::GatherDraw(RenderView& view, const RenderProxy& proxy, const RenderProxy::Draw& draw, float distance)
+    {
+        const AZ::u64 sortKey = RenderNode::MakeSortKey(proxy.m_sortingRank,
+                                                        draw.m_material->GetQueue(),
+                                                        distance,
+                                                        view.m_programIds.Get(draw.m_pass->GetProgramSortId()),
+                                                        view.m_materialIds.Get(draw.m_material->GetSortId()),
+                                                        draw.m_passIndex,
+                                                        draw.m_mesh ? view.m_meshIds.Get(draw.m_mesh->GetSortId()) :
+                                                        draw.m_batchTexture ? view.m_textureIds.Get(draw.m_batchTexture->GetSortId()) : 0);
+
+        view.m_sortKeys.push_back(sortKey);
+        view.m_sortIndices.push_back(static_cast<AZ::u32>(view.m_renderNodes.size()));
+        view.m_renderNodes.emplace_back(proxy.m_renderer,
+                                        draw.m_materialIndex,
+                                        draw.m_material,
+                                        draw.m_shader,
+                                        draw.m_pass,
+                                        draw.m_mesh,
+                                        sortKey,
+                                        proxy.m_worldMatrix,
+                                        draw.m_batchTexture,
+                                        draw.m_propertyBlock);
+        return view.m_renderNodes.back();
+    }
+
+    void RendererSystemComponent::GatherLodDraws(RenderView& view, AZ::u32 proxyIndex, float distance)
+    {
+        const auto& proxy = m_renderProxies[proxyIndex];
+        auto& state = view.m_lodStates[proxyIndex];
+
+        const float screenHeight = view.m_camera->GetScreenHeight(proxy.m_boundsRadius, distance);
+
+        // a proxy coming back into view takes the level of its size right away, without fading
+        if (state.m_frame + 1 != m_frameNumber || state.m_level == RenderView::LodState::InvalidLevel)
+        {
+            state = RenderView::LodState();
+            state.m_level = static_cast<AZ::u8>(FindLod(proxy, screenHeight));
+        }
+        else
+        {
+            // the screen height has to get past a threshold by the hysteresis before the level changes
+            const AZ::u32 coarser = FindLod(proxy, screenHeight * (1.0f + proxy.m_lodHysteresis));
+            const AZ::u32 finer = FindLod(proxy, screenHeight * (1.0f - proxy.m_lodHysteresis));
+            const AZ::u32 level = coarser > state.m_level ? coarser : finer < state.m_level ? finer : state.m_level;
+
+            if (level != state.m_level)
+            {
+                // a level fading in from the level count appears out of nothing
+                const bool isFading = proxy.m_lodFadeTime > 0.0f;
+                state.m_previous = isFading ? state.m_level : RenderView::LodState::InvalidLevel;
+                state.m_fade = isFading ? 0.0f : 1.0f;
+                state.m_level = static_cast<AZ::u8>(level);
+            }
+            else if (state.m_previous != RenderView::LodState::InvalidLevel)
+            {
+                state.m_fade += proxy.m_lodFadeTime > 0.0f ? m_frameDeltaTime / proxy.m_lodFadeTime : 1.0f;
+                if (state.m_fade >= 1.0f)
+                {
+                    state.m_fade = 1.0f;
+                    state.m_previous = RenderView::LodState::InvalidLevel;
+                }
+            }
+        }
+        state.m_frame = m_frameNumber;
+
+        // until the picked level is loaded the closest loaded one stands in for it
+        const AZ::u32 level = FindLoadedLod(proxy, state.m_level);
+
+        // the previous level count means the proxy was too small to be drawn, the new level fades in from nothing
+        const AZ::u32 fadingOut = state.m_previous < proxy.m_lodCount && state.m_previous != level
+            && (proxy.m_loadedLods & (1u << state.m_previous)) ? state.m_previous : RenderView::LodState::InvalidLevel;
+        const bool isFadingIn = fadingOut != RenderView::LodState::InvalidLevel || state.m_previous == proxy.m_lodCount;
+
+        for (const auto& draw : proxy.m_draws)
+        {
+            if (draw.m_lodLevel == level)
+            {
+                auto& node = GatherDraw(view, proxy, draw, distance);
+                if (isFadingIn)
+                {
+                    node.SetLodFade(state.m_fade, false);
+                }
+            }
+            else if (draw.m_lodLevel == fadingOut)
+            {
+                GatherDraw(view, proxy, draw, distance).SetLodFade(1.0f - state.m_fade, true);
+            }
+        }
+    }
+
+    void RendererSystemComponent::SubmitView(bgfx::Encoder* encoder, SpriteBatcher& spriteBatcher, SubmitState& state, const RenderView& view, SubmitRange& range) const
+    {
+        AZ::u32 begin = range.m_begin;
+        const AZ::u32 end = range.m_end;
+        const RenderNode* previous = nullptr;
+
+        const auto* nodes = view.m_renderNodes.data();
+        const auto* indices = view.m_sortIndices.data();
+
+        // end of the run starting at `first`, a run is drawn with one sprite batch or one instanced draw call
+        const auto findRunEnd = [this, nodes, indices, end](AZ::u32 first)
+        {
+            if (first >= end)
+            {
+                return end;
+            }
+
+            const auto& node = nodes[indices[first]];
+            AZ::u32 last = first + 1;
+            if (node.IsBatched())
+            {
+                while (last < end && node.CanBatchWith(nodes[indices[last]]))
+                {
+                    ++last;
+                }
+            }
+            else if (m_isInstancingSupported)
+            {
+                while (last < end && node.CanInstanceWith(nodes[indices[last]]))
+                {
+                    ++last;
+                }
+            }
+            return last;
+        };
+
+        state.m_boundNode = nullptr;
+
+        AZ::u32 runEnd = findRunEnd(begin);
+        while (begin < end)
+        {
+            const auto& node = nodes[indices[begin]];
+
+            const AZ::u32 nextBegin = runEnd;
+            const AZ::u32 nextRunEnd = findRunEnd(nextBegin);
+
+            if (previous == nullptr || !node.CanPreserveStateWith(*previous))
+            {
+                ++range.m_stateChanges;
+            }
+            previous = &node;
+            for (AZ::u32 i = begin; i < runEnd && m_frameProfiler.IsEnabled(); ++i)
+            {
+                range.m_triangleCount += nodes[indices[i]].GetTriangleCount();
+            }
+
+            if (node.IsBatched())
+            {
+                // a run that does not fit into 16 bit indices is split into several batches
+                const AZ::u32 batchCount = spriteBatcher.GetBatchCount();
+                const AZ::u32 droppedCount = spriteBatcher.GetDroppedCount();
+                for (AZ::u32 submitted = begin; submitted < runEnd;)
+                {
+                    submitted += spriteBatcher.Submit(encoder, view.m_viewId, nodes, indices + submitted, runEnd - submitted);
+                }
+                range.m_spriteBatchCount += spriteBatcher.GetBatchCount() - batchCount;
+                range.m_droppedSpriteCount += spriteBatcher.GetDroppedCount() - droppedCount;
+            }
+            else if (runEnd - begin > 1)
+            {
+                RenderNode::ApplyInstanced(encoder, view.m_viewId, nodes, indices + begin, runEnd - begin);
+            }
+            else
+            {
+                // the encoder state is kept only for a following single draw with the same material and pass, the
+                // batched and instanced paths always start from a discarded state
+                const bool preserveState = nextRunEnd - nextBegin == 1
+                    && !nodes[indices[nextBegin]].IsBatched()
+                    && node.CanPreserveStateWith(nodes[indices[nextBegin]]);
+                node.Apply(encoder, view.m_viewId, state, preserveState);
+            }
+
+            begin = nextBegin;
+            runEnd = nextRunEnd;
+        }
     }
 
     void RendererSystemComponent::SetResetFlags(uint32_t resetFlags)
@@ -220,18 +901,92 @@ namespace Module
             AZ_Warning("RendererSystemComponent", false, "Platform do not support any valid texture format!\n");
         }
 
-        TexturePtr texture;
-        const auto iterator = m_textures.find(path);
-        if (iterator == m_textures.end() || iterator->second.expired())
+        TexturePtr texture = m_textures.Find(path);
+        if (!texture)
         {
-            texture = AZStd::make_shared<Texture>(replacedPath);
-            m_textures[path] = texture;
+            texture = m_textures.Insert(path, aznew Texture(replacedPath));
         }
-        else
+        return texture;
+    }
+
+    void RendererSystemComponent::SetTextureBudget(AZ::u64 bytes)
+    {
+        m_textures.SetBudget(bytes);
+    }
+
+    ResidentCacheStats RendererSystemComponent::GetTextureCacheStats() const
+    {
+        return m_textures.GetStats();
+    }
+
+    void RendererSystemComponent::SetMeshBudget(AZ::u64 bytes)
+    {
+        m_meshes.SetBudget(bytes);
+    }
+
+    ResidentCacheStats RendererSystemComponent::GetMeshCacheStats() const
+    {
+        return m_meshes.GetStats();
+    }
+
+    void RendererSystemComponent::SetMaxFramesInFlight(AZ::u32 frameCount)
+    {
+        AZ_Warning("RendererSystemComponent", frameCount <= 1, "bgfx renders at most 1 frame while the next one is recorded\n");
+        AZ_Warning("RendererSystemComponent", frameCount > 0 || !m_isRenderThreaded || RenderThread::GetRunning(),
+            "Waiting for the rendered frame needs the render thread of the launcher\n");
+        m_maxFramesInFlight = AZStd::GetMin(frameCount, 1u);
+    }
+
+    void RendererSystemComponent::SetFrameProfilerCapacity(AZ::u32 frameCount)
+    {
+        m_frameProfiler.SetCapacity(frameCount);
+
+        // the per view timings of bgfx are only measured with its profiler
+        uint32_t debugFlags = frameCount > 0 ? BGFX_DEBUG_PROFILER : BGFX_DEBUG_NONE;
+#if defined(AZ_ENABLE_TRACING)
+        debugFlags |= BGFX_DEBUG_TEXT;
+#endif
+        bgfx::setDebug(debugFlags);
+    }
+
+    AZ::u32 RendererSystemComponent::GetProfiledFrameCount() const
+    {
+        return m_frameProfiler.GetFrameCount();
+    }
+
+    FrameStats RendererSystemComponent::GetProfiledFrame(AZ::u32 index) const
+    {
+        return index < m_frameProfiler.GetFrameCount() ? m_frameProfiler.GetFrame(index) : FrameStats();
+    }
+
+    bool RendererSystemComponent::DumpFrameProfile(const AZStd::string& path) const
+    {
+        return m_frameProfiler.WriteJson(path);
+    }
+
+    ProgramPtr RendererSystemComponent::GetProgram(const AZStd::string& vsPath, const AZStd::string& fsPath)
+    {
+        // keyed by asset id rather than path, paths differing in case or separators name the same asset
+        const auto vsId = AZ::Data::AssetManager::Instance().GetAssetIdByPath(vsPath.c_str(), AZ::AzTypeInfo<AZ::BinaryAsset>::Uuid());
+        const auto fsId = AZ::Data::AssetManager::Instance().GetAssetIdByPath(fsPath.c_str(), AZ::AzTypeInfo<AZ::BinaryAsset>::Uuid());
+        const AZStd::string key = vsId.ToString<AZStd::string>() + "|" + fsId.ToString<AZStd::string>();
+
+        ProgramPtr program = m_programs.Find(key);
+        if (!program)
         {
-            texture = iterator->second.lock();
+            program = m_programs.Insert(key, aznew Program(vsPath, fsPath));
         }
-        return texture;
+        return program;
+    }
+
+    AZ::u16 RendererSystemComponent::GetProgramSortId(AZ::u64 contentHash)
+    {
+        auto iterator = m_programSortIds.find(contentHash);
+        if (iterator == m_programSortIds.end())
+        {
+            iterator = m_programSortIds.insert(AZStd::make_pair(contentHash, m_nextProgramSortId++)).first;
+        }
+        return iterator->second;
     }
 
     ShaderPtr RendererSystemComponent::GetShader(const AZStd::string& path)
@@ -268,16 +1023,10 @@ namespace Module
 
     MeshPtr RendererSystemComponent::GetMesh(AZStd::string& path)
     {
-        MeshPtr mesh;
-        const auto iterator = m_meshes.find(path);
-        if (iterator == m_meshes.end() || iterator->second.expired())
-        {
-            mesh = AZStd::make_shared<Mesh>(path);
-            m_meshes[path] = mesh;
-        }
-        else
+        MeshPtr mesh = m_meshes.Find(path);
+        if (!mesh)
         {
-            mesh = iterator->second.lock();
+            mesh = m_meshes.Insert(path, aznew Mesh(path));
         }
         return mesh;
     }
@@ -285,11 +1034,12 @@ namespace Module
     SpritePtr RendererSystemComponent::GetSprite(const AZStd::string& path, const AZStd::string& spriteName)
     {
         SpritePtr sprite;
-        const auto iterator = m_sprites.find(path);
+        const auto key = AZStd::make_pair(path, spriteName);
+        const auto iterator = m_sprites.find(key);
         if (iterator == m_sprites.end() || iterator->second.expired())
         {
             sprite = AZStd::make_shared<Sprite>(path, spriteName);
-            m_sprites[path] = sprite;
+            m_sprites[key] = sprite;
         }
         else
         {
@@ -298,6 +1048,387 @@ namespace Module
         return sprite;
     }
 
+    void RendererSystemComponent::RegisterRenderer(RendererComponent* renderer)
+    {
+        AZ_Assert(renderer->m_proxyIndex == RenderProxy::InvalidIndex, "Renderer is already registered\n");
+
+        renderer->m_proxyIndex = static_cast<AZ::u32>(m_renderProxies.size());
+        m_renderProxies.emplace_back(renderer);
+        m_isSortingRankStale = true;
+
+        MarkRendererDirty(renderer);
+    }
+
+    void RendererSystemComponent::UnregisterRenderer(RendererComponent* renderer)
+    {
+        const AZ::u32 index = renderer->m_proxyIndex;
+        if (index == RenderProxy::InvalidIndex)
+        {
+            return;
+        }
+
+        if (renderer->m_isDirty)
+        {
+            m_dirtyRenderers.erase(AZStd::find(m_dirtyRenderers.begin(), m_dirtyRenderers.end(), renderer));
+            renderer->m_isDirty = false;
+        }
+
+        if (renderer->m_isBatched)
+        {
+            renderer->m_isBatched = false;
+            m_isStaticBatchStale = true;
+        }
+
+        // the level of detail states follow their proxies, views which have not seen the newest proxies yet drop the
+        // state of the removed one
+        for (auto& view : m_views)
+        {
+            auto& states = view.m_lodStates;
+            if (index < states.size())
+            {
+                states[index] = states.size() == m_renderProxies.size() ? states.back() : RenderView::LodState();
+                states.resize(AZStd::GetMin(states.size(), m_renderProxies.size() - 1));
+            }
+        }
+
+        // swap with the last proxy to keep the array dense
+        if (index + 1 != m_renderProxies.size())
+        {
+            m_renderProxies[index] = AZStd::move(m_renderProxies.back());
+            m_renderProxies[index].m_renderer->m_proxyIndex = index;
+        }
+        m_renderProxies.pop_back();
+        m_cullingScene.MarkStale();
+        m_isSortingRankStale = true;
+
+        renderer->m_proxyIndex = RenderProxy::InvalidIndex;
+    }
+
+    void RendererSystemComponent::MarkRendererDirty(RendererComponent* renderer)
+    {
+        if (!renderer->m_isDirty)
+        {
+            renderer->m_isDirty = true;
+            m_dirtyRenderers.push_back(renderer);
+        }
+    }
+
+    void RendererSystemComponent::MarkMeshDirty(Mesh* mesh)
+    {
+        m_dirtyMeshes.push_back(mesh);
+    }
+
+    void RendererSystemComponent::ClearMeshDirty(Mesh* mesh)
+    {
+        auto it = AZStd::find(m_dirtyMeshes.begin(), m_dirtyMeshes.end(), mesh);
+        if (it != m_dirtyMeshes.end())
+        {
+            m_dirtyMeshes.erase(it);
+        }
+    }
+
+    void RendererSystemComponent::MarkMeshRenderersDirty(Mesh* mesh)
+    {
+        // happens once per mesh, so the proxies are searched instead of keeping the renderers of every mesh
+        for (auto& proxy : m_renderProxies)
+        {
+            const bool drawsMesh = proxy.m_occluderMesh == mesh || AZStd::find_if(proxy.m_draws.begin(), proxy.m_draws.end(), [mesh](const RenderProxy::Draw& draw)
+            {
+                return draw.m_mesh == mesh;
+            }) != proxy.m_draws.end();
+            if (drawsMesh)
+            {
+                MarkRendererDirty(proxy.m_renderer);
+            }
+        }
+    }
+
+    void RendererSystemComponent::UpdateDirtyMeshes()
+    {
+        for (auto mesh : m_dirtyMeshes)
+        {
+            mesh->UpdateBuffers();
+            mesh->m_isDirty = false;
+        }
+        m_dirtyMeshes.clear();
+    }
+
+    void RendererSystemComponent::UpdateDirtyRenderers()
+    {
+        if (m_dirtyRenderers.empty())
+        {
+            return;
+        }
+        m_cullingScene.MarkStale();
+
+        size_t pendingCount = 0;
+
+        for (auto renderer : m_dirtyRenderers)
+        {
+            auto& proxy = m_renderProxies[renderer->m_proxyIndex];
+
+            const AZ::Transform& worldTM = renderer->m_worldTM;
+            worldTM.StoreToColumnMajorFloat16Ex(proxy.m_worldMatrix);
+            proxy.m_position = worldTM.GetPosition();
+            if (proxy.m_sortingLayer != renderer->m_sortingLayer || proxy.m_orderInLayer != renderer->m_orderInLayer)
+            {
+                proxy.m_sortingLayer = renderer->m_sortingLayer;
+                proxy.m_orderInLayer = renderer->m_orderInLayer;
+                m_isSortingRankStale = true;
+            }
+            proxy.m_layer = renderer->GetCullingLayer();
+            proxy.m_draws.clear();
+
+            const auto addDraws = [renderer, &proxy](Mesh* mesh, AZ::u32 lodLevel)
+            {
+                for (size_t materialIndex = 0; materialIndex < renderer->m_materials.size(); ++materialIndex)
+                {
+                    auto& material = renderer->m_materials[materialIndex];
+                    auto& shader = material->m_shader;
+
+                    for (size_t passIndex = 0; passIndex < shader->m_passes.size(); ++passIndex)
+                    {
+                        RenderProxy::Draw draw;
+                        draw.m_materialIndex = materialIndex;
+                        draw.m_material = material.get();
+                        draw.m_shader = shader.get();
+                        draw.m_pass = &shader->m_passes[passIndex];
+                        draw.m_mesh = mesh;
+                        draw.m_batchTexture = renderer->GetBatchTexture();
+                        draw.m_passIndex = static_cast<AZ::u32>(passIndex);
+                        draw.m_lodLevel = lodLevel;
+                        draw.m_propertyBlock = renderer->GetActivePropertyBlock();
+                        proxy.m_draws.push_back(draw);
+                    }
+                }
+            };
+
+            const bool isReady = renderer->IsReady();
+            const LodGroup* lodGroup = isReady ? renderer->GetLodGroup() : nullptr;
+            proxy.m_occluderMesh = renderer->m_isEnabled && renderer->m_isOccluder && isReady ? renderer->GetSharedMesh() : nullptr;
+            bool isLoadingLods = false;
+
+            if (isReady)
+            {
+                renderer->PrepareRender();
+
+                if (lodGroup == nullptr)
+                {
+                    addDraws(renderer->GetSharedMesh(), 0);
+                }
+            }
+
+            AZ::Aabb localBounds;
+            proxy.m_hasBounds = renderer->GetLocalBounds(localBounds);
+            if (proxy.m_hasBounds)
+            {
+                proxy.m_worldBounds = localBounds.GetTransformedAabb(worldTM);
+                proxy.m_boundsRadius = proxy.m_worldBounds.GetExtents().GetLength() * 0.5f;
+            }
+
+            if (lodGroup)
+            {
+                const AZ::u32 lodCount = static_cast<AZ::u32>(lodGroup->m_levels.size());
+                if (proxy.m_lodCount != lodCount)
+                {
+                    // every level counts as picked when the levels are (re)built, unused ones are released later on
+                    proxy.m_lodCount = lodCount;
+                    for (auto& lastUsed : proxy.m_lodLastUsed)
+                    {
+                        lastUsed = m_frameNumber;
+                    }
+                }
+                proxy.m_lodHysteresis = lodGroup->m_hysteresis;
+                proxy.m_lodFadeTime = lodGroup->m_crossFadeTime;
+                proxy.m_loadedLods = 0;
+                proxy.m_residentLods = 0;
+
+                for (AZ::u32 level = 0; level < lodCount; ++level)
+                {
+                    const auto& lod = lodGroup->m_levels[level];
+                    proxy.m_lodScreenHeights[level] = lod.m_screenHeight;
+                    if (!lod.m_mesh)
+                    {
+                        continue;
+                    }
+
+                    proxy.m_residentLods |= 1u << level;
+                    if (!lod.m_mesh->GetAabb().IsValid())
+                    {
+                        isLoadingLods = true;
+                        continue;
+                    }
+
+                    // the draws of a level only use the sub meshes it has
+                    const size_t drawBegin = proxy.m_draws.size();
+                    addDraws(lod.m_mesh.get(), level);
+                    proxy.m_draws.erase(AZStd::remove_if(proxy.m_draws.begin() + drawBegin, proxy.m_draws.end(), [&lod](const RenderProxy::Draw& draw)
+                    {
+                        return draw.m_materialIndex >= lod.m_mesh->GetSubMeshCount();
+                    }), proxy.m_draws.end());
+                    proxy.m_loadedLods |= 1u << level;
+                }
+            }
+            else
+            {
+                proxy.m_lodCount = 0;
+            }
+
+            // proxies with levels of detail stay visible without loaded levels, picking one makes it load
+            proxy.m_isVisible = renderer->m_isEnabled && !renderer->m_isBatched && (!proxy.m_draws.empty() || proxy.m_lodCount > 0);
+
+            if (renderer->m_isBatched)
+            {
+                m_isStaticBatchStale = true;
+            }
+            else if (renderer->m_isStatic && isReady && renderer->m_propertyBlock.IsEmpty() && lodGroup == nullptr)
+            {
+                m_hasNewStaticRenderers = true;
+            }
+
+            if (isReady && !isLoadingLods)
+            {
+                renderer->m_isDirty = false;
+            }
+            else
+            {
+                m_dirtyRenderers[pendingCount++] = renderer;
+            }
+        }
+
+        m_dirtyRenderers.resize(pendingCount);
+    }
+
+    void RendererSystemComponent::UpdateLodResidency()
+    {
+        for (auto& proxy : m_renderProxies)
+        {
+            if (proxy.m_lodCount == 0)
+            {
+                continue;
+            }
+
+            const AZ::u32 proxyIndex = static_cast<AZ::u32>(&proxy - m_renderProxies.data());
+            for (const auto& view : m_views)
+            {
+                const auto& state = view.m_lodStates[proxyIndex];
+                if (state.m_frame != m_frameNumber)
+                {
+                    continue;
+                }
+                if (state.m_level < proxy.m_lodCount)
+                {
+                    proxy.m_lodLastUsed[state.m_level] = m_frameNumber;
+                }
+                if (state.m_previous < proxy.m_lodCount)
+                {
+                    proxy.m_lodLastUsed[state.m_previous] = m_frameNumber;
+                }
+            }
+
+            AZ::u32 usedLods = 0;
+            for (AZ::u32 level = 0; level < proxy.m_lodCount; ++level)
+            {
+                if (m_frameNumber - proxy.m_lodLastUsed[level] < k_lodReleaseFrames)
+                {
+                    usedLods |= 1u << level;
+                }
+            }
+
+            // the renderer marks itself dirty when it loads or releases a mesh, which updates the resident levels
+            if (usedLods != proxy.m_residentLods)
+            {
+                proxy.m_renderer->SetResidentLods(usedLods);
+                proxy.m_residentLods = usedLods;
+            }
+        }
+    }
+
+    void RendererSystemComponent::RebuildStaticBatches()
+    {
+        // wait for static renderers which are still loading, unless a batch has to be thrown away anyway
+        if (!m_isStaticBatchStale && AZStd::find_if(m_dirtyRenderers.begin(), m_dirtyRenderers.end(), [](RendererComponent* renderer)
+        {
+            return renderer->m_isStatic;
+        }) != m_dirtyRenderers.end())
+        {
+            return;
+        }
+
+        m_isStaticBatchStale = false;
+        m_hasNewStaticRenderers = false;
+
+        m_staticBatches.clear();
+        m_cullingScene.MarkStale();
+
+        AZStd::vector<BatchUtil::Source> sources;
+
+        for (auto& proxy : m_renderProxies)
+        {
+            auto renderer = proxy.m_renderer;
+            auto mesh = renderer->GetSharedMesh();
+
+            // a batch draws all its ranges with the shared material, renderers with overrides are drawn on their own.
+            // batches have 16 bit indices, a sub mesh of a larger mesh may reference more vertices than they address
+            renderer->m_isBatched = renderer->m_isStatic && renderer->m_isEnabled && !renderer->m_isDirty && mesh != nullptr
+                && renderer->m_propertyBlock.IsEmpty() && renderer->GetLodGroup() == nullptr
+                && mesh->GetVertexCount() <= BatchUtil::MaxSourceVertexCount;
+            proxy.m_isVisible = renderer->m_isEnabled && !renderer->m_isBatched && (!proxy.m_draws.empty() || proxy.m_lodCount > 0);
+
+            if (!renderer->m_isBatched)
+            {
+                continue;
+            }
+
+            const size_t subMeshCount = AZStd::GetMin(renderer->m_materials.size(), mesh->GetSubMeshCount());
+            for (size_t subMeshIndex = 0; subMeshIndex < subMeshCount; ++subMeshIndex)
+            {
+                BatchUtil::Source source;
+                source.m_mesh = mesh;
+                source.m_subMeshIndex = subMeshIndex;
+                source.m_material = renderer->m_materials[subMeshIndex];
+                source.m_sortingLayer = renderer->m_sortingLayer;
+                source.m_orderInLayer = renderer->m_orderInLayer;
+                source.m_layer = renderer->GetCullingLayer();
+                source.m_worldTM = renderer->m_worldTM;
+                sources.push_back(source);
+            }
+        }
+
+        BatchUtil::BuildStaticBatches(sources, m_staticBatches);
+
+        for (auto& batch : m_staticBatches)
+        {
+            batch->m_mesh.UpdateBuffers();
+        }
+        m_isSortingRankStale = true;
+    }
+
+    void RendererSystemComponent::UpdateSortingRanks()
+    {
+        m_isSortingRankStale = false;
+
+        m_sortingOrders.Clear();
+        for (const auto& proxy : m_renderProxies)
+        {
+            m_sortingOrders.Add(proxy.m_sortingLayer, proxy.m_orderInLayer);
+        }
+        for (const auto& batch : m_staticBatches)
+        {
+            m_sortingOrders.Add(batch->m_sortingLayer, batch->m_orderInLayer);
+        }
+        m_sortingOrders.Finalize();
+
+        for (auto& proxy : m_renderProxies)
+        {
+            proxy.m_sortingRank = m_sortingOrders.GetRank(proxy.m_sortingLayer, proxy.m_orderInLayer);
+        }
+        for (auto& batch : m_staticBatches)
+        {
+            batch->m_sortingRank = m_sortingOrders.GetRank(batch->m_sortingLayer, batch->m_orderInLayer);
+        }
+    }
+
     void RendererSystemComponent::OnWindowSizeChanged(int width, int height)
     {
         bgfx::reset(width, height
@@ -6,6 +6,14 @@
 
 #include <AzCore/std/smart_ptr/unique_ptr.h>
 
+#include "Renderer/Base/CullingScene.h"
+#include "Renderer/Base/RenderNode.h"
+#include "Renderer/Base/RenderProxy.h"
+#include "Renderer/Base/RenderView.h"
+#include "Renderer/Base/SpriteBatcher.h"
+#include "Renderer/Base/StaticBatch.h"
+#include "Renderer/Base/SubmitState.h"
+#include "Renderer/Base/TransientGeometry.h"
 #include "Renderer/EBus/RendererSystemComponentBus.h"
 #include "Window/EBus/WindowSystemComponentBus.h"
 
@@ -34,6 +42,7 @@ namespace Module
         {
             dependent.push_back(AZ_CRC("WindowSystemService"));
             dependent.push_back(AZ_CRC("AssetDatabaseService"));
+            dependent.push_back(AZ_CRC("JobsService"));
         }
 
         static void GetRequiredServices(AZ::ComponentDescriptor::DependencyArrayType& required)
@@ -48,6 +57,9 @@ namespace Module
         RendererSystemComponent(const RendererSystemComponent&) = delete;
         ~RendererSystemComponent() override = default;
 
+        // bgfx::RendererType::Count picks the default backend of the platform, applied on activation
+        void SetRendererType(bgfx::RendererType::Enum type) { m_rendererType = type; }
+
     protected:
         /////////////////////////////////////////////////////////////////////////////////////
         // AZ::Component
@@ -67,9 +79,33 @@ namespace Module
 
         TexturePtr  GetTexture(const AZStd::string& path) override;
         ShaderPtr   GetShader(const AZStd::string& path) override;
+        ProgramPtr  GetProgram(const AZStd::string& vsPath, const AZStd::string& fsPath) override;
+        AZ::u16     GetProgramSortId(AZ::u64 contentHash) override;
         MaterialPtr GetMaterial(const AZStd::string& path) override;
         MeshPtr     GetMesh(AZStd::string& path) override;
         SpritePtr   GetSprite(const AZStd::string& path, const AZStd::string& spriteName) override;
+
+        void        SetTextureBudget(AZ::u64 bytes) override;
+        ResidentCacheStats GetTextureCacheStats() const override;
+
+        void        SetMeshBudget(AZ::u64 bytes) override;
+        ResidentCacheStats GetMeshCacheStats() const override;
+
+        void        SetMaxFramesInFlight(AZ::u32 frameCount) override;
+        TransientGeometry* GetTransientGeometry() override { return &m_transientGeometry; }
+
+        void        SetFrameProfilerCapacity(AZ::u32 frameCount) override;
+        AZ::u32     GetProfiledFrameCount() const override;
+        FrameStats  GetProfiledFrame(AZ::u32 index) const override;
+        bool        DumpFrameProfile(const AZStd::string& path) const override;
+
+        void        RegisterRenderer(RendererComponent* renderer) override;
+        void        UnregisterRenderer(RendererComponent* renderer) override;
+        void        MarkRendererDirty(RendererComponent* renderer) override;
+
+        void        MarkMeshDirty(Mesh* mesh) override;
+        void        ClearMeshDirty(Mesh* mesh) override;
+        void        MarkMeshRenderersDirty(Mesh* mesh) override;
         /////////////////////////////////////////////////////////////////////////////////////
 
         /////////////////////////////////////////////////////////////////////////////////////
@@ -78,14 +114,100 @@ namespace Module
         /////////////////////////////////////////////////////////////////////////////////////
 
     private:
+        // slice of a sorted render queue recorded by one submission job, the counters are filled while recording
+        struct SubmitRange
+        {
+            AZ::u32 m_viewIndex     = 0;
+            AZ::u32 m_begin         = 0;
+            AZ::u32 m_end           = 0;
+            int64_t m_ticks         = 0;
+            AZ::u32 m_stateChanges  = 0;
+            AZ::u32 m_triangleCount = 0;
+            AZ::u32 m_spriteBatchCount   = 0;
+            AZ::u32 m_droppedSpriteCount = 0;
+        };
+
+        // uploads the written ranges of meshes modified since the last tick
+        void UpdateDirtyMeshes();
+
+        // rebuilds the proxies of dirty renderers, the ones which are not ready yet stay dirty
+        void UpdateDirtyRenderers();
+
+        // merges the geometry of all ready static renderers, their proxies are hidden while they are batched
+        void RebuildStaticBatches();
+
+        // ranks the sorting pairs of all proxies and batches, they only change with the pairs of the renderers
+        void UpdateSortingRanks();
+
+        // tests the proxies of the culling scene against the frustum of the camera of the view, runs in a job
+        void CullView(RenderView& view);
+
+        // draws the occluders of the culling scene into the occlusion buffer of the view, runs in a job next to the
+        // CullView jobs
+        void DrawOccluders(RenderView& view);
+
+        // drops the proxies hidden by occluders, culls the static batches and gathers and sorts the render queue of the
+        // view, runs in a job once all views are culled
+        void BuildView(RenderView& view);
+
+        // picks the level of detail of a visible proxy for the camera of the view and adds the draws of it, and of
+        // the level it fades out from, to the render queue
+        void GatherLodDraws(RenderView& view, AZ::u32 proxyIndex, float distance);
+
+        // adds one draw of the proxy to the render queue of the view
+        RenderNode& GatherDraw(RenderView& view, const RenderProxy& proxy, const RenderProxy::Draw& draw, float distance);
+
+        // lets renderers release the meshes of levels of detail no camera picked for a while, and load the picked
+        // ones they released
+        void UpdateLodResidency();
+
+        // records the sorted nodes of the range into the encoder, runs in a job, `state` tracks the bindings left in
+        // the encoder by preserved submits
+        void SubmitView(bgfx::Encoder* encoder, SpriteBatcher& spriteBatcher, SubmitState& state, const RenderView& view, SubmitRange& range) const;
+
         AZStd::vector<AZStd::unique_ptr<AZ::Data::AssetHandler>> m_assetHandlers;
 
-        AZStd::unordered_map<AZStd::string, AZStd::weak_ptr<Texture>>  m_textures;
+        AZStd::vector<RenderProxy>        m_renderProxies;
+        AZStd::vector<RendererComponent*> m_dirtyRenderers;
+        AZStd::vector<Mesh*>              m_dirtyMeshes;
+        CullingScene                      m_cullingScene; // rebuilt when the proxies changed, read by all cameras
+
+        AZStd::vector<StaticBatchPtr>     m_staticBatches;
+        bool                              m_hasNewStaticRenderers = false; // rebuild once no static renderer is loading
+        bool                              m_isStaticBatchStale    = false; // a batched renderer changed, rebuild now
+
+        SortingOrders                     m_sortingOrders;
+        bool                              m_isSortingRankStale    = false; // a proxy or batch was added or changed its pair
+
+        ResidentCache<Texture>                                          m_textures;
+        ResidentCache<Program>                                          m_programs; // by vertex and fragment shader asset id
+        AZStd::unordered_map<AZ::u64, AZ::u16>                          m_programSortIds; // never shrinks, a reloaded program keeps its id
+        AZ::u16                                                         m_nextProgramSortId = 0;
         AZStd::unordered_map<AZStd::string, AZStd::weak_ptr<Shader>>   m_shaders;
         AZStd::unordered_map<AZStd::string, AZStd::weak_ptr<Material>> m_materials;
-        AZStd::unordered_map<AZStd::string, AZStd::weak_ptr<Mesh>>     m_meshes;
-        AZStd::unordered_map<AZStd::string, AZStd::weak_ptr<Sprite>>   m_sprites;
-
-        uint32_t m_resetFlags = BGFX_RESET_NONE;
+        ResidentCache<Mesh>                                             m_meshes;
+        AZStd::unordered_map<AZStd::pair<AZStd::string, AZStd::string>, AZStd::weak_ptr<Sprite>> m_sprites; // by path and sprite name
+
+        // reused between frames to avoid reallocating the render queues
+        AZStd::vector<RenderView>                       m_views;
+        AZStd::vector<AZ::u32>                          m_occludingViews; // views drawing occluders this frame
+        AZStd::vector<SubmitRange>                      m_submitRanges;
+        AZStd::vector<AZStd::unique_ptr<SpriteBatcher>> m_spriteBatchers; // one per submission job
+        AZStd::vector<SubmitState>                      m_submitStates;   // one per submission job
+        AZ::u32                                         m_submitJobCount = 1;
+
+        FrameProfiler                                   m_frameProfiler;
+        TransientGeometry                               m_transientGeometry;
+
+        uint32_t m_resetFlags            = BGFX_RESET_NONE;
+        AZ::u32  m_textureBudgetMB       = 64;
+        AZ::u32  m_meshBudgetMB          = 32;
+        AZ::u32  m_frameNumber           = 0;     // ticks since activation, stamps the level of detail states
+        float    m_frameDeltaTime        = 0.0f;  // advances level of detail cross-fades
+        AZ::u32  m_profiledFrameCount    = 0;     // frames kept by the profiler from activation on, 0 records none
+        AZ::u32  m_rendererType          = bgfx::RendererType::Count;
+        AZ::u32  m_maxFramesInFlight     = 1;
+        bool     m_isInstancingSupported = false;
+        bool     m_isRenderThreaded      = false; // bgfx renders on another thread, the noop renderer always claims so
     };
 }
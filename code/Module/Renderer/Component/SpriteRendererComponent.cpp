@@ -26,7 +26,73 @@ namespace Module
         RendererComponent::Deactivate();
     }
 
-    void SpriteRendererComponent::Render(size_t subMeshIndex)
+    bool SpriteRendererComponent::GetLocalBounds(AZ::Aabb& bounds) const
     {
+        if (!m_sprite || !m_sprite->GetBounds(bounds))
+        {
+            return false;
+        }
+        if (m_isFlipX || m_isFlipY)
+        {
+            const AZ::Vector3 scale(m_isFlipX ? -1.0f : 1.0f, m_isFlipY ? -1.0f : 1.0f, 1.0f);
+            const AZ::Vector3 min = bounds.GetMin() * scale;
+            const AZ::Vector3 max = bounds.GetMax() * scale;
+            bounds = AZ::Aabb::CreateFromMinMax(min.GetMin(max), min.GetMax(max));
+        }
+        return true;
+    }
+
+    bool SpriteRendererComponent::IsReady() const
+    {
+        return m_sprite && m_sprite->IsValid() && RendererComponent::IsReady();
+    }
+
+    Texture* SpriteRendererComponent::GetBatchTexture() const
+    {
+        return m_sprite ? m_sprite->GetTexture() : nullptr;
+    }
+
+    void SpriteRendererComponent::GetBatchGeometrySize(AZ::u32& vertexCount, AZ::u32& indexCount) const
+    {
+        const auto* spriteData = m_sprite ? m_sprite->GetSpriteData() : nullptr;
+        vertexCount = spriteData ? static_cast<AZ::u32>(spriteData->m_positions.size()) : 0;
+        indexCount = spriteData ? static_cast<AZ::u32>(spriteData->m_indices.size() - spriteData->m_indices.size() % 3) : 0;
+    }
+
+    void SpriteRendererComponent::FillBatchGeometry(const SpriteBatcher::Geometry& geometry, const float* worldMatrix) const
+    {
+        const auto& spriteData = *m_sprite->GetSpriteData();
+
+        const float unitsPerPixel = m_sprite->GetUnitsPerPixel();
+        const float scaleX = m_isFlipX ? -unitsPerPixel : unitsPerPixel;
+        const float scaleY = m_isFlipY ? -unitsPerPixel : unitsPerPixel;
+        const AZ::u32 abgr = m_color.ToU32();
+
+        // the world matrix is column major, as passed to bgfx::setTransform
+        const float* m = worldMatrix;
+        for (size_t i = 0; i < spriteData.m_positions.size(); ++i)
+        {
+            const AZ::Vector3& position = spriteData.m_positions[i];
+            const float x = position.GetX() * scaleX;
+            const float y = position.GetY() * scaleY;
+            const float z = position.GetZ() * unitsPerPixel;
+
+            auto& vertex = geometry.m_vertices[i];
+            vertex.m_x = m[0] * x + m[4] * y + m[8] * z + m[12];
+            vertex.m_y = m[1] * x + m[5] * y + m[9] * z + m[13];
+            vertex.m_z = m[2] * x + m[6] * y + m[10] * z + m[14];
+            vertex.m_abgr = abgr;
+            vertex.m_u = spriteData.m_texcoords[i].GetX();
+            vertex.m_v = spriteData.m_texcoords[i].GetY();
+        }
+
+        // flipping one axis mirrors the sprite, keep the winding order
+        const bool isMirrored = m_isFlipX != m_isFlipY;
+        for (size_t i = 0; i + 2 < spriteData.m_indices.size(); i += 3)
+        {
+            geometry.m_indices[i + 0] = static_cast<AZ::u16>(geometry.m_baseVertex + spriteData.m_indices[i]);
+            geometry.m_indices[i + 1] = static_cast<AZ::u16>(geometry.m_baseVertex + spriteData.m_indices[isMirrored ? i + 2 : i + 1]);
+            geometry.m_indices[i + 2] = static_cast<AZ::u16>(geometry.m_baseVertex + spriteData.m_indices[isMirrored ? i + 1 : i + 2]);
+        }
     }
 }
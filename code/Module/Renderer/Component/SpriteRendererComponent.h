@@ -45,7 +45,7 @@ namespace Module
         /////////////////////////////////////////////////////////////////////////////////////
         // SpriteRendererRequestBus::Handler
         SpritePtr        GetSprite() const                override { return m_sprite; }
-        void             SetSprite(SpritePtr sprite)      override { m_sprite = sprite; }
+        void             SetSprite(SpritePtr sprite)      override { m_sprite = sprite; MarkDirty(); }
 
         const AZ::Color& GetColor() const                 override { return m_color; }
         void             SetColor(const AZ::Color& value) override { m_color = value; }
@@ -54,17 +54,25 @@ namespace Module
         void             SetDrawMode(SpriteDrawMode mode) override { m_drawMode = mode; }
 
         bool             IsFilpX() const                  override { return m_isFlipX; }
-        void             SetFlipX(bool value)             override { m_isFlipX = value; }
+        void             SetFlipX(bool value)             override { m_isFlipX = value; MarkDirty(); }
 
         bool             IsFlipY() const                  override { return m_isFlipY; }
-        void             SetFlipY(bool value)             override { m_isFlipY = value; }
+        void             SetFlipY(bool value)             override { m_isFlipY = value; MarkDirty(); }
         /////////////////////////////////////////////////////////////////////////////////////
 
-        void Render(size_t subMeshIndex) override;
+        bool GetLocalBounds(AZ::Aabb& bounds) const override;
+
+        bool IsReady() const override;
+
+        Texture* GetBatchTexture() const override;
+
+        void GetBatchGeometrySize(AZ::u32& vertexCount, AZ::u32& indexCount) const override;
+
+        void FillBatchGeometry(const SpriteBatcher::Geometry& geometry, const float* worldMatrix) const override;
 
     private:
         SpritePtr      m_sprite;
-        AZ::Color      m_color;
+        AZ::Color      m_color    = AZ::Color::CreateOne();
         SpriteDrawMode m_drawMode = SpriteDrawMode::Simple;
         bool           m_isFlipX  = false;
         bool           m_isFlipY  = false;
@@ -45,6 +45,17 @@ namespace Module
         virtual int                GetDepth() const                      = 0;
         virtual void               SetDepth(int depth)                   = 0;
 
+        // bit per renderer layer the camera draws, all of them by default
+        virtual AZ::u32            GetCullingMask() const                = 0;
+        virtual void               SetCullingMask(AZ::u32 mask)          = 0;
+
+        // hides renderers behind occluders, tested on a depth buffer the camera draws the occluders into on the CPU
+        virtual bool               IsOcclusionCulling() const            = 0;
+        virtual void               SetOcclusionCulling(bool value)       = 0;
+
+        virtual AZ::u32            GetVisibleCount() const               = 0;
+        virtual AZ::u32            GetCulledCount() const                = 0;
+        virtual AZ::u32            GetOccludedCount() const              = 0;
     };
 
     using CameraRequestBus = AZ::EBus<CameraRequest>;
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <AzCore/Component/ComponentBus.h>
+#include <AzCore/RTTI/TypeInfo.h>
+#include <AzCore/std/containers/vector.h>
+#include <AzCore/std/string/string.h>
+
+namespace Module
+{
+    // A level is drawn while the bounding sphere of the renderer covers at least `m_screenHeight` of the viewport
+    // height and no finer level qualifies
+    struct LodLevel
+    {
+        AZ_TYPE_INFO(LodLevel, "{73297219-B4B7-45D8-870F-4DE96A68564B}");
+
+        AZStd::string m_mesh;                // empty draws the mesh of the mesh filter
+        float         m_screenHeight = 0.0f; // 0 keeps the level down to any size
+    };
+
+    class LodGroupRequest : public AZ::ComponentBus
+    {
+    public:
+        // from the finest level to the coarsest, renderers smaller than the threshold of the last level are not drawn
+        virtual const AZStd::vector<LodLevel>& GetLevels() const                              = 0;
+        virtual void                           SetLevels(const AZStd::vector<LodLevel>& levels) = 0;
+
+        // fraction of a threshold the screen height has to pass it by before the level changes, so renderers close
+        // to a threshold do not switch back and forth
+        virtual float GetHysteresis() const            = 0;
+        virtual void  SetHysteresis(float value)       = 0;
+
+        // seconds the old and the new level are dithered into each other after a change, 0 switches at once. Only
+        // shaders reading u_lodFade fade, see RenderNode.
+        virtual float GetCrossFadeTime() const         = 0;
+        virtual void  SetCrossFadeTime(float value)    = 0;
+    };
+
+    using LodGroupRequestBus = AZ::EBus<LodGroupRequest>;
+
+    class LodGroupNotification : public AZ::ComponentBus
+    {
+    public:
+        virtual void OnLodGroupChanged() {}
+    };
+
+    using LodGroupNotificationBus = AZ::EBus<LodGroupNotification>;
+}
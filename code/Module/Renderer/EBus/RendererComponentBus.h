@@ -20,11 +20,25 @@ namespace Module
         virtual MaterialPtr GetMaterial(size_t index) const                 = 0;
         virtual void        SetMaterial(size_t index, MaterialPtr material) = 0;
 
+        // overrides applied on top of the materials without giving up sorting and instancing with their other users
+        virtual MaterialPropertyBlock GetPropertyBlock() const                           = 0;
+        virtual void                  SetPropertyBlock(const MaterialPropertyBlock& block) = 0;
+
         virtual AZ::s16     GetSortingLayer() const                         = 0;
         virtual void        SetSortingLayer(AZ::s16 value)                  = 0;
 
         virtual AZ::s16     GetOrderInLayer() const                         = 0;
         virtual void        SetOrderInLayer(AZ::s16 value)                  = 0;
+
+        // layer in [0, 31] matched against the culling mask of the cameras, unlike the sorting layer it decides
+        // which cameras draw the renderer at all
+        virtual AZ::u8      GetLayer() const                                = 0;
+        virtual void        SetLayer(AZ::u8 value)                          = 0;
+
+        // the shared mesh of an occluder hides the renderers behind it from cameras culling occlusion, walls and
+        // buildings with few triangles make good occluders
+        virtual bool        IsOccluder() const                              = 0;
+        virtual void        SetOccluder(bool value)                         = 0;
     };
 
     using RendererRequestBus = AZ::EBus<RendererRequest>;
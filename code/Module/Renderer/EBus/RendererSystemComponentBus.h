@@ -5,11 +5,17 @@
 #include "Renderer/Base/Mesh.h"
 #include "Renderer/Base/Texture.h"
 #include "Renderer/Base/Sprite.h"
+#include "Renderer/Base/Program.h"
+#include "Renderer/Base/ResidentCache.h"
+#include "Renderer/Base/FrameProfiler.h"
 
 #include <AzCore/EBus/EBus.h>
 
 namespace Module
 {
+    class RendererComponent;
+    class TransientGeometry;
+
     enum class BasicMeshType : AZ::u8
     {
         Cube,
@@ -34,11 +40,66 @@ namespace Module
 
         virtual ShaderPtr   GetShader(const AZStd::string& path) = 0;
 
+        // passes of different shaders naming the same vertex and fragment shader assets share one program
+        virtual ProgramPtr  GetProgram(const AZStd::string& vsPath, const AZStd::string& fsPath) = 0;
+
+        // stable sort id of the program with the hash of its shader binaries
+        virtual AZ::u16     GetProgramSortId(AZ::u64 contentHash) = 0;
+
         virtual MaterialPtr GetMaterial(const AZStd::string& path) = 0;
 
         virtual MeshPtr     GetMesh(AZStd::string& path) = 0;
         
         virtual SpritePtr   GetSprite(const AZStd::string& path, const AZStd::string& spriteName) = 0;
+
+        // released textures stay resident until their gpu size exceeds the budget, the least recently released ones
+        // are destroyed first
+        virtual void        SetTextureBudget(AZ::u64 bytes) = 0;
+
+        virtual ResidentCacheStats GetTextureCacheStats() const = 0;
+
+        // released meshes stay resident until their vertices and indices exceed the budget, levels of detail no
+        // camera picked lately are released by their renderers
+        virtual void        SetMeshBudget(AZ::u64 bytes) = 0;
+
+        virtual ResidentCacheStats GetMeshCacheStats() const = 0;
+
+        // Frames the render thread may still be rendering when a tick ends. With 1 the next tick is recorded while
+        // the last one renders, with 0 the tick waits for its frame, which shortens the input latency and loses the
+        // overlap. bgfx double buffers, larger values act as 1. Waiting needs the render thread of the launcher, see
+        // RenderThread.
+        virtual void        SetMaxFramesInFlight(AZ::u32 frameCount) = 0;
+
+        // per frame geometry for renderers that rebuild theirs every frame, write after the renderer system ticked
+        virtual TransientGeometry* GetTransientGeometry() = 0;
+
+        // keeps the stats of the last `frameCount` frames, 0 stops profiling and drops the recorded frames
+        virtual void        SetFrameProfilerCapacity(AZ::u32 frameCount) = 0;
+
+        virtual AZ::u32     GetProfiledFrameCount() const = 0;
+
+        // 0 is the oldest recorded frame
+        virtual FrameStats  GetProfiledFrame(AZ::u32 index) const = 0;
+
+        // writes the recorded frames as json, for comparing frame budgets between builds
+        virtual bool        DumpFrameProfile(const AZStd::string& path) const = 0;
+
+        // retained render registry, renderers stay registered while active and mark themselves dirty
+        // whenever their world transform, materials or bounds change
+        virtual void RegisterRenderer(RendererComponent* renderer) = 0;
+
+        virtual void UnregisterRenderer(RendererComponent* renderer) = 0;
+
+        virtual void MarkRendererDirty(RendererComponent* renderer) = 0;
+
+        // meshes written through their mutation api queue themselves for a partial upload on the next tick
+        virtual void MarkMeshDirty(Mesh* mesh) = 0;
+
+        virtual void ClearMeshDirty(Mesh* mesh) = 0;
+
+        // a mesh became dynamic or changed its layout, the renderers drawing it are rebuilt, which takes them out of
+        // static batches, instancing and the occluders that copied its geometry
+        virtual void MarkMeshRenderersDirty(Mesh* mesh) = 0;
     };
 
     using RendererSystemRequestBus = AZ::EBus<RendererSystemRequest>;
@@ -3,8 +3,10 @@
 
 #include "Renderer/Component/RendererSystemComponent.h"
 #include "Renderer/Component/MeshFilterComponent.h"
+#include "Renderer/Component/MeshRendererComponent.h"
 #include "Renderer/Component/RendererComponent.h"
 #include "Renderer/Component/CameraComponent.h"
+#include "Renderer/Component/LodGroupComponent.h"
 #include "Renderer/Component/SpriteRendererComponent.h"
 
 namespace Module
@@ -21,9 +23,11 @@ namespace Module
             m_descriptors.insert(m_descriptors.end(), {
                 RendererSystemComponent::CreateDescriptor(),
                 MeshFilterComponent::CreateDescriptor(),
+                MeshRendererComponent::CreateDescriptor(),
                 RendererComponent::CreateDescriptor(),
                 CameraComponent::CreateDescriptor(),
                 SpriteRendererComponent::CreateDescriptor(),
+                LodGroupComponent::CreateDescriptor(),
             });
         }
 
@@ -0,0 +1,252 @@
+#include "Renderer/Util/BatchUtil.h"
+
+#include <AzCore/std/sort.h>
+
+namespace Module
+{
+    namespace
+    {
+        // vertex indices are 16 bit, a batch can not address more vertices than that
+        const size_t k_maxBatchVertexCount = BatchUtil::MaxSourceVertexCount;
+
+        bool IsSameBatch(const BatchUtil::Source& lhv, const BatchUtil::Source& rhv)
+        {
+            return lhv.m_material == rhv.m_material
+                && lhv.m_sortingLayer == rhv.m_sortingLayer
+                && lhv.m_orderInLayer == rhv.m_orderInLayer
+                && lhv.m_layer == rhv.m_layer
+                && lhv.m_mesh->GetVertexDecl().m_hash == rhv.m_mesh->GetVertexDecl().m_hash;
+        }
+
+        // The meshes of a batch do not share the bounds their positions and texcoords were normalized in, and world
+        // space positions leave them anyway, so batches store those attributes as floats. Octahedral directions are
+        // kept, they do not depend on the mesh.
+        bgfx::VertexDecl GetBatchDecl(const bgfx::VertexDecl& decl)
+        {
+            if (!QuantizeUtil::IsNormalizedInBounds(decl, bgfx::Attrib::Position)
+                && !QuantizeUtil::IsNormalizedInBounds(decl, bgfx::Attrib::TexCoord0)
+                && !QuantizeUtil::IsNormalizedInBounds(decl, bgfx::Attrib::TexCoord1))
+            {
+                return decl;
+            }
+
+            AZStd::vector<bgfx::Attrib::Enum> attribs;
+            for (AZ::u32 attrib = 0; attrib < bgfx::Attrib::Count; ++attrib)
+            {
+                if (decl.has(bgfx::Attrib::Enum(attrib)))
+                {
+                    attribs.push_back(bgfx::Attrib::Enum(attrib));
+                }
+            }
+            AZStd::sort(attribs.begin(), attribs.end(), [&decl](bgfx::Attrib::Enum lhv, bgfx::Attrib::Enum rhv)
+            {
+                return decl.getOffset(lhv) < decl.getOffset(rhv);
+            });
+
+            bgfx::VertexDecl batchDecl;
+            batchDecl.begin();
+            for (auto attrib : attribs)
+            {
+                AZ::u8 num;
+                bgfx::AttribType::Enum type;
+                bool normalized, asInt;
+                decl.decode(attrib, num, type, normalized, asInt);
+                if (QuantizeUtil::IsNormalizedInBounds(decl, attrib))
+                {
+                    batchDecl.add(attrib, attrib == bgfx::Attrib::Position ? 3 : 2, bgfx::AttribType::Float);
+                }
+                else
+                {
+                    batchDecl.add(attrib, num, type, normalized, asInt);
+                }
+            }
+            batchDecl.end();
+            return batchDecl;
+        }
+
+        // the vertex is in the layout of the batch, which needs no dequantization
+        void TransformVertex(const BatchUtil::Source& source, const AZ::Transform& normalTM, const bgfx::VertexDecl& decl, char* vertex, AZ::Aabb& bounds)
+        {
+            const QuantizeUtil::Dequantization identity;
+            float value[4];
+
+            QuantizeUtil::Unpack(value, bgfx::Attrib::Position, decl, identity, vertex);
+            const auto position = source.m_worldTM * AZ::Vector3(value[0], value[1], value[2]);
+            position.StoreToFloat3(value);
+            QuantizeUtil::Pack(value, bgfx::Attrib::Position, decl, identity, vertex);
+            bounds.AddPoint(position);
+
+            if (decl.has(bgfx::Attrib::Normal))
+            {
+                QuantizeUtil::Unpack(value, bgfx::Attrib::Normal, decl, identity, vertex);
+                const auto normal = normalTM.Multiply3x3(AZ::Vector3(value[0], value[1], value[2])).GetNormalizedSafe();
+                normal.StoreToFloat3(value);
+                QuantizeUtil::Pack(value, bgfx::Attrib::Normal, decl, identity, vertex);
+            }
+
+            if (decl.has(bgfx::Attrib::Tangent))
+            {
+                // keep w, it stores the handedness of the bitangent
+                QuantizeUtil::Unpack(value, bgfx::Attrib::Tangent, decl, identity, vertex);
+                const auto tangent = source.m_worldTM.Multiply3x3(AZ::Vector3(value[0], value[1], value[2])).GetNormalizedSafe();
+                tangent.StoreToFloat3(value);
+                QuantizeUtil::Pack(value, bgfx::Attrib::Tangent, decl, identity, vertex);
+            }
+        }
+    }
+
+    void BatchUtil::BuildStaticBatches(AZStd::vector<Source>& sources, AZStd::vector<StaticBatchPtr>& batches)
+    {
+        if (sources.empty())
+        {
+            return;
+        }
+
+        // order the sources along the longest axis of the scene so that neighbours in space end up next to each
+        // other in the index buffer, visible sub meshes can then often be drawn as one merged range
+        AZ::Aabb sceneBounds = AZ::Aabb::CreateNull();
+        for (const auto& source : sources)
+        {
+            sceneBounds.AddPoint(source.m_worldTM.GetPosition());
+        }
+        const AZ::Vector3 extents = sceneBounds.GetExtents();
+        const int axis = extents.GetX() >= extents.GetY() && extents.GetX() >= extents.GetZ() ? 0 : (extents.GetY() >= extents.GetZ() ? 1 : 2);
+
+        AZStd::sort(sources.begin(), sources.end(), [axis](const Source& lhv, const Source& rhv)
+        {
+            if (lhv.m_material != rhv.m_material)
+            {
+                return lhv.m_material < rhv.m_material;
+            }
+            if (lhv.m_sortingLayer != rhv.m_sortingLayer)
+            {
+                return lhv.m_sortingLayer < rhv.m_sortingLayer;
+            }
+            if (lhv.m_orderInLayer != rhv.m_orderInLayer)
+            {
+                return lhv.m_orderInLayer < rhv.m_orderInLayer;
+            }
+            if (lhv.m_layer != rhv.m_layer)
+            {
+                return lhv.m_layer < rhv.m_layer;
+            }
+            if (lhv.m_mesh->GetVertexDecl().m_hash != rhv.m_mesh->GetVertexDecl().m_hash)
+            {
+                return lhv.m_mesh->GetVertexDecl().m_hash < rhv.m_mesh->GetVertexDecl().m_hash;
+            }
+            return float(lhv.m_worldTM.GetPosition().GetElement(axis)) < float(rhv.m_worldTM.GetPosition().GetElement(axis));
+        });
+
+        StaticBatch* batch = nullptr;
+        const Source* batchSource = nullptr;
+
+        AZStd::vector<AZ::s32> remap;
+        AZStd::vector<AZ::u32> usedVertices;
+
+        for (const auto& source : sources)
+        {
+            const Mesh& mesh = *source.m_mesh;
+            const auto& subMesh = mesh.m_subMeshes[source.m_subMeshIndex];
+            const auto& meshDecl = mesh.m_vertexDesc;
+            const size_t meshStride = meshDecl.getStride();
+
+            // only the vertices referenced by the sub mesh are copied
+            const char* meshVertices = mesh.GetVertexData();
+
+            remap.assign(mesh.GetVertexCount(), -1);
+            usedVertices.clear();
+            for (AZ::u32 i = 0; i < subMesh.m_indexCount; ++i)
+            {
+                const AZ::u32 index = mesh.GetIndex(subMesh.m_firstIndex + i);
+                if (remap[index] < 0)
+                {
+                    remap[index] = static_cast<AZ::s32>(usedVertices.size());
+                    usedVertices.push_back(index);
+                }
+            }
+
+            AZ_Assert(usedVertices.size() <= k_maxBatchVertexCount, "Sub mesh references more vertices than a batch addresses\n");
+
+            const bgfx::VertexDecl decl = GetBatchDecl(meshDecl);
+            const size_t stride = decl.getStride();
+
+            if (batch != nullptr)
+            {
+                const size_t batchVertexCount = batch->m_mesh.m_vertices.size() / stride;
+                if (!IsSameBatch(*batchSource, source) || batchVertexCount + usedVertices.size() > k_maxBatchVertexCount)
+                {
+                    batch = nullptr;
+                }
+            }
+
+            if (batch == nullptr)
+            {
+                batches.emplace_back(aznew StaticBatch);
+                batch = batches.back().get();
+                batchSource = &source;
+
+                batch->m_material = source.m_material;
+                batch->m_sortingLayer = source.m_sortingLayer;
+                batch->m_orderInLayer = source.m_orderInLayer;
+                batch->m_layer = source.m_layer;
+                batch->m_mesh.m_vertexDesc = decl; // 16 bit indices and no dequantization
+                batch->m_mesh.MarkUnique();
+            }
+
+            auto& vertices = batch->m_mesh.m_vertices;
+            auto& indices = batch->m_mesh.m_indices;
+
+            const size_t baseVertex = vertices.size() / stride;
+            vertices.resize(vertices.size() + usedVertices.size() * stride);
+
+            StaticBatch::Range range;
+            range.m_firstIndex = static_cast<AZ::u32>(indices.size() / sizeof(AZ::u16));
+            range.m_indexCount = subMesh.m_indexCount - subMesh.m_indexCount % 3;
+
+            const bool isConverted = decl.m_hash != meshDecl.m_hash;
+            const AZ::Transform normalTM = source.m_worldTM.GetInverseFull().GetTranspose3x3();
+            for (size_t i = 0; i < usedVertices.size(); ++i)
+            {
+                char* vertex = vertices.data() + (baseVertex + i) * stride;
+                const char* meshVertex = meshVertices + usedVertices[i] * meshStride;
+                if (isConverted)
+                {
+                    for (AZ::u32 attrib = 0; attrib < bgfx::Attrib::Count; ++attrib)
+                    {
+                        if (decl.has(bgfx::Attrib::Enum(attrib)))
+                        {
+                            float value[4];
+                            QuantizeUtil::Unpack(value, bgfx::Attrib::Enum(attrib), meshDecl, mesh.m_dequantization, meshVertex);
+                            QuantizeUtil::Pack(value, bgfx::Attrib::Enum(attrib), decl, batch->m_mesh.m_dequantization, vertex);
+                        }
+                    }
+                }
+                else
+                {
+                    memcpy(vertex, meshVertex, stride);
+                }
+                TransformVertex(source, normalTM, decl, vertex, range.m_worldBounds);
+            }
+
+            // mirroring transforms flip the winding order, restore it so the culling state still applies
+            const bool isMirrored = source.m_worldTM.GetDeterminant3x3() < 0.0f;
+            indices.resize(indices.size() + range.m_indexCount * sizeof(AZ::u16));
+            AZ::u16* batchIndices = reinterpret_cast<AZ::u16*>(indices.data()) + range.m_firstIndex;
+            for (AZ::u32 i = 0; i + 2 < subMesh.m_indexCount; i += 3)
+            {
+                const AZ::u32 first = subMesh.m_firstIndex + i;
+                *batchIndices++ = static_cast<AZ::u16>(baseVertex + remap[mesh.GetIndex(first)]);
+                *batchIndices++ = static_cast<AZ::u16>(baseVertex + remap[mesh.GetIndex(first + (isMirrored ? 2 : 1))]);
+                *batchIndices++ = static_cast<AZ::u16>(baseVertex + remap[mesh.GetIndex(first + (isMirrored ? 1 : 2))]);
+            }
+
+            batch->m_worldBounds.AddAabb(range.m_worldBounds);
+            batch->m_ranges.push_back(range);
+        }
+
+        for (auto& builtBatch : batches)
+        {
+            builtBatch->m_mesh.m_aabb = builtBatch->m_worldBounds;
+        }
+    }
+}
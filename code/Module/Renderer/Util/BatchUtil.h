@@ -1,9 +1,60 @@
 #pragma once
 
+#include "Renderer/Base/StaticBatch.h"
+
+#include <AzCore/Math/Transform.h>
+
 namespace Module
 {
     class BatchUtil
     {
     public:
+        struct Source
+        {
+            Mesh*         m_mesh         = nullptr;
+            size_t        m_subMeshIndex = 0;
+            MaterialPtr   m_material;
+            AZ::s16       m_sortingLayer = 0;
+            AZ::s16       m_orderInLayer = 0;
+            AZ::u8        m_layer        = 0;
+            AZ::Transform m_worldTM      = AZ::Transform::CreateIdentity();
+        };
+
+        // Merges the sources into batches of the same material, sorting layer, layer and vertex layout. Vertices are
+        // transformed to world space and batches are split to stay within 16 bit indices, quantized positions and
+        // texcoords are stored as floats in the batch.
+        // Sources of meshes with more vertices than `MaxSourceVertexCount` are left out by the caller.
+        static void BuildStaticBatches(AZStd::vector<Source>& sources, AZStd::vector<StaticBatchPtr>& batches);
+
+        static const size_t MaxSourceVertexCount = 0x10000;
+
+        // Appends the index ranges of the visible sub meshes, merging adjacent ones into a single range.
+        template <typename IsVisible>
+        static void CollectVisibleRanges(const StaticBatch& batch, const IsVisible& isVisible, AZStd::vector<StaticBatch::Range>& ranges);
     };
-}
\ No newline at end of file
+
+    template <typename IsVisible>
+    void BatchUtil::CollectVisibleRanges(const StaticBatch& batch, const IsVisible& isVisible, AZStd::vector<StaticBatch::Range>& ranges)
+    {
+        bool isMerging = false;
+        for (const auto& range : batch.m_ranges)
+        {
+            if (!isVisible(range))
+            {
+                isMerging = false;
+                continue;
+            }
+
+            if (isMerging && ranges.back().m_firstIndex + ranges.back().m_indexCount == range.m_firstIndex)
+            {
+                ranges.back().m_indexCount += range.m_indexCount;
+                ranges.back().m_worldBounds.AddAabb(range.m_worldBounds);
+            }
+            else
+            {
+                ranges.push_back(range);
+                isMerging = true;
+            }
+        }
+    }
+}
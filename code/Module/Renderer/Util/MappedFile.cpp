@@ -0,0 +1,151 @@
+#include "Renderer/Util/MappedFile.h"
+
+#include <AzCore/PlatformIncl.h>
+#include <AzCore/IO/FileIO.h>
+#include <AzCore/IO/SystemFile.h>
+#include <AzCore/std/smart_ptr/make_shared.h>
+
+#include <bgfx/bgfx.h>
+
+#if !defined(AZ_PLATFORM_WINDOWS)
+#   include <fcntl.h>
+#   include <sys/mman.h>
+#   include <sys/stat.h>
+#   include <unistd.h>
+#endif
+
+namespace Module
+{
+    namespace
+    {
+        void ReleaseReference(void*, void* userData)
+        {
+            delete static_cast<MappedFilePtr*>(userData);
+        }
+    }
+
+    MappedFile::~MappedFile()
+    {
+        if (!m_isMapped)
+        {
+            return;
+        }
+#if defined(AZ_PLATFORM_WINDOWS)
+        UnmapViewOfFile(m_data);
+        CloseHandle(m_mapping);
+#else
+        munmap(const_cast<char*>(m_data), m_size);
+#endif
+    }
+
+    MappedFilePtr MappedFile::Open(AZ::IO::GenericStream& stream)
+    {
+        auto file = AZStd::make_shared<MappedFile>();
+
+        // streams opened through the file io carry the aliased path, files inside packages or downloaded from the
+        // cdn do not resolve to a local file and are read instead
+        char resolvedPath[AZ_MAX_PATH_LEN] = { 0 };
+        const char* filename = stream.GetFilename();
+        auto* fileIO = AZ::IO::FileIOBase::GetInstance();
+        if (filename != nullptr && filename[0] != '\0' && fileIO != nullptr && fileIO->ResolvePath(filename, resolvedPath, sizeof(resolvedPath)))
+        {
+            if (file->Map(resolvedPath))
+            {
+                return file;
+            }
+        }
+
+        return file->Read(stream) ? file : nullptr;
+    }
+
+    const bgfx::Memory* MappedFile::MakeRef(const MappedFilePtr& file, const void* data, size_t size)
+    {
+        AZ_Assert(static_cast<const char*>(data) >= file->m_data && static_cast<const char*>(data) + size <= file->m_data + file->m_size,
+            "Reference is outside of the file\n");
+        return bgfx::makeRef(data, static_cast<uint32_t>(size), &ReleaseReference, new MappedFilePtr(file));
+    }
+
+    bool MappedFile::Map(const char* path)
+    {
+#if defined(AZ_PLATFORM_WINDOWS)
+        HANDLE handle = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (handle == INVALID_HANDLE_VALUE)
+        {
+            return false;
+        }
+
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(handle, &size) || size.QuadPart == 0)
+        {
+            CloseHandle(handle);
+            return false;
+        }
+
+        // the view keeps the file alive, the file handle is not needed anymore
+        HANDLE mapping = CreateFileMappingA(handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        CloseHandle(handle);
+        if (mapping == nullptr)
+        {
+            return false;
+        }
+
+        void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        if (data == nullptr)
+        {
+            CloseHandle(mapping);
+            return false;
+        }
+
+        m_mapping = mapping;
+        m_data = static_cast<const char*>(data);
+        m_size = static_cast<size_t>(size.QuadPart);
+#else
+        const int fd = open(path, O_RDONLY);
+        if (fd < 0)
+        {
+            return false;
+        }
+
+        struct stat info;
+        if (fstat(fd, &info) != 0 || info.st_size == 0)
+        {
+            close(fd);
+            return false;
+        }
+
+        // the mapping keeps the file alive, the descriptor is not needed anymore
+        void* data = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if (data == MAP_FAILED)
+        {
+            return false;
+        }
+
+        m_data = static_cast<const char*>(data);
+        m_size = static_cast<size_t>(info.st_size);
+#endif
+        m_isMapped = true;
+        return true;
+    }
+
+    bool MappedFile::Read(AZ::IO::GenericStream& stream)
+    {
+        const auto length = stream.GetLength();
+        if (length == 0)
+        {
+            return false;
+        }
+
+        m_buffer.resize(static_cast<size_t>(length));
+        stream.Seek(0, AZ::IO::GenericStream::ST_SEEK_BEGIN);
+        if (stream.Read(length, m_buffer.data()) != length)
+        {
+            m_buffer.clear();
+            return false;
+        }
+
+        m_data = m_buffer.data();
+        m_size = m_buffer.size();
+        return true;
+    }
+}
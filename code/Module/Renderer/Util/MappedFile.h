@@ -0,0 +1,63 @@
+#pragma once
+
+#include <AzCore/Memory/SystemAllocator.h>
+#include <AzCore/std/containers/vector.h>
+#include <AzCore/std/smart_ptr/shared_ptr.h>
+
+namespace bgfx
+{
+    struct Memory;
+}
+
+namespace AZ
+{
+    namespace IO
+    {
+        class GenericStream;
+    }
+}
+
+namespace Module
+{
+    class MappedFile;
+
+    using MappedFilePtr = AZStd::shared_ptr<MappedFile>;
+
+    // Read only view of a whole file. The file is memory mapped when the stream is backed by a file on disk,
+    // otherwise it is read into memory once.
+    class MappedFile
+    {
+    public:
+        AZ_CLASS_ALLOCATOR(MappedFile, AZ::SystemAllocator, 0);
+
+        MappedFile() = default;
+        ~MappedFile();
+
+        // non-copyable
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        static MappedFilePtr Open(AZ::IO::GenericStream& stream);
+
+        // references `size` bytes of the file at `data` without a copy, the reference keeps the file alive until bgfx
+        // has consumed the memory
+        static const bgfx::Memory* MakeRef(const MappedFilePtr& file, const void* data, size_t size);
+
+        const char* GetData() const { return m_data; }
+        size_t GetSize() const { return m_size; }
+        bool IsMapped() const { return m_isMapped; }
+
+    private:
+        bool Map(const char* path);
+        bool Read(AZ::IO::GenericStream& stream);
+
+        const char*         m_data     = nullptr;
+        size_t              m_size     = 0;
+        bool                m_isMapped = false;
+#if defined(AZ_PLATFORM_WINDOWS)
+        void*               m_mapping  = nullptr;
+#endif
+
+        AZStd::vector<char> m_buffer;
+    };
+}
@@ -0,0 +1,222 @@
+#include "Renderer/Util/QuantizeUtil.h"
+
+#include <AzCore/Math/MathUtils.h>
+
+#include <math.h>
+
+namespace Module
+{
+    namespace
+    {
+        const float k_int16Max = 32767.0f;
+
+        float SignNotZero(float value)
+        {
+            return value >= 0.0f ? 1.0f : -1.0f;
+        }
+
+        AZ::s16 PackSnorm16(float value)
+        {
+            return static_cast<AZ::s16>(lroundf(AZ::GetClamp(value, -1.0f, 1.0f) * k_int16Max));
+        }
+
+        // scale and offset of an attribute normalized within bounds, 0 for an empty extent
+        float Normalize(float value, float scale, float offset)
+        {
+            return scale != 0.0f ? (value - offset) / scale : 0.0f;
+        }
+
+        bool IsUnorm8(const bgfx::VertexDecl& decl, bgfx::Attrib::Enum attrib, AZ::u8& num)
+        {
+            bgfx::AttribType::Enum type;
+            bool normalized, asInt;
+            decl.decode(attrib, num, type, normalized, asInt);
+            return type == bgfx::AttribType::Uint8 && normalized && !asInt;
+        }
+
+        // positions use the first two vec4, each texcoord set one vec4 of scale xy and offset zw
+        void GetScaleOffset(const QuantizeUtil::Dequantization& dequantization, bgfx::Attrib::Enum attrib, AZ::u32 component, float& scale, float& offset)
+        {
+            if (attrib == bgfx::Attrib::Position)
+            {
+                scale = dequantization.m_values[component];
+                offset = dequantization.m_values[4 + component];
+            }
+            else
+            {
+                const float* values = dequantization.m_values + (attrib == bgfx::Attrib::TexCoord0 ? 8 : 12);
+                scale = values[component];
+                offset = values[2 + component];
+            }
+        }
+    }
+
+    void QuantizeUtil::Dequantization::SetPositionBounds(const AZ::Aabb& bounds)
+    {
+        (bounds.GetExtents() * 0.5f).StoreToFloat3(m_values);
+        bounds.GetCenter().StoreToFloat3(m_values + 4);
+        m_values[3] = 0.0f;
+        m_values[7] = 0.0f;
+    }
+
+    void QuantizeUtil::Dequantization::SetTexcoordBounds(AZ::u32 set, const AZ::Vector2& min, const AZ::Vector2& max)
+    {
+        AZ_Assert(set < 2, "Only two texcoord sets can be normalized within bounds\n");
+        float* values = m_values + 8 + set * 4;
+        values[0] = (max.GetX() - min.GetX()) * 0.5f;
+        values[1] = (max.GetY() - min.GetY()) * 0.5f;
+        values[2] = (max.GetX() + min.GetX()) * 0.5f;
+        values[3] = (max.GetY() + min.GetY()) * 0.5f;
+    }
+
+    bool QuantizeUtil::IsOctahedral(const bgfx::VertexDecl& decl, bgfx::Attrib::Enum attrib)
+    {
+        if ((attrib != bgfx::Attrib::Normal && attrib != bgfx::Attrib::Tangent) || !decl.has(attrib))
+        {
+            return false;
+        }
+
+        AZ::u8 num;
+        bgfx::AttribType::Enum type;
+        bool normalized, asInt;
+        decl.decode(attrib, num, type, normalized, asInt);
+        return type == bgfx::AttribType::Int16 && num == 2 && normalized;
+    }
+
+    bool QuantizeUtil::IsNormalizedInBounds(const bgfx::VertexDecl& decl, bgfx::Attrib::Enum attrib)
+    {
+        if ((attrib != bgfx::Attrib::Position && attrib != bgfx::Attrib::TexCoord0 && attrib != bgfx::Attrib::TexCoord1) || !decl.has(attrib))
+        {
+            return false;
+        }
+
+        AZ::u8 num;
+        bgfx::AttribType::Enum type;
+        bool normalized, asInt;
+        decl.decode(attrib, num, type, normalized, asInt);
+        return type == bgfx::AttribType::Int16 && normalized;
+    }
+
+    AZ::Vector2 QuantizeUtil::EncodeOctahedral(const AZ::Vector3& direction)
+    {
+        const float x = direction.GetX(), y = direction.GetY(), z = direction.GetZ();
+        const float length = fabsf(x) + fabsf(y) + fabsf(z);
+        if (length <= 0.0f)
+        {
+            return AZ::Vector2(0.0f, 0.0f);
+        }
+
+        const float u = x / length, v = y / length;
+        if (z >= 0.0f)
+        {
+            return AZ::Vector2(u, v);
+        }
+        // the lower half is folded over the diagonals
+        return AZ::Vector2((1.0f - fabsf(v)) * SignNotZero(u), (1.0f - fabsf(u)) * SignNotZero(v));
+    }
+
+    AZ::Vector3 QuantizeUtil::DecodeOctahedral(const AZ::Vector2& encoded)
+    {
+        float x = encoded.GetX(), y = encoded.GetY();
+        const float z = 1.0f - fabsf(x) - fabsf(y);
+        const float fold = AZ::GetMax(-z, 0.0f);
+        x += x >= 0.0f ? -fold : fold;
+        y += y >= 0.0f ? -fold : fold;
+        return AZ::Vector3(x, y, z).GetNormalizedSafe();
+    }
+
+    AZ::Vector2 QuantizeUtil::EncodeTangent(const AZ::Vector4& tangent)
+    {
+        const AZ::Vector2 encoded = EncodeOctahedral(tangent.GetAsVector3());
+
+        // y moves to [0, 1] and never rounds to 0, so its sign survives the quantization
+        const float y = AZ::GetMax((float(encoded.GetY()) + 1.0f) * 0.5f, 1.0f / k_int16Max);
+        return AZ::Vector2(encoded.GetX(), float(tangent.GetW()) < 0.0f ? -y : y);
+    }
+
+    AZ::Vector4 QuantizeUtil::DecodeTangent(const AZ::Vector2& encoded)
+    {
+        const float y = encoded.GetY();
+        const AZ::Vector3 direction = DecodeOctahedral(AZ::Vector2(encoded.GetX(), fabsf(y) * 2.0f - 1.0f));
+        return AZ::Vector4::CreateFromVector3AndFloat(direction, y < 0.0f ? -1.0f : 1.0f);
+    }
+
+    void QuantizeUtil::Unpack(float output[4], bgfx::Attrib::Enum attrib, const bgfx::VertexDecl& decl, const Dequantization& dequantization, const void* vertex)
+    {
+        output[0] = output[1] = output[2] = output[3] = 0.0f;
+
+        const auto* data = reinterpret_cast<const char*>(vertex) + decl.getOffset(attrib);
+        if (IsOctahedral(decl, attrib))
+        {
+            const auto* packed = reinterpret_cast<const AZ::s16*>(data);
+            const AZ::Vector2 encoded(float(packed[0]) / k_int16Max, float(packed[1]) / k_int16Max);
+            if (attrib == bgfx::Attrib::Tangent)
+            {
+                DecodeTangent(encoded).StoreToFloat4(output);
+            }
+            else
+            {
+                DecodeOctahedral(encoded).StoreToFloat3(output);
+            }
+        }
+        else if (IsNormalizedInBounds(decl, attrib))
+        {
+            const auto* packed = reinterpret_cast<const AZ::s16*>(data);
+            const AZ::u32 count = attrib == bgfx::Attrib::Position ? 3 : 2;
+            for (AZ::u32 i = 0; i < count; ++i)
+            {
+                float scale, offset;
+                GetScaleOffset(dequantization, attrib, i, scale, offset);
+                output[i] = float(packed[i]) / k_int16Max * scale + offset;
+            }
+        }
+        else
+        {
+            bgfx::vertexUnpack(output, attrib, decl, vertex);
+        }
+    }
+
+    void QuantizeUtil::Pack(const float input[4], bgfx::Attrib::Enum attrib, const bgfx::VertexDecl& decl, const Dequantization& dequantization, void* vertex)
+    {
+        auto* data = reinterpret_cast<char*>(vertex) + decl.getOffset(attrib);
+        AZ::u8 num;
+        if (IsOctahedral(decl, attrib))
+        {
+            const AZ::Vector2 encoded = attrib == bgfx::Attrib::Tangent
+                ? EncodeTangent(AZ::Vector4::CreateFromFloat4(input))
+                : EncodeOctahedral(AZ::Vector3::CreateFromFloat3(input));
+            auto* packed = reinterpret_cast<AZ::s16*>(data);
+            packed[0] = PackSnorm16(encoded.GetX());
+            packed[1] = PackSnorm16(encoded.GetY());
+        }
+        else if (IsNormalizedInBounds(decl, attrib))
+        {
+            auto* packed = reinterpret_cast<AZ::s16*>(data);
+            const AZ::u32 count = attrib == bgfx::Attrib::Position ? 3 : 2;
+            for (AZ::u32 i = 0; i < count; ++i)
+            {
+                float scale, offset;
+                GetScaleOffset(dequantization, attrib, i, scale, offset);
+                packed[i] = PackSnorm16(Normalize(input[i], scale, offset));
+            }
+            if (attrib == bgfx::Attrib::Position)
+            {
+                packed[3] = 0;
+            }
+        }
+        else if (IsUnorm8(decl, attrib, num))
+        {
+            // bgfx truncates, colors round to the nearest value
+            auto* packed = reinterpret_cast<AZ::u8*>(data);
+            for (AZ::u32 i = 0; i < num; ++i)
+            {
+                packed[i] = static_cast<AZ::u8>(lroundf(AZ::GetClamp(input[i], 0.0f, 1.0f) * 255.0f));
+            }
+        }
+        else
+        {
+            // directions are in [-1, 1], which matters for the 8 bit normals of bgfx
+            bgfx::vertexPack(input, attrib == bgfx::Attrib::Normal || attrib == bgfx::Attrib::Tangent, attrib, decl, vertex);
+        }
+    }
+}
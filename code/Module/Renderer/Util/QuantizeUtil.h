@@ -0,0 +1,60 @@
+#pragma once
+
+#include <AzCore/Math/Aabb.h>
+#include <AzCore/Math/Vector2.h>
+#include <AzCore/Math/Vector4.h>
+
+#include <bgfx/bgfx.h>
+
+namespace Module
+{
+    // Quantized vertex attributes of meshes. The layout of every attribute follows from its vertex declaration:
+    //   Position             4 x Int16, normalized within the bounds of the mesh, w is padding
+    //   Normal               2 x Int16, octahedral
+    //   Tangent              2 x Int16, octahedral, the sign of y is the handedness of the bitangent
+    //   TexCoord0, 1         2 x Int16, normalized within the texcoord bounds of the mesh, or 2 x Half
+    //   Color0               4 x Uint8, normalized
+    // Float attributes of any size are stored as they are.
+    class QuantizeUtil
+    {
+    public:
+        // Scale and offset which turn the normalized positions and texcoords back into mesh space, in the layout of
+        // the vec4 array vertex shaders read as RenderNode::MeshDequantizationUniformName:
+        //   [0] position scale, [1] position offset, [2] texcoord0 scale xy and offset zw, [3] texcoord1
+        // Attributes which are not normalized within bounds keep a scale of 1 and an offset of 0.
+        struct Dequantization
+        {
+            float m_values[16] =
+            {
+                1.0f, 1.0f, 1.0f, 0.0f,
+                0.0f, 0.0f, 0.0f, 0.0f,
+                1.0f, 1.0f, 0.0f, 0.0f,
+                1.0f, 1.0f, 0.0f, 0.0f,
+            };
+
+            void SetPositionBounds(const AZ::Aabb& bounds);
+            void SetTexcoordBounds(AZ::u32 set, const AZ::Vector2& min, const AZ::Vector2& max);
+        };
+
+        static bool IsOctahedral(const bgfx::VertexDecl& decl, bgfx::Attrib::Enum attrib);
+
+        // positions and texcoords normalized within the bounds of the mesh
+        static bool IsNormalizedInBounds(const bgfx::VertexDecl& decl, bgfx::Attrib::Enum attrib);
+
+        // maps a unit vector onto the [-1, 1] square
+        static AZ::Vector2 EncodeOctahedral(const AZ::Vector3& direction);
+        static AZ::Vector3 DecodeOctahedral(const AZ::Vector2& encoded);
+
+        // w of the tangent is the handedness of the bitangent, y loses one bit to keep it
+        static AZ::Vector2 EncodeTangent(const AZ::Vector4& tangent);
+        static AZ::Vector4 DecodeTangent(const AZ::Vector2& encoded);
+
+        // Reads an attribute of the vertex in mesh space: normalized positions and texcoords are scaled back and
+        // octahedral directions decoded, components the attribute does not have are 0.
+        static void Unpack(float output[4], bgfx::Attrib::Enum attrib, const bgfx::VertexDecl& decl, const Dequantization& dequantization, const void* vertex);
+
+        // Writes an attribute of the vertex from mesh space values, rounding to the nearest quantized value. Values
+        // outside of the bounds of the dequantization are clamped to them, directions are expected in [-1, 1].
+        static void Pack(const float input[4], bgfx::Attrib::Enum attrib, const bgfx::VertexDecl& decl, const Dequantization& dequantization, void* vertex);
+    };
+}
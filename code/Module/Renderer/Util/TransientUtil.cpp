@@ -0,0 +1,34 @@
+#include "Renderer/Util/TransientUtil.h"
+
+#include <AzCore/std/parallel/mutex.h>
+#include <AzCore/std/parallel/lock.h>
+
+namespace Module
+{
+    namespace
+    {
+        AZStd::mutex s_transientMutex;
+    }
+
+    bool TransientUtil::AllocBuffers(bgfx::TransientVertexBuffer* vertexBuffer,
+                                     const bgfx::VertexDecl& decl,
+                                     AZ::u32 vertexCount,
+                                     bgfx::TransientIndexBuffer* indexBuffer,
+                                     AZ::u32 indexCount)
+    {
+        AZStd::lock_guard<AZStd::mutex> lock(s_transientMutex);
+        return bgfx::allocTransientBuffers(vertexBuffer, decl, vertexCount, indexBuffer, indexCount);
+    }
+
+    AZ::u32 TransientUtil::AllocInstanceData(bgfx::InstanceDataBuffer* instanceBuffer, AZ::u32 count, uint16_t stride)
+    {
+        AZStd::lock_guard<AZStd::mutex> lock(s_transientMutex);
+
+        const AZ::u32 available = bgfx::getAvailInstanceDataBuffer(count, stride);
+        if (available > 0)
+        {
+            bgfx::allocInstanceDataBuffer(instanceBuffer, available, stride);
+        }
+        return available;
+    }
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <AzCore/base.h>
+
+#include <bgfx/bgfx.h>
+
+namespace Module
+{
+    // Transient buffer allocation which is safe to call from several submission jobs at once. Instance data is
+    // carved from the transient vertex buffer without taking the bgfx resource lock, so every transient
+    // allocation made by the renderer has to go through here.
+    class TransientUtil
+    {
+    public:
+        // allocates both buffers or none of them
+        static bool AllocBuffers(bgfx::TransientVertexBuffer* vertexBuffer,
+                                 const bgfx::VertexDecl& decl,
+                                 AZ::u32 vertexCount,
+                                 bgfx::TransientIndexBuffer* indexBuffer,
+                                 AZ::u32 indexCount);
+
+        // allocates up to `count` instances and returns how many were allocated
+        static AZ::u32 AllocInstanceData(bgfx::InstanceDataBuffer* instanceBuffer, AZ::u32 count, uint16_t stride);
+    };
+}
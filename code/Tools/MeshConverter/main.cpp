@@ -0,0 +1,190 @@
+#include "Renderer/Asset/MeshAsset.h"
+
+#include <AzCore/IO/GenericStreams.h>
+#include <AzCore/IO/SystemFile.h>
+#include <AzCore/Memory/SystemAllocator.h>
+#include <AzCore/Serialization/SerializeContext.h>
+#include <AzCore/Serialization/Util.h>
+
+#include <stdio.h>
+#include <string.h>
+
+// Converts xml meshes into the binary format read by MeshAssetHandler, see Renderer/Asset/MeshFormat.h.
+// Every `name.xml` argument is written to `name.mesh` next to it, Mesh picks the binary file when both exist.
+// The format options override the vertex format stored in the xml for every mesh that follows them.
+namespace
+{
+    // formats given on the command line, -1 keeps the one of the mesh
+    struct FormatOverrides
+    {
+        int m_position = -1;
+        int m_normal = -1;
+        int m_tangent = -1;
+        int m_texcoords = -1;
+        int m_color = -1;
+    };
+
+    // index of the value in the null terminated names, -1 when it is not one of them
+    int FindFormat(const char* value, const char* const* names)
+    {
+        for (int i = 0; names[i] != nullptr; ++i)
+        {
+            if (strcmp(value, names[i]) == 0)
+            {
+                return i;
+            }
+        }
+        return -1;
+    }
+
+    // names in the order of the enum values of the formats
+    const char* const k_positionFormats[] = { "float", "int16", nullptr };
+    const char* const k_directionFormats[] = { "float", "octahedral", nullptr };
+    const char* const k_texcoordFormats[] = { "float", "half", "int16", nullptr };
+    const char* const k_colorFormats[] = { "float", "uint8", nullptr };
+
+    // parses `--option value` into the overrides, returns false when the option or its value is unknown
+    bool ParseFormatOption(const char* option, const char* value, FormatOverrides& overrides)
+    {
+        struct Option
+        {
+            const char* m_name;
+            const char* const* m_formats;
+            int* m_format;
+        };
+        const Option options[] =
+        {
+            { "--positions", k_positionFormats, &overrides.m_position },
+            { "--normals", k_directionFormats, &overrides.m_normal },
+            { "--tangents", k_directionFormats, &overrides.m_tangent },
+            { "--texcoords", k_texcoordFormats, &overrides.m_texcoords },
+            { "--colors", k_colorFormats, &overrides.m_color },
+        };
+
+        for (const auto& entry : options)
+        {
+            if (strcmp(option, entry.m_name) == 0)
+            {
+                *entry.m_format = value != nullptr ? FindFormat(value, entry.m_formats) : -1;
+                return *entry.m_format >= 0;
+            }
+        }
+        return false;
+    }
+
+    void ApplyFormatOverrides(const FormatOverrides& overrides, Module::MeshAsset::VertexFormat& format)
+    {
+        if (overrides.m_position >= 0)
+        {
+            format.m_position = static_cast<Module::PositionFormat>(overrides.m_position);
+        }
+        if (overrides.m_normal >= 0)
+        {
+            format.m_normal = static_cast<Module::DirectionFormat>(overrides.m_normal);
+        }
+        if (overrides.m_tangent >= 0)
+        {
+            format.m_tangent = static_cast<Module::DirectionFormat>(overrides.m_tangent);
+        }
+        if (overrides.m_texcoords >= 0)
+        {
+            format.m_texcoord0 = format.m_texcoord1 = static_cast<Module::TexcoordFormat>(overrides.m_texcoords);
+        }
+        if (overrides.m_color >= 0)
+        {
+            format.m_color = static_cast<Module::ColorFormat>(overrides.m_color);
+        }
+    }
+
+    bool ConvertMesh(const AZStd::string& inputPath, const FormatOverrides& overrides, AZ::SerializeContext& serializeContext)
+    {
+        AZStd::string outputPath = inputPath;
+        const auto extension = outputPath.find_last_of('.');
+        if (extension != AZStd::string::npos && outputPath.find_first_of("/\\", extension) == AZStd::string::npos)
+        {
+            outputPath.erase(extension);
+        }
+        outputPath += ".mesh";
+
+        AZStd::vector<char> source(static_cast<size_t>(AZ::IO::SystemFile::Length(inputPath.c_str())));
+        if (source.empty() || AZ::IO::SystemFile::Read(inputPath.c_str(), source.data(), source.size()) != source.size())
+        {
+            printf("%s: can not read the file\n", inputPath.c_str());
+            return false;
+        }
+
+        Module::MeshAsset meshAsset;
+        AZ::IO::MemoryStream stream(source.data(), source.size());
+        if (!AZ::Utils::LoadObjectFromStreamInPlace(stream, meshAsset, &serializeContext))
+        {
+            printf("%s: not a mesh\n", inputPath.c_str());
+            return false;
+        }
+
+        ApplyFormatOverrides(overrides, meshAsset.GetVertexFormat());
+
+        // the renderer type only matters for the hash of the declaration, the binary file stores the attributes
+        meshAsset.BuildVertexBuffer(bgfx::RendererType::Noop);
+
+        AZStd::vector<char> binary;
+        if (!meshAsset.SaveBinary(binary))
+        {
+            printf("%s: the mesh has no vertices\n", inputPath.c_str());
+            return false;
+        }
+
+        AZ::IO::SystemFile file;
+        if (!file.Open(outputPath.c_str(), AZ::IO::SystemFile::SF_OPEN_WRITE_ONLY | AZ::IO::SystemFile::SF_OPEN_CREATE | AZ::IO::SystemFile::SF_OPEN_CREATE_PATH)
+            || file.Write(binary.data(), binary.size()) != binary.size())
+        {
+            printf("%s: can not write the file\n", outputPath.c_str());
+            return false;
+        }
+
+        printf("%s -> %s (%u bytes)\n", inputPath.c_str(), outputPath.c_str(), static_cast<AZ::u32>(binary.size()));
+        return true;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc < 2)
+    {
+        printf("usage: MeshConverter [options] <mesh.xml>...\n"
+               "  --positions float|int16\n"
+               "  --normals float|octahedral\n"
+               "  --tangents float|octahedral\n"
+               "  --texcoords float|half|int16\n"
+               "  --colors float|uint8\n");
+        return 1;
+    }
+
+    AZ::AllocatorInstance<AZ::SystemAllocator>::Create();
+
+    int failures = 0;
+    {
+        AZ::SerializeContext serializeContext;
+        Module::MeshAsset::Reflect(&serializeContext);
+
+        FormatOverrides overrides;
+        for (int i = 1; i < argc; ++i)
+        {
+            if (strncmp(argv[i], "--", 2) == 0)
+            {
+                const char* option = argv[i];
+                const char* value = i + 1 < argc ? argv[++i] : nullptr;
+                if (!ParseFormatOption(option, value, overrides))
+                {
+                    printf("%s: unknown option or format\n", option);
+                    ++failures;
+                }
+                continue;
+            }
+            failures += ConvertMesh(argv[i], overrides, serializeContext) ? 0 : 1;
+        }
+    }
+
+    AZ::AllocatorInstance<AZ::SystemAllocator>::Destroy();
+
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,634 @@
+#include "Renderer/Asset/TextureAsset.h"
+
+#include <AzCore/IO/LocalFileIO.h>
+#include <AzCore/IO/SystemFile.h>
+#include <AzCore/Memory/SystemAllocator.h>
+#include <AzCore/Serialization/SerializeContext.h>
+#include <AzCore/Serialization/Util.h>
+#include <AzCore/std/algorithm.h>
+#include <AzCore/std/sort.h>
+
+#include <bimg/decode.h>
+#include <bx/allocator.h>
+#include <bx/error.h>
+#include <bx/file.h>
+
+#include <float.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+// Packs the png sprites below a directory into one atlas with MaxRects (best short side fit). Writes `atlas.png` and
+// `atlas.xml`, the TextureAsset with one SpriteData per sprite named after its path relative to the directory,
+// TextureCooker turns both into the texture variants. Transparent borders are trimmed, with --tight the sprites get
+// a convex mesh around their opaque pixels instead of a quad to cut the overdraw.
+namespace
+{
+    const AZ::u32 k_maxTightVertices = 8;     // more vertices cost more than the overdraw they save
+    const float   k_minTightSaving   = 0.1f;  // keep the quad when the mesh covers nearly all of it
+
+    struct Options
+    {
+        AZ::u32 m_maxSize       = 2048;
+        AZ::u32 m_padding       = 2;
+        float   m_pixelsToUnits = 100.0f;
+        bool    m_isTight       = false;
+    };
+
+    struct Rect
+    {
+        AZ::u32 m_x      = 0;
+        AZ::u32 m_y      = 0;
+        AZ::u32 m_width  = 0;
+        AZ::u32 m_height = 0;
+    };
+
+    struct Point
+    {
+        float m_x;
+        float m_y;
+    };
+
+    struct SourceSprite
+    {
+        AZStd::string          m_name;
+        AZStd::vector<AZ::u32> m_pixels;      // rgba8 of the trimmed image
+        AZ::u32                m_width  = 0;  // untrimmed size
+        AZ::u32                m_height = 0;
+        Rect                   m_trim;        // opaque part within the untrimmed image
+        Rect                   m_packed;      // trimmed image plus padding in the atlas
+    };
+
+    // MaxRects bin packer, keeps the maximal free rectangles and places every rectangle in the free one which leaves
+    // the shortest side over
+    class MaxRects
+    {
+    public:
+        MaxRects(AZ::u32 width, AZ::u32 height)
+        {
+            Rect bin;
+            bin.m_width = width;
+            bin.m_height = height;
+            m_free.push_back(bin);
+        }
+
+        bool Insert(AZ::u32 width, AZ::u32 height, Rect& placed)
+        {
+            AZ::u32 bestShortSide = UINT32_MAX;
+            AZ::u32 bestLongSide = UINT32_MAX;
+            for (const auto& free : m_free)
+            {
+                if (free.m_width < width || free.m_height < height)
+                {
+                    continue;
+                }
+                const AZ::u32 shortSide = AZ::GetMin(free.m_width - width, free.m_height - height);
+                const AZ::u32 longSide = AZ::GetMax(free.m_width - width, free.m_height - height);
+                if (shortSide < bestShortSide || (shortSide == bestShortSide && longSide < bestLongSide))
+                {
+                    placed.m_x = free.m_x;
+                    placed.m_y = free.m_y;
+                    placed.m_width = width;
+                    placed.m_height = height;
+                    bestShortSide = shortSide;
+                    bestLongSide = longSide;
+                }
+            }
+            if (bestShortSide == UINT32_MAX)
+            {
+                return false;
+            }
+
+            Split(placed);
+            return true;
+        }
+
+    private:
+        // replaces the free rectangles overlapping used by their maximal remainders
+        void Split(const Rect& used)
+        {
+            AZStd::vector<Rect> result;
+            for (const auto& free : m_free)
+            {
+                if (used.m_x >= free.m_x + free.m_width || used.m_x + used.m_width <= free.m_x
+                    || used.m_y >= free.m_y + free.m_height || used.m_y + used.m_height <= free.m_y)
+                {
+                    result.push_back(free);
+                    continue;
+                }
+
+                if (used.m_x > free.m_x)
+                {
+                    Rect left = free;
+                    left.m_width = used.m_x - free.m_x;
+                    result.push_back(left);
+                }
+                if (used.m_x + used.m_width < free.m_x + free.m_width)
+                {
+                    Rect right = free;
+                    right.m_x = used.m_x + used.m_width;
+                    right.m_width = free.m_x + free.m_width - right.m_x;
+                    result.push_back(right);
+                }
+                if (used.m_y > free.m_y)
+                {
+                    Rect top = free;
+                    top.m_height = used.m_y - free.m_y;
+                    result.push_back(top);
+                }
+                if (used.m_y + used.m_height < free.m_y + free.m_height)
+                {
+                    Rect bottom = free;
+                    bottom.m_y = used.m_y + used.m_height;
+                    bottom.m_height = free.m_y + free.m_height - bottom.m_y;
+                    result.push_back(bottom);
+                }
+            }
+
+            // drop the rectangles contained in another one
+            m_free.clear();
+            for (size_t i = 0; i < result.size(); ++i)
+            {
+                bool isContained = false;
+                for (size_t j = 0; j < result.size() && !isContained; ++j)
+                {
+                    const Rect& a = result[i];
+                    const Rect& b = result[j];
+                    isContained = i != j && a.m_x >= b.m_x && a.m_y >= b.m_y
+                        && a.m_x + a.m_width <= b.m_x + b.m_width && a.m_y + a.m_height <= b.m_y + b.m_height
+                        && (j < i || a.m_x != b.m_x || a.m_y != b.m_y || a.m_width != b.m_width || a.m_height != b.m_height);
+                }
+                if (!isContained)
+                {
+                    m_free.push_back(result[i]);
+                }
+            }
+        }
+
+        AZStd::vector<Rect> m_free;
+    };
+
+    AZ::u8 GetAlpha(AZ::u32 pixel)
+    {
+        return static_cast<AZ::u8>(pixel >> 24);
+    }
+
+    // collects the png files below directory, with their path relative to the sprite directory without extension
+    void FindSprites(AZ::IO::LocalFileIO& fileIO, const AZStd::string& directory, const AZStd::string& relativeDirectory,
+                     AZStd::vector<AZStd::pair<AZStd::string, AZStd::string>>& sprites)
+    {
+        fileIO.FindFiles(directory.c_str(), "*", [&](const char* path)
+        {
+            const char* name = strrchr(path, '/');
+            name = name ? name + 1 : path;
+            if (strcmp(name, ".") == 0 || strcmp(name, "..") == 0)
+            {
+                return true;
+            }
+
+            if (fileIO.IsDirectory(path))
+            {
+                FindSprites(fileIO, path, relativeDirectory + name + "/", sprites);
+                return true;
+            }
+
+            const size_t length = strlen(name);
+            if (length > 4 && azstricmp(name + length - 4, ".png") == 0)
+            {
+                sprites.push_back(AZStd::make_pair(AZStd::string(path), relativeDirectory + AZStd::string(name, length - 4)));
+            }
+            return true;
+        });
+    }
+
+    // decodes the png and trims the fully transparent rows and columns around it
+    bool LoadSprite(const AZStd::string& path, SourceSprite& sprite)
+    {
+        AZStd::vector<char> png(static_cast<size_t>(AZ::IO::SystemFile::Length(path.c_str())));
+        if (png.empty() || AZ::IO::SystemFile::Read(path.c_str(), png.data(), png.size()) != png.size())
+        {
+            return false;
+        }
+
+        bx::DefaultAllocator allocator;
+        bx::Error error;
+        bimg::ImageContainer* image = bimg::imageParse(&allocator, png.data(), static_cast<uint32_t>(png.size()), bimg::TextureFormat::RGBA8, &error);
+        if (image == nullptr)
+        {
+            return false;
+        }
+
+        sprite.m_width = image->m_width;
+        sprite.m_height = image->m_height;
+        const auto pixels = static_cast<const AZ::u32*>(image->m_data);
+
+        AZ::u32 minX = sprite.m_width, minY = sprite.m_height, maxX = 0, maxY = 0;
+        for (AZ::u32 y = 0; y < sprite.m_height; ++y)
+        {
+            for (AZ::u32 x = 0; x < sprite.m_width; ++x)
+            {
+                if (GetAlpha(pixels[y * sprite.m_width + x]) != 0)
+                {
+                    minX = AZ::GetMin(minX, x);
+                    minY = AZ::GetMin(minY, y);
+                    maxX = AZ::GetMax(maxX, x + 1);
+                    maxY = AZ::GetMax(maxY, y + 1);
+                }
+            }
+        }
+        if (minX >= maxX)
+        {
+            // fully transparent, keep a single pixel so the sprite still exists
+            minX = minY = 0;
+            maxX = maxY = 1;
+        }
+
+        sprite.m_trim.m_x = minX;
+        sprite.m_trim.m_y = minY;
+        sprite.m_trim.m_width = maxX - minX;
+        sprite.m_trim.m_height = maxY - minY;
+        sprite.m_pixels.resize(sprite.m_trim.m_width * sprite.m_trim.m_height);
+        for (AZ::u32 y = 0; y < sprite.m_trim.m_height; ++y)
+        {
+            memcpy(&sprite.m_pixels[y * sprite.m_trim.m_width], &pixels[(minY + y) * sprite.m_width + minX], sprite.m_trim.m_width * sizeof(AZ::u32));
+        }
+
+        bimg::imageFree(image);
+        return true;
+    }
+
+    // packs into the smallest power of two atlas, growing the shorter side first
+    bool Pack(AZStd::vector<SourceSprite>& sprites, const Options& options, AZ::u32& atlasWidth, AZ::u32& atlasHeight)
+    {
+        // tall and large sprites first, they are the hardest to place
+        AZStd::vector<SourceSprite*> order;
+        AZ::u64 area = 0;
+        for (auto& sprite : sprites)
+        {
+            order.push_back(&sprite);
+            area += AZ::u64(sprite.m_trim.m_width + options.m_padding * 2) * (sprite.m_trim.m_height + options.m_padding * 2);
+        }
+        AZStd::sort(order.begin(), order.end(), [](const SourceSprite* a, const SourceSprite* b)
+        {
+            return AZ::GetMax(a->m_trim.m_width, a->m_trim.m_height) > AZ::GetMax(b->m_trim.m_width, b->m_trim.m_height);
+        });
+
+        atlasWidth = atlasHeight = 64;
+        while (AZ::u64(atlasWidth) * atlasHeight < area)
+        {
+            (atlasWidth <= atlasHeight ? atlasWidth : atlasHeight) *= 2;
+        }
+
+        while (atlasWidth <= options.m_maxSize && atlasHeight <= options.m_maxSize)
+        {
+            MaxRects bin(atlasWidth, atlasHeight);
+            bool isPacked = true;
+            for (auto sprite : order)
+            {
+                isPacked = isPacked && bin.Insert(sprite->m_trim.m_width + options.m_padding * 2, sprite->m_trim.m_height + options.m_padding * 2, sprite->m_packed);
+            }
+            if (isPacked)
+            {
+                return true;
+            }
+            (atlasWidth <= atlasHeight ? atlasWidth : atlasHeight) *= 2;
+        }
+        return false;
+    }
+
+    // copies the sprite into the atlas and extrudes its edges into the padding, bilinear filtering at the sprite
+    // border then does not pick up the neighbours
+    void Blit(const SourceSprite& sprite, AZ::u32 padding, AZStd::vector<AZ::u32>& atlas, AZ::u32 atlasWidth)
+    {
+        const Rect& packed = sprite.m_packed;
+        for (AZ::u32 y = 0; y < packed.m_height; ++y)
+        {
+            const AZ::u32 sourceY = AZ::GetClamp<AZ::s32>(AZ::s32(y) - AZ::s32(padding), 0, AZ::s32(sprite.m_trim.m_height) - 1);
+            for (AZ::u32 x = 0; x < packed.m_width; ++x)
+            {
+                const AZ::u32 sourceX = AZ::GetClamp<AZ::s32>(AZ::s32(x) - AZ::s32(padding), 0, AZ::s32(sprite.m_trim.m_width) - 1);
+                atlas[(packed.m_y + y) * atlasWidth + packed.m_x + x] = sprite.m_pixels[sourceY * sprite.m_trim.m_width + sourceX];
+            }
+        }
+    }
+
+    float Cross(const Point& o, const Point& a, const Point& b)
+    {
+        return (a.m_x - o.m_x) * (b.m_y - o.m_y) - (a.m_y - o.m_y) * (b.m_x - o.m_x);
+    }
+
+    // positive when counter clockwise with y up
+    float SignedArea(const AZStd::vector<Point>& polygon)
+    {
+        float area = 0.0f;
+        for (size_t i = 0; i < polygon.size(); ++i)
+        {
+            const Point& a = polygon[i];
+            const Point& b = polygon[(i + 1) % polygon.size()];
+            area += a.m_x * b.m_y - b.m_x * a.m_y;
+        }
+        return area * 0.5f;
+    }
+
+    float Area(const AZStd::vector<Point>& polygon)
+    {
+        return fabsf(SignedArea(polygon));
+    }
+
+    // convex hull of the opaque pixels of the trimmed image
+    AZStd::vector<Point> BuildHull(const SourceSprite& sprite)
+    {
+        // the outer corners of the first and last opaque pixel of every row are enough
+        AZStd::vector<Point> points;
+        const Rect& trim = sprite.m_trim;
+        for (AZ::u32 y = 0; y < trim.m_height; ++y)
+        {
+            AZ::s32 first = -1, last = -1;
+            for (AZ::u32 x = 0; x < trim.m_width; ++x)
+            {
+                if (GetAlpha(sprite.m_pixels[y * trim.m_width + x]) != 0)
+                {
+                    first = first < 0 ? AZ::s32(x) : first;
+                    last = AZ::s32(x);
+                }
+            }
+            if (first >= 0)
+            {
+                points.push_back({ float(first), float(y) });
+                points.push_back({ float(first), float(y + 1) });
+                points.push_back({ float(last + 1), float(y) });
+                points.push_back({ float(last + 1), float(y + 1) });
+            }
+        }
+
+        // a fully transparent sprite keeps a 1x1 trim without opaque pixels, it is drawn as a quad
+        if (points.size() < 3)
+        {
+            return AZStd::vector<Point>();
+        }
+
+        // monotone chain
+        AZStd::sort(points.begin(), points.end(), [](const Point& a, const Point& b)
+        {
+            return a.m_x < b.m_x || (a.m_x == b.m_x && a.m_y < b.m_y);
+        });
+
+        AZStd::vector<Point> hull(points.size() * 2);
+        size_t count = 0;
+        for (size_t i = 0; i < points.size(); ++i)
+        {
+            while (count >= 2 && Cross(hull[count - 2], hull[count - 1], points[i]) <= 0.0f)
+            {
+                --count;
+            }
+            hull[count++] = points[i];
+        }
+        for (size_t i = points.size() - 1, lower = count + 1; i > 0; --i)
+        {
+            while (count >= lower && Cross(hull[count - 2], hull[count - 1], points[i - 1]) <= 0.0f)
+            {
+                --count;
+            }
+            hull[count++] = points[i - 1];
+        }
+        hull.resize(count > 1 ? count - 1 : count);
+        return hull;
+    }
+
+    // removes hull edges by extending their neighbours until they meet, picking the edge which adds the least area
+    // and keeping the polygon inside the trimmed rectangle, the result still covers every opaque pixel
+    void SimplifyHull(AZStd::vector<Point>& hull, const Rect& trim)
+    {
+        while (hull.size() > k_maxTightVertices)
+        {
+            const size_t count = hull.size();
+            size_t bestEdge = count;
+            float bestArea = FLT_MAX;
+            Point bestPoint = {};
+            for (size_t i = 0; i < count; ++i)
+            {
+                const Point& a = hull[(i + count - 1) % count];
+                const Point& b = hull[i];
+                const Point& c = hull[(i + 1) % count];
+                const Point& d = hull[(i + 2) % count];
+
+                // intersection of the lines a-b and d-c beyond b and c
+                const float denominator = (b.m_x - a.m_x) * (c.m_y - d.m_y) - (b.m_y - a.m_y) * (c.m_x - d.m_x);
+                if (fabsf(denominator) < 1e-6f)
+                {
+                    continue;
+                }
+                const float t = ((d.m_x - a.m_x) * (c.m_y - d.m_y) - (d.m_y - a.m_y) * (c.m_x - d.m_x)) / denominator;
+                if (t < 1.0f)
+                {
+                    continue;
+                }
+
+                const Point point = { a.m_x + (b.m_x - a.m_x) * t, a.m_y + (b.m_y - a.m_y) * t };
+                if (point.m_x < 0.0f || point.m_y < 0.0f || point.m_x > float(trim.m_width) || point.m_y > float(trim.m_height))
+                {
+                    continue;
+                }
+
+                const float area = fabsf(Cross(b, point, c)) * 0.5f;
+                if (area < bestArea)
+                {
+                    bestArea = area;
+                    bestEdge = i;
+                    bestPoint = point;
+                }
+            }
+            if (bestEdge == count)
+            {
+                break;
+            }
+
+            hull[bestEdge] = bestPoint;
+            hull.erase(hull.begin() + (bestEdge + 1) % count);
+        }
+    }
+
+    Module::TextureAsset::SpriteData BuildSpriteData(const SourceSprite& sprite, const Options& options, AZ::u32 atlasWidth, AZ::u32 atlasHeight)
+    {
+        const Rect& trim = sprite.m_trim;
+
+        AZStd::vector<Point> polygon;
+        if (options.m_isTight)
+        {
+            polygon = BuildHull(sprite);
+            SimplifyHull(polygon, trim);
+            if (polygon.size() < 3 || Area(polygon) > float(trim.m_width * trim.m_height) * (1.0f - k_minTightSaving))
+            {
+                polygon.clear();
+            }
+        }
+        if (polygon.empty())
+        {
+            polygon = { { 0.0f, 0.0f }, { 0.0f, float(trim.m_height) }, { float(trim.m_width), float(trim.m_height) }, { float(trim.m_width), 0.0f } };
+        }
+
+        Module::TextureAsset::SpriteData spriteData;
+        spriteData.m_name = sprite.m_name;
+        spriteData.m_pivot = AZ::Vector2(0.5f, 0.5f);
+        spriteData.m_pivotType = Module::SpritePivot::Center;
+        spriteData.m_border = AZ::Vector4::CreateZero();
+        spriteData.m_size = AZ::Vector4(float(sprite.m_packed.m_x + options.m_padding), float(sprite.m_packed.m_y + options.m_padding),
+                                        float(trim.m_width), float(trim.m_height));
+
+        // image rows go down and sprite positions go up, which mirrors the winding
+        if (SignedArea(polygon) > 0.0f)
+        {
+            AZStd::reverse(polygon.begin(), polygon.end());
+        }
+
+        const float pivotX = float(sprite.m_width) * 0.5f;
+        const float pivotY = float(sprite.m_height) * 0.5f;
+        for (const auto& point : polygon)
+        {
+            const float x = float(trim.m_x) + point.m_x;
+            const float y = float(trim.m_y) + point.m_y;
+            spriteData.m_positions.push_back(AZ::Vector3(x - pivotX, float(sprite.m_height) - y - pivotY, 0.0f));
+            spriteData.m_texcoords.push_back(AZ::Vector2((spriteData.m_size.GetX() + point.m_x) / float(atlasWidth),
+                                                         (spriteData.m_size.GetY() + point.m_y) / float(atlasHeight)));
+        }
+
+        // a fan, the polygon is convex and counter clockwise with y up
+        for (AZ::u16 i = 1; i + 1 < polygon.size(); ++i)
+        {
+            spriteData.m_indices.push_back(0);
+            spriteData.m_indices.push_back(i);
+            spriteData.m_indices.push_back(i + 1);
+        }
+        return spriteData;
+    }
+
+    bool ParseOptions(int argc, char* argv[], Options& options)
+    {
+        for (int i = 3; i < argc; ++i)
+        {
+            if (strcmp(argv[i], "--tight") == 0)
+            {
+                options.m_isTight = true;
+            }
+            else if (strcmp(argv[i], "--max-size") == 0 && i + 1 < argc)
+            {
+                options.m_maxSize = static_cast<AZ::u32>(atoi(argv[++i]));
+            }
+            else if (strcmp(argv[i], "--padding") == 0 && i + 1 < argc)
+            {
+                options.m_padding = static_cast<AZ::u32>(atoi(argv[++i]));
+            }
+            else if (strcmp(argv[i], "--pixels-to-units") == 0 && i + 1 < argc)
+            {
+                options.m_pixelsToUnits = static_cast<float>(atof(argv[++i]));
+            }
+            else
+            {
+                return false;
+            }
+        }
+        return options.m_maxSize > 0 && options.m_pixelsToUnits > 0.0f;
+    }
+
+    bool PackAtlas(const AZStd::string& spriteDirectory, const AZStd::string& atlasPath, const Options& options, AZ::SerializeContext& serializeContext)
+    {
+        AZ::IO::LocalFileIO fileIO;
+        AZStd::vector<AZStd::pair<AZStd::string, AZStd::string>> files;
+        FindSprites(fileIO, spriteDirectory, "", files);
+        if (files.empty())
+        {
+            printf("%s: no png sprites\n", spriteDirectory.c_str());
+            return false;
+        }
+
+        AZStd::vector<SourceSprite> sprites(files.size());
+        for (size_t i = 0; i < files.size(); ++i)
+        {
+            sprites[i].m_name = files[i].second;
+            if (!LoadSprite(files[i].first, sprites[i]))
+            {
+                printf("%s: can not decode the image\n", files[i].first.c_str());
+                return false;
+            }
+        }
+
+        AZ::u32 atlasWidth = 0;
+        AZ::u32 atlasHeight = 0;
+        if (!Pack(sprites, options, atlasWidth, atlasHeight))
+        {
+            printf("%s: the sprites do not fit into %ux%u\n", spriteDirectory.c_str(), options.m_maxSize, options.m_maxSize);
+            return false;
+        }
+
+        AZStd::vector<AZ::u32> atlas(atlasWidth * atlasHeight, 0);
+        AZStd::vector<Module::TextureAsset::SpriteData> spriteData;
+
+        AZ::u64 quadArea = 0;
+        AZ::u64 meshArea = 0;
+        for (const auto& sprite : sprites)
+        {
+            Blit(sprite, options.m_padding, atlas, atlasWidth);
+            spriteData.push_back(BuildSpriteData(sprite, options, atlasWidth, atlasHeight));
+
+            AZStd::vector<Point> polygon;
+            for (const auto& position : spriteData.back().m_positions)
+            {
+                polygon.push_back({ position.GetX(), position.GetY() });
+            }
+            quadArea += AZ::u64(sprite.m_trim.m_width) * sprite.m_trim.m_height;
+            meshArea += static_cast<AZ::u64>(Area(polygon));
+        }
+
+        Module::TextureAsset textureAsset;
+        textureAsset.SetSprites(AZStd::move(spriteData));
+        textureAsset.SetPixelsToUnits(options.m_pixelsToUnits);
+        textureAsset.SetWrapMode(Module::TextureWrapMode::Clamp, Module::TextureWrapMode::Clamp);
+        textureAsset.SetMeshType(options.m_isTight ? Module::SpriteMeshType::Tight : Module::SpriteMeshType::FullRect);
+
+        bx::FileWriter writer;
+        bx::Error error;
+        const AZStd::string pngPath = atlasPath + ".png";
+        if (!bx::open(&writer, pngPath.c_str(), false, &error))
+        {
+            printf("%s: can not write the file\n", pngPath.c_str());
+            return false;
+        }
+        bimg::imageWritePng(&writer, atlasWidth, atlasHeight, atlasWidth * 4, atlas.data(), bimg::TextureFormat::RGBA8, false, &error);
+        bx::close(&writer);
+
+        const AZStd::string xmlPath = atlasPath + ".xml";
+        if (!error.isOk() || !AZ::Utils::SaveObjectToFile(xmlPath, AZ::ObjectStream::ST_XML, &textureAsset, &serializeContext))
+        {
+            printf("%s: can not write the atlas\n", atlasPath.c_str());
+            return false;
+        }
+
+        printf("%u sprites -> %s.{png,xml} (%ux%u), mesh covers %.0f%% of the trimmed quads\n", static_cast<AZ::u32>(sprites.size()),
+               atlasPath.c_str(), atlasWidth, atlasHeight, quadArea ? 100.0 * double(meshArea) / double(quadArea) : 100.0);
+        return true;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    Options options;
+    if (argc < 3 || !ParseOptions(argc, argv, options))
+    {
+        printf("usage: SpritePacker <sprite directory> <atlas path without extension> [--tight] [--max-size 2048] [--padding 2] [--pixels-to-units 100]\n");
+        return 1;
+    }
+
+    AZ::AllocatorInstance<AZ::SystemAllocator>::Create();
+
+    bool succeeded = false;
+    {
+        AZ::SerializeContext serializeContext;
+        Module::TextureAsset::Reflect(&serializeContext);
+
+        succeeded = PackAtlas(argv[1], argv[2], options, serializeContext);
+    }
+
+    AZ::AllocatorInstance<AZ::SystemAllocator>::Destroy();
+
+    return succeeded ? 0 : 1;
+}
@@ -0,0 +1,373 @@
+#include "Renderer/Asset/TextureAsset.h"
+
+#include <AzCore/IO/ByteContainerStream.h>
+#include <AzCore/IO/GenericStreams.h>
+#include <AzCore/IO/LocalFileIO.h>
+#include <AzCore/IO/SystemFile.h>
+#include <AzCore/Jobs/JobCompletion.h>
+#include <AzCore/Jobs/JobContext.h>
+#include <AzCore/Jobs/JobFunction.h>
+#include <AzCore/Jobs/JobManager.h>
+#include <AzCore/Math/Sha1.h>
+#include <AzCore/Memory/PoolAllocator.h>
+#include <AzCore/Memory/SystemAllocator.h>
+#include <AzCore/Serialization/SerializeContext.h>
+#include <AzCore/Serialization/Util.h>
+#include <AzCore/std/parallel/atomic.h>
+#include <AzCore/std/parallel/thread.h>
+
+#include <bimg/decode.h>
+#include <bimg/encode.h>
+#include <bx/allocator.h>
+#include <bx/error.h>
+#include <bx/readerwriter.h>
+
+#include <stdio.h>
+
+// Cooks png textures into the compressed variants RendererSystemComponent::GetTexture picks from: `name.dds` (BC3),
+// `name.pvr` (PVRTC 4bpp) and `name.ktx` (ETC1), each with a full mip chain and followed by the serialized
+// TextureAsset read by TextureAssetHandler. Sprite and sampler settings come from an optional `name.xml` next to the
+// png, a TextureAsset saved as xml. Every png below the input directory is cooked on the job manager, a texture whose
+// png, xml and cooker version hash to the digest stored in `name.cook` is skipped.
+namespace
+{
+    // bump when the output changes for the same input
+    const char* k_cookerVersion = "TextureCooker 1";
+
+    struct Variant
+    {
+        const char*               m_extension;
+        bimg::TextureFormat::Enum m_format;
+        bool                      m_isPowerOfTwoSquare; // pvrtc only compresses square power of two images
+    };
+
+    // etc1 has no alpha channel, it is what GetTexture loads on devices with neither bc3 nor pvrtc
+    const Variant k_variants[] =
+    {
+        { "dds", bimg::TextureFormat::BC3,    false },
+        { "pvr", bimg::TextureFormat::PTC14A, true  },
+        { "ktx", bimg::TextureFormat::ETC1,   false },
+    };
+
+    enum class CookResult
+    {
+        Cooked,
+        UpToDate,
+        Failed,
+    };
+
+    struct CookContext
+    {
+        AZStd::string         m_inputDirectory;
+        AZStd::string         m_outputDirectory;
+        AZ::SerializeContext* m_serializeContext = nullptr;
+    };
+
+    bool ReadFile(const AZStd::string& path, AZStd::vector<char>& data)
+    {
+        data.resize(static_cast<size_t>(AZ::IO::SystemFile::Length(path.c_str())));
+        return !data.empty() && AZ::IO::SystemFile::Read(path.c_str(), data.data(), data.size()) == data.size();
+    }
+
+    bool WriteFile(const AZStd::string& path, const void* data, size_t size)
+    {
+        AZ::IO::SystemFile file;
+        return file.Open(path.c_str(), AZ::IO::SystemFile::SF_OPEN_WRITE_ONLY | AZ::IO::SystemFile::SF_OPEN_CREATE | AZ::IO::SystemFile::SF_OPEN_CREATE_PATH)
+            && file.Write(data, size) == size;
+    }
+
+    // collects the png files below directory, as paths relative to the input directory without the extension
+    void FindTextures(AZ::IO::LocalFileIO& fileIO, const AZStd::string& directory, const AZStd::string& relativeDirectory, AZStd::vector<AZStd::string>& textures)
+    {
+        fileIO.FindFiles(directory.c_str(), "*", [&](const char* path)
+        {
+            const char* name = strrchr(path, '/');
+            name = name ? name + 1 : path;
+            if (strcmp(name, ".") == 0 || strcmp(name, "..") == 0)
+            {
+                return true;
+            }
+
+            if (fileIO.IsDirectory(path))
+            {
+                FindTextures(fileIO, path, relativeDirectory + name + "/", textures);
+                return true;
+            }
+
+            const size_t length = strlen(name);
+            if (length > 4 && azstricmp(name + length - 4, ".png") == 0)
+            {
+                textures.push_back(relativeDirectory + AZStd::string(name, length - 4));
+            }
+            return true;
+        });
+    }
+
+    AZStd::string HashInputs(const AZStd::vector<char>& png, const AZStd::vector<char>& metadata)
+    {
+        AZ::Sha1 sha1;
+        sha1.ProcessBytes(k_cookerVersion, strlen(k_cookerVersion));
+        sha1.ProcessBytes(png.data(), png.size());
+        sha1.ProcessBytes(metadata.data(), metadata.size());
+
+        AZ::u32 digest[5];
+        sha1.GetDigest(digest);
+        return AZStd::string::format("%08x%08x%08x%08x%08x", digest[0], digest[1], digest[2], digest[3], digest[4]);
+    }
+
+    // scales the image, the sprite texcoords are normalized and stay valid
+    bimg::ImageContainer* Resize(bx::AllocatorI* allocator, const bimg::ImageContainer& image, uint32_t width, uint32_t height)
+    {
+        bimg::ImageContainer* source = bimg::imageConvert(allocator, bimg::TextureFormat::RGBA32F, image);
+        bimg::ImageContainer* scaled = bimg::imageAlloc(allocator, bimg::TextureFormat::RGBA32F, uint16_t(width), uint16_t(height), 1, 1, false, false);
+        bimg::imageResizeRgba32fLinear(scaled, source);
+
+        bimg::ImageContainer* result = bimg::imageConvert(allocator, bimg::TextureFormat::RGBA8, *scaled);
+        bimg::imageFree(scaled);
+        bimg::imageFree(source);
+        return result;
+    }
+
+    // compresses the rgba8 image and its box filtered mips, the same steps as bimg's texturec
+    bimg::ImageContainer* Encode(bx::AllocatorI* allocator, const bimg::ImageContainer& rgba8, const Variant& variant, bx::Error* error)
+    {
+        const bimg::ImageBlockInfo& blockInfo = bimg::getBlockInfo(variant.m_format);
+        uint32_t width = bx::uint32_max(blockInfo.blockWidth * blockInfo.minBlockX, (rgba8.m_width + blockInfo.blockWidth - 1) / blockInfo.blockWidth * blockInfo.blockWidth);
+        uint32_t height = bx::uint32_max(blockInfo.blockHeight * blockInfo.minBlockY, (rgba8.m_height + blockInfo.blockHeight - 1) / blockInfo.blockHeight * blockInfo.blockHeight);
+        if (variant.m_isPowerOfTwoSquare)
+        {
+            width = height = bx::uint32_nextpow2(bx::uint32_max(width, height));
+        }
+
+        bimg::ImageContainer* source = width != rgba8.m_width || height != rgba8.m_height
+            ? Resize(allocator, rgba8, width, height)
+            : bimg::imageConvert(allocator, bimg::TextureFormat::RGBA8, rgba8);
+
+        bimg::ImageContainer* output = bimg::imageAlloc(allocator, variant.m_format, uint16_t(width), uint16_t(height), 1, 1, false, true);
+
+        // the mips are downsampled in place from the top level
+        uint8_t* rgba = static_cast<uint8_t*>(source->m_data);
+
+        bimg::ImageMip mip;
+        bimg::imageGetRawData(*output, 0, 0, output->m_data, output->m_size, mip);
+        bimg::imageEncodeFromRgba8(const_cast<uint8_t*>(mip.m_data), rgba, mip.m_width, mip.m_height, mip.m_depth, variant.m_format, bimg::Quality::Default, error);
+
+        for (uint8_t lod = 1; lod < output->m_numMips && error->isOk(); ++lod)
+        {
+            bimg::imageRgba8Downsample2x2(rgba, mip.m_width, mip.m_height, mip.m_depth, mip.m_width * 4,
+                                          bx::strideAlign(mip.m_width / 2, blockInfo.blockWidth) * 4, rgba);
+
+            bimg::imageGetRawData(*output, 0, lod, output->m_data, output->m_size, mip);
+            bimg::imageEncodeFromRgba8(const_cast<uint8_t*>(mip.m_data), rgba, mip.m_width, mip.m_height, mip.m_depth, variant.m_format, bimg::Quality::Default, error);
+        }
+
+        bimg::imageFree(source);
+        if (!error->isOk())
+        {
+            bimg::imageFree(output);
+            return nullptr;
+        }
+        return output;
+    }
+
+    // bimg reads pvr3 but does not write it, a single surface needs no more than the header
+    void WritePvr3(bx::WriterI* writer, const bimg::ImageContainer& image, bx::Error* error)
+    {
+        const uint32_t k_magic             = BX_MAKEFOURCC('P', 'V', 'R', 3);
+        const uint64_t k_pvrtc1Rgba4bpp    = 3;
+
+        bx::write(writer, k_magic, error);
+        bx::write(writer, uint32_t(0), error);                  // flags
+        bx::write(writer, k_pvrtc1Rgba4bpp, error);
+        bx::write(writer, uint32_t(0), error);                  // linear color space
+        bx::write(writer, uint32_t(0), error);                  // unsigned normalized channels
+        bx::write(writer, image.m_height, error);
+        bx::write(writer, image.m_width, error);
+        bx::write(writer, image.m_depth, error);
+        bx::write(writer, uint32_t(1), error);                  // surfaces
+        bx::write(writer, uint32_t(1), error);                  // faces
+        bx::write(writer, uint32_t(image.m_numMips), error);
+        bx::write(writer, uint32_t(0), error);                  // metadata size
+        bx::write(writer, image.m_data, int32_t(image.m_size), error);
+    }
+
+    // image | serialized TextureAsset | offset of the serialized TextureAsset, the layout TextureAssetHandler reads
+    bool WriteVariant(const AZStd::string& path, bimg::ImageContainer& image, const Variant& variant, const AZStd::vector<char>& metadata)
+    {
+        bx::DefaultAllocator allocator;
+        bx::MemoryBlock block(&allocator);
+        bx::MemoryWriter writer(&block);
+        bx::Error error;
+
+        if (variant.m_format == bimg::TextureFormat::BC3)
+        {
+            bimg::imageWriteDds(&writer, image, image.m_data, image.m_size, &error);
+        }
+        else if (variant.m_format == bimg::TextureFormat::PTC14A)
+        {
+            WritePvr3(&writer, image, &error);
+        }
+        else
+        {
+            bimg::imageWriteKtx(&writer, image, image.m_data, image.m_size, &error);
+        }
+
+        const AZ::u32 metadataOffset = static_cast<AZ::u32>(bx::seek(&writer, 0, bx::Whence::Current));
+        bx::write(&writer, metadata.data(), int32_t(metadata.size()), &error);
+        bx::write(&writer, metadataOffset, &error);
+
+        const int64_t size = bx::seek(&writer, 0, bx::Whence::Current);
+        return error.isOk() && WriteFile(path, block.more(0), static_cast<size_t>(size));
+    }
+
+    CookResult CookTexture(const CookContext& context, const AZStd::string& texture)
+    {
+        const AZStd::string inputPath = context.m_inputDirectory + "/" + texture;
+        const AZStd::string outputPath = context.m_outputDirectory + "/" + texture;
+
+        AZStd::vector<char> png;
+        if (!ReadFile(inputPath + ".png", png))
+        {
+            printf("%s.png: can not read the file\n", inputPath.c_str());
+            return CookResult::Failed;
+        }
+
+        AZStd::vector<char> xml;
+        if (AZ::IO::SystemFile::Exists((inputPath + ".xml").c_str()) && !ReadFile(inputPath + ".xml", xml))
+        {
+            printf("%s.xml: can not read the file\n", inputPath.c_str());
+            return CookResult::Failed;
+        }
+
+        const AZStd::string digest = HashInputs(png, xml);
+        const AZStd::string hashPath = outputPath + ".cook";
+
+        AZStd::vector<char> cookedDigest;
+        bool isUpToDate = ReadFile(hashPath, cookedDigest) && AZStd::string(cookedDigest.begin(), cookedDigest.end()) == digest;
+        for (const auto& variant : k_variants)
+        {
+            isUpToDate = isUpToDate && AZ::IO::SystemFile::Exists((outputPath + "." + variant.m_extension).c_str());
+        }
+        if (isUpToDate)
+        {
+            return CookResult::UpToDate;
+        }
+
+        Module::TextureAsset textureAsset;
+        if (!xml.empty())
+        {
+            AZ::IO::MemoryStream stream(xml.data(), xml.size());
+            if (!AZ::Utils::LoadObjectFromStreamInPlace(stream, textureAsset, context.m_serializeContext))
+            {
+                printf("%s.xml: not a texture\n", inputPath.c_str());
+                return CookResult::Failed;
+            }
+        }
+
+        AZStd::vector<char> metadata;
+        AZ::IO::ByteContainerStream<AZStd::vector<char>> metadataStream(&metadata);
+        AZ::Utils::SaveObjectToStream(metadataStream, AZ::ObjectStream::ST_BINARY, &textureAsset, context.m_serializeContext);
+
+        bx::DefaultAllocator allocator;
+        bx::Error error;
+        bimg::ImageContainer* rgba8 = bimg::imageParse(&allocator, png.data(), static_cast<uint32_t>(png.size()), bimg::TextureFormat::RGBA8, &error);
+        if (rgba8 == nullptr)
+        {
+            printf("%s.png: can not decode the image\n", inputPath.c_str());
+            return CookResult::Failed;
+        }
+
+        bool succeeded = true;
+        for (const auto& variant : k_variants)
+        {
+            const AZStd::string variantPath = outputPath + "." + variant.m_extension;
+            bimg::ImageContainer* image = Encode(&allocator, *rgba8, variant, &error);
+            if (image == nullptr || !WriteVariant(variantPath, *image, variant, metadata))
+            {
+                printf("%s: can not cook the texture\n", variantPath.c_str());
+                succeeded = false;
+            }
+            if (image)
+            {
+                bimg::imageFree(image);
+            }
+        }
+        bimg::imageFree(rgba8);
+
+        // the digest goes last, an interrupted cook is repeated by the next run
+        if (!succeeded || !WriteFile(hashPath, digest.data(), digest.size()))
+        {
+            return CookResult::Failed;
+        }
+
+        printf("%s.png -> %s.{dds,pvr,ktx}\n", inputPath.c_str(), outputPath.c_str());
+        return CookResult::Cooked;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc < 2 || argc > 3)
+    {
+        printf("usage: TextureCooker <input directory> [output directory]\n");
+        return 1;
+    }
+
+    AZ::AllocatorInstance<AZ::SystemAllocator>::Create();
+    AZ::AllocatorInstance<AZ::PoolAllocator>::Create();
+    AZ::AllocatorInstance<AZ::ThreadPoolAllocator>::Create();
+
+    AZ::u32 cooked = 0;
+    AZ::u32 upToDate = 0;
+    AZ::u32 failures = 0;
+    {
+        AZ::SerializeContext serializeContext;
+        Module::TextureAsset::Reflect(&serializeContext);
+
+        CookContext context;
+        context.m_inputDirectory = argv[1];
+        context.m_outputDirectory = argc == 3 ? argv[2] : argv[1];
+        context.m_serializeContext = &serializeContext;
+
+        AZ::IO::LocalFileIO fileIO;
+        AZStd::vector<AZStd::string> textures;
+        FindTextures(fileIO, context.m_inputDirectory, "", textures);
+
+        AZ::JobManagerDesc jobDesc;
+        for (AZ::u32 i = 0; i < AZStd::thread::hardware_concurrency(); ++i)
+        {
+            jobDesc.m_workerThreads.push_back(AZ::JobManagerThreadDesc());
+        }
+        AZ::JobManager jobManager(jobDesc);
+        AZ::JobContext jobContext(jobManager);
+
+        // textures are cooked independently, one job each
+        AZStd::vector<CookResult> results(textures.size());
+        AZ::JobCompletion completion(&jobContext);
+        for (size_t i = 0; i < textures.size(); ++i)
+        {
+            auto job = AZ::CreateJobFunction([&context, &textures, &results, i]()
+            {
+                results[i] = CookTexture(context, textures[i]);
+            }, true, &jobContext);
+            job->SetDependent(&completion);
+            job->Start();
+        }
+        completion.StartAndWaitForCompletion();
+
+        for (auto result : results)
+        {
+            cooked += result == CookResult::Cooked ? 1 : 0;
+            upToDate += result == CookResult::UpToDate ? 1 : 0;
+            failures += result == CookResult::Failed ? 1 : 0;
+        }
+    }
+
+    printf("%u cooked, %u up to date, %u failed\n", cooked, upToDate, failures);
+
+    AZ::AllocatorInstance<AZ::ThreadPoolAllocator>::Destroy();
+    AZ::AllocatorInstance<AZ::PoolAllocator>::Destroy();
+    AZ::AllocatorInstance<AZ::SystemAllocator>::Destroy();
+
+    return failures == 0 ? 0 : 1;
+}